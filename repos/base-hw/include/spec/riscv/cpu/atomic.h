@@ -51,6 +51,14 @@ namespace Genode {
 		Genode::memory_barrier();
 		return old_val == cmp_val ? 1 : 0;
 	}
+
+	/**
+	 * Hint the CPU that the caller is spinning on a memory location
+	 */
+	inline void cpu_relax()
+	{
+		__asm__ __volatile__ ("" ::: "memory");
+	}
 }
 
 #endif /* _INCLUDE__RISCV__CPU__ATOMIC_H_ */
@@ -33,12 +33,6 @@ inline int lx_mkdir(char const *pathname, mode_t mode)
 }
 
 
-inline int lx_ftruncate(int fd, unsigned long length)
-{
-	return lx_syscall(SYS_ftruncate, fd, length);
-}
-
-
 inline int lx_unlink(const char *fname)
 {
 	return lx_syscall(SYS_unlink, fname);
@@ -51,6 +45,32 @@ inline int lx_dup(int fd)
 }
 
 
+/*
+ * The file seals are not provided by the headers of older host systems, so
+ * we define them here.
+ */
+enum {
+	LX_F_ADD_SEALS   = 1033,
+	LX_F_SEAL_SEAL   = 0x0001,
+	LX_F_SEAL_SHRINK = 0x0002,
+	LX_F_SEAL_GROW   = 0x0004,
+	LX_F_SEAL_WRITE  = 0x0008,
+};
+
+
+inline int lx_add_seals(int fd, int seals)
+{
+	return lx_syscall(SYS_fcntl, fd, LX_F_ADD_SEALS, seals);
+}
+
+
+inline long lx_sendfile(int out_fd, int in_fd, off_t *offset,
+                        Genode::size_t count)
+{
+	return lx_syscall(SYS_sendfile, out_fd, in_fd, offset, count);
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
@@ -82,6 +102,25 @@ inline int lx_execve(const char *filename, char *const argv[],
 }
 
 
+enum { LX_AT_EMPTY_PATH = 0x1000 };
+
+
+/**
+ * Execute program referred to by a file descriptor
+ *
+ * \return negative error code, -ENOSYS if the kernel lacks 'execveat'
+ */
+inline int lx_execveat(int dirfd, const char *pathname, char *const argv[],
+                       char *const envp[], int flags)
+{
+#ifdef SYS_execveat
+	return lx_syscall(SYS_execveat, dirfd, pathname, argv, envp, flags);
+#else
+	return -38; /* ENOSYS */
+#endif
+}
+
+
 inline int lx_kill(int pid, int signal)
 {
 	return lx_syscall(SYS_kill, pid, signal);
@@ -43,13 +43,16 @@ struct Execve_args
 	char       * const *argv;
 	char       * const *envp;
 	int          const parent_sd;
+	int          const binary_fd;
 
 	Execve_args(char   const *filename,
 	            char * const *argv,
 	            char * const *envp,
-	            int           parent_sd)
+	            int           parent_sd,
+	            int           binary_fd)
 	:
-		filename(filename), argv(argv), envp(envp), parent_sd(parent_sd)
+		filename(filename), argv(argv), envp(envp), parent_sd(parent_sd),
+		binary_fd(binary_fd)
 	{ }
 };
 
@@ -61,10 +64,62 @@ static int _exec_child(Execve_args *arg)
 {
 	lx_dup2(arg->parent_sd, PARENT_SOCKET_HANDLE);
 
+	/*
+	 * Execute the binary via its file descriptor if possible. On kernels
+	 * without 'execveat', 'filename' refers to the file descriptor via
+	 * '/proc/self/fd/'.
+	 */
+	if (arg->binary_fd >= 0) {
+		int const ret = lx_execveat(arg->binary_fd, "", arg->argv, arg->envp,
+		                            LX_AT_EMPTY_PATH);
+		if (ret != -38 /* ENOSYS */)
+			return ret;
+	}
+
 	return lx_execve(arg->filename, arg->argv, arg->envp);
 }
 
 
+/**
+ * Copy 'size' bytes from the start of 'src_fd' to 'dst_fd'
+ *
+ * The copy is performed by the kernel and leaves the file offset of 'src_fd'
+ * untouched.
+ */
+static bool copy_file(int dst_fd, int src_fd, Genode::size_t size)
+{
+	off_t offset = 0;
+	while ((Genode::size_t)offset < size)
+		if (lx_sendfile(dst_fd, src_fd, &offset, size - offset) <= 0)
+			return false;
+
+	return true;
+}
+
+
+/**
+ * Create sealed anonymous memory file with the content of 'src_fd'
+ *
+ * \return file descriptor, or -1 if memory files are not supported
+ */
+static int sealed_memory_file(int src_fd, Genode::size_t size)
+{
+	int const fd = lx_memfd_create("binary", LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+	if (fd < 0)
+		return -1;
+
+	if (!copy_file(fd, src_fd, size)) {
+		lx_close(fd);
+		return -1;
+	}
+
+	/* the binary cannot be modified after its content was inspected */
+	lx_add_seals(fd, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW
+	               | LX_F_SEAL_WRITE  | LX_F_SEAL_SEAL);
+	return fd;
+}
+
+
 /**
  * List of Unix environment variables, initialized by the startup code
  */
@@ -99,35 +154,53 @@ void Native_pd_component::_start(Dataspace_component &ds)
 	Linux_dataspace::Filename s = ds.fname();
 	const char *filename = s.buf;
 
+	int  binary_fd = -1;
+	char binary_fd_path[32];
+
 	/*
 	 * In order to be executable via 'execve', a program must be represented as
 	 * a file on the Linux file system. However, this is not the case for a
-	 * plain RAM dataspace that contains an ELF image. In this case, we copy
-	 * the dataspace content into a temporary file whose path is passed to
-	 * 'execve()'.
+	 * plain RAM dataspace that contains an ELF image. Because the file of a
+	 * RAM dataspace is writable, it cannot be executed directly. Instead, we
+	 * copy the dataspace content into a sealed memory file, which is executed
+	 * via its file descriptor. Only if the kernel does not support memory
+	 * files, we resort to a temporary file whose path is passed to 'execve()'.
 	 */
 	if (strcmp(filename, "") == 0) {
 
-		filename = tmp_filename;
+		int const fd_socket = Capability_space::ipc_cap_data(ds.fd()).dst.socket;
+
+		binary_fd = sealed_memory_file(fd_socket, ds.size());
 
-		int tmp_binary_fd = lx_open(filename, O_CREAT | O_EXCL | O_WRONLY, S_IRWXU);
-		if (tmp_binary_fd < 0) {
-			error("Could not create file '", filename, "'");
-			return; /* XXX reflect error to client */
-		}
+		if (binary_fd >= 0) {
+			snprintf(binary_fd_path, sizeof(binary_fd_path),
+			         "/proc/self/fd/%d", binary_fd);
+			filename = binary_fd_path;
+		} else {
 
-		char buf[4096];
-		int num_bytes = 0;
-		int const fd_socket = Capability_space::ipc_cap_data(ds.fd()).dst.socket;
-		while ((num_bytes = lx_read(fd_socket, buf, sizeof(buf))) != 0)
-			lx_write(tmp_binary_fd, buf, num_bytes);
+			filename = tmp_filename;
+
+			int tmp_binary_fd = lx_open(filename, O_CREAT | O_EXCL | O_WRONLY, S_IRWXU);
+			if (tmp_binary_fd < 0) {
+				error("Could not create file '", filename, "'");
+				return; /* XXX reflect error to client */
+			}
 
-		lx_close(tmp_binary_fd);
+			bool const copied = copy_file(tmp_binary_fd, fd_socket, ds.size());
+
+			lx_close(tmp_binary_fd);
+
+			if (!copied) {
+				error("Could not copy binary to file '", filename, "'");
+				lx_unlink(filename);
+				return; /* XXX reflect error to client */
+			}
+		}
 	}
 
 	/* pass parent capability as environment variable to the child */
 	enum { ENV_STR_LEN = 256 };
-	static char envbuf[5][ENV_STR_LEN];
+	static char envbuf[6][ENV_STR_LEN];
 	Genode::snprintf(envbuf[1], ENV_STR_LEN, "parent_local_name=%lu",
 	                 _pd_session._parent.local_name());
 	Genode::snprintf(envbuf[2], ENV_STR_LEN, "DISPLAY=%s",
@@ -136,9 +209,11 @@ void Native_pd_component::_start(Dataspace_component &ds)
 	                 get_env("HOME"));
 	Genode::snprintf(envbuf[4], ENV_STR_LEN, "LD_LIBRARY_PATH=%s",
 	                 get_env("LD_LIBRARY_PATH"));
+	Genode::snprintf(envbuf[5], ENV_STR_LEN, "GENODE_IPC_FAST_PATH=%s",
+	                 get_env("GENODE_IPC_FAST_PATH"));
 
 	char *env[] = { &envbuf[0][0], &envbuf[1][0], &envbuf[2][0],
-		&envbuf[3][0], &envbuf[4][0], 0 };
+		&envbuf[3][0], &envbuf[4][0], &envbuf[5][0], 0 };
 
 	/* prefix name of Linux program (helps killing some zombies) */
 	char const *prefix = "[Genode] ";
@@ -169,11 +244,16 @@ void Native_pd_component::_start(Dataspace_component &ds)
 	 * pointer, all arguments are embedded within the 'execve_args' struct.
 	 */
 	Execve_args arg(filename, argv_buf, env,
-	                Capability_space::ipc_cap_data(_pd_session._parent).dst.socket);
+	                Capability_space::ipc_cap_data(_pd_session._parent).dst.socket,
+	                binary_fd);
 
 	_pid = lx_create_process((int (*)(void *))_exec_child,
 	                         stack + STACK_SIZE - sizeof(umword_t), &arg);
 
+	/* the new process holds its own reference to the executed binary */
+	if (binary_fd >= 0)
+		lx_close(binary_fd);
+
 	if (strcmp(filename, tmp_filename) == 0)
 		lx_unlink(filename);
 }
@@ -16,6 +16,9 @@
 #include <util/misc_math.h>
 #include <base/log.h>
 
+/* base-internal includes */
+#include <base/internal/ipc_channel.h>
+
 /* local includes */
 #include "platform_thread.h"
 #include "server_socket_pair.h"
@@ -87,6 +90,7 @@ Platform_thread::Platform_thread(size_t, const char *name, unsigned,
 Platform_thread::~Platform_thread()
 {
 	ep_sd_registry()->disassociate(_socket_pair.client_sd);
+	invalidate_ipc_channels();
 
 	if (_socket_pair.client_sd)
 		lx_close(_socket_pair.client_sd);
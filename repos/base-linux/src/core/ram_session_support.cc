@@ -33,7 +33,13 @@ using namespace Genode;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
-void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+
+/**
+ * Create unnamed file in the resource path
+ *
+ * This is the fallback for kernels that do not support memory files.
+ */
+static int unlinked_file(Genode::size_t size)
 {
 	char fname[Linux_dataspace::FNAME_LEN];
 
@@ -41,10 +47,7 @@ void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
 	snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt++);
 	lx_unlink(fname);
 	int const fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds->size());
-
-	/* remember file descriptor in dataspace component object */
-	ds->fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -53,6 +56,31 @@ void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname);
+
+	return fd;
+}
+
+
+void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+{
+	/*
+	 * Back the dataspace by an anonymous memory file, which involves no
+	 * file-system operations and is not subject to the mount options of
+	 * the resource path.
+	 */
+	int fd = lx_memfd_create("dataspace", LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+
+	if (fd >= 0) {
+		lx_ftruncate(fd, ds->size());
+
+		/* prevent components from changing the size of the dataspace */
+		lx_add_seals(fd, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL);
+	} else {
+		fd = unlinked_file(ds->size());
+	}
+
+	/* remember file descriptor in dataspace component object */
+	ds->fd(fd);
 }
 
 
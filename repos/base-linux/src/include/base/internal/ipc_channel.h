@@ -0,0 +1,156 @@
+/*
+ * \brief  Shared-memory channels of the IPC fast path on Linux
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A client thread that calls an entrypoint repeatedly establishes a channel
+ * with the entrypoint. The channel consists of a message page shared by both
+ * sides, which carries the request and the reply of one RPC at a time. The
+ * client waits for the reply via a futex in the message page. Requests are
+ * announced to the entrypoint via the page of the entrypoint, which is shared
+ * with all clients of the fast path. Only if the entrypoint blocks at its
+ * socket, the client wakes it up by sending a doorbell message to the
+ * socket.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__IPC_CHANNEL_H_
+#define _INCLUDE__BASE__INTERNAL__IPC_CHANNEL_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Genode {
+
+	struct Ipc_channel_page;
+	struct Ipc_ep_page;
+	struct Ipc_client_channel;
+	struct Ipc_server_channel;
+	struct Ipc_fast_path;
+	struct Native_thread;
+
+	/**
+	 * Release the fast-path state of a thread that stopped executing
+	 */
+	void release_ipc_fast_path(Native_thread &);
+
+	/**
+	 * Invalidate fast-path channels because an RPC destination socket closes
+	 *
+	 * Must be called before closing a socket that may serve as destination
+	 * of RPC calls. Once the socket number is reused for another entrypoint,
+	 * the channels to the old entrypoint must not be used anymore. Each
+	 * thread revalidates its channels on their next use.
+	 */
+	void invalidate_ipc_channels();
+}
+
+
+/**
+ * Message page shared by a client thread and an entrypoint
+ */
+struct Genode::Ipc_channel_page
+{
+	enum { SIZE = 4096 };
+
+	enum State { IDLE, REQUEST, REPLY, REPLY_VIA_SOCKET, CLOSED };
+
+	/* futex word, the client waits for the transition from 'REQUEST' */
+	int volatile state;
+
+	/* number of valid bytes in 'msg' */
+	unsigned size;
+
+	enum { MSG_CAPACITY = SIZE - 2*sizeof(long) };
+
+	long msg[MSG_CAPACITY/sizeof(long)];
+};
+
+
+/**
+ * Page shared by an entrypoint with all its fast-path clients
+ */
+struct Genode::Ipc_ep_page
+{
+	enum {
+		SIZE          = 4096,
+		MAX_CHANNELS  = 128,
+		BITS_PER_WORD = sizeof(unsigned long)*8,
+		NUM_WORDS     = MAX_CHANNELS/BITS_PER_WORD
+	};
+
+	/* entrypoint blocks at its socket and must be woken up by a doorbell */
+	int volatile sleeping;
+
+	/* entrypoint stopped serving the fast path */
+	int volatile closed;
+
+	/* one bit per channel that demands the attention of the entrypoint */
+	unsigned long volatile pending[NUM_WORDS];
+};
+
+
+/**
+ * Client-side end of a channel
+ */
+struct Genode::Ipc_client_channel
+{
+	int               dst_sd     = -1;      /* socket of the entrypoint */
+	unsigned long     dst_ino    = 0;       /* inode of 'dst_sd' */
+	unsigned long     generation = 0;       /* 'dst_ino' validated at */
+	bool              refused    = false;   /* entrypoint lacks fast path */
+	bool              canceled   = false;   /* reply of canceled call pending */
+	unsigned          slot       = 0;       /* channel index at entrypoint */
+	int               socket     = -1;      /* receives replies with caps */
+	int               server_pid = 0;
+	int               server_tid = 0;
+	Ipc_channel_page *page       = nullptr;
+	Ipc_ep_page      *ep         = nullptr;
+	unsigned long     last_use   = 0;
+
+	bool free() const { return dst_sd == -1; }
+};
+
+
+/**
+ * Entrypoint-side end of a channel
+ */
+struct Genode::Ipc_server_channel
+{
+	Ipc_channel_page *page       = nullptr;
+	int               socket     = -1;      /* sends replies with caps */
+	int               client_pid = 0;
+	int               client_tid = 0;
+
+	bool free() const { return page == nullptr; }
+};
+
+
+/**
+ * Fast-path state of a thread
+ */
+struct Genode::Ipc_fast_path
+{
+	enum { MAX_CLIENT_CHANNELS = 8 };
+
+	/* channels used by the thread as client, replaced in LRU order */
+	Ipc_client_channel client[MAX_CLIENT_CHANNELS];
+	unsigned long      use_count = 0;
+
+	/* channels served by the thread as entrypoint */
+	Ipc_ep_page       *ep    = nullptr;
+	int                ep_fd = -1;
+	Ipc_server_channel server[Ipc_ep_page::MAX_CHANNELS];
+
+	/* pending bits taken from the entrypoint page but not yet processed */
+	unsigned long harvested[Ipc_ep_page::NUM_WORDS] { };
+	unsigned      next_slot = 0;
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__IPC_CHANNEL_H_ */
@@ -17,7 +17,11 @@
 #include <base/stdint.h>
 #include <base/internal/server_socket_pair.h>
 
-namespace Genode { struct Native_thread; }
+namespace Genode {
+
+	struct Native_thread;
+	struct Ipc_fast_path;
+}
 
 struct Genode::Native_thread
 {
@@ -48,6 +52,11 @@ struct Genode::Native_thread
 
 	Socket_pair socket_pair;
 
+	/**
+	 * State of the shared-memory IPC fast path, allocated on first use
+	 */
+	Ipc_fast_path *ipc_fast_path = nullptr;
+
 	Native_thread() { }
 };
 
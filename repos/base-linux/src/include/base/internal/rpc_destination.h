@@ -22,8 +22,17 @@ namespace Genode {
 	{
 		int socket = -1;
 
+		/* fast-path channel of a reply destination, see 'ipc_channel.h' */
+		int channel = -1;
+
+		/* thread ID of the entrypoint that serves 'channel' */
+		int owner = 0;
+
 		explicit Rpc_destination(int socket) : socket(socket) { }
 
+		Rpc_destination(int socket, int channel, int owner)
+		: socket(socket), channel(channel), owner(owner) { }
+
 		Rpc_destination() { }
 	};
 
@@ -35,6 +44,9 @@ namespace Genode {
 	static void print(Output &out, Rpc_destination const &dst)
 	{
 		Genode::print(out, "socket=", dst.socket);
+
+		if (dst.channel >= 0)
+			Genode::print(out, ",channel=", dst.channel);
 	}
 }
 
@@ -17,6 +17,7 @@
 #include <base/thread.h>
 #include <base/blocking.h>
 #include <base/env.h>
+#include <util/construct_at.h>
 #include <linux_native_cpu/linux_native_cpu.h>
 
 /* base-internal includes */
@@ -25,6 +26,7 @@
 #include <base/internal/ipc_server.h>
 #include <base/internal/server_socket_pair.h>
 #include <base/internal/capability_space_tpl.h>
+#include <base/internal/ipc_channel.h>
 
 /* Linux includes */
 #include <linux_syscalls.h>
@@ -74,6 +76,9 @@ struct Protocol_header
 
 	enum { INVALID_BADGE = ~1UL };
 
+	/* request for establishing a fast-path channel, see 'ipc_channel.h' */
+	enum { CONNECT_BADGE = ~2UL };
+
 	void *msg_start() { return &protocol_word; }
 };
 
@@ -85,6 +90,8 @@ struct Protocol_header
  */
 static_assert((int)Protocol_header::INVALID_BADGE != (int)Rpc_obj_key::INVALID,
               "ambigious INVALID_BADGE");
+static_assert((int)Protocol_header::CONNECT_BADGE != (int)Rpc_obj_key::INVALID,
+              "ambigious CONNECT_BADGE");
 
 
 /******************************
@@ -104,6 +111,7 @@ Genode::Ep_socket_descriptor_registry *Genode::ep_sd_registry()
 
 enum {
 	LX_EINTR        = 4,
+	LX_ETIMEDOUT    = 110,
 	LX_ECONNREFUSED = 111
 };
 
@@ -317,12 +325,11 @@ static void extract_sds_from_message(unsigned start_index,
 
 
 /**
- * Send reply to client
+ * Send reply to client without closing the reply socket
  */
-static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
-                            Genode::Msgbuf_base &snd_msgbuf)
+static inline int lx_send_reply(int reply_socket, Rpc_exception_code exception_code,
+                                Genode::Msgbuf_base &snd_msgbuf)
 {
-
 	Protocol_header &header = snd_msgbuf.header<Protocol_header>();
 
 	header.protocol_word = exception_code.value;
@@ -332,7 +339,17 @@ static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
 	/* marshall capabilities to be transferred to the client */
 	insert_sds_into_message(msg, header, snd_msgbuf);
 
-	int const ret = lx_sendmsg(reply_socket, msg.msg(), 0);
+	return lx_sendmsg(reply_socket, msg.msg(), 0);
+}
+
+
+/**
+ * Send reply to client
+ */
+static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
+                            Genode::Msgbuf_base &snd_msgbuf)
+{
+	int const ret = lx_send_reply(reply_socket, exception_code, snd_msgbuf);
 
 	/* ignore reply send error caused by disappearing client */
 	if (ret >= 0 || ret == -LX_ECONNREFUSED) {
@@ -345,6 +362,749 @@ static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
 }
 
 
+/******************************
+ ** Shared-memory fast path **
+ ******************************/
+
+/*
+ * The fast path is optional and enabled by setting the environment variable
+ * 'GENODE_IPC_FAST_PATH' to 1 when starting core, which passes the variable
+ * to all components.
+ */
+
+/**
+ * List of Unix environment variables, initialized by the startup code
+ */
+extern char **lx_environ;
+
+
+static bool fast_path_enabled()
+{
+	static int enabled = -1;
+
+	if (enabled == -1) {
+		char   const *key     = "GENODE_IPC_FAST_PATH=";
+		size_t const  key_len = Genode::strlen(key);
+
+		enabled = 0;
+		for (char **curr = lx_environ; curr && *curr; curr++)
+			if (Genode::strcmp(*curr, key, key_len) == 0)
+				enabled = ((*curr)[key_len] == '1');
+	}
+	return enabled == 1;
+}
+
+
+/**
+ * Message exchanged for establishing a channel
+ *
+ * The request carries the ID of the client thread, the reply the ID of the
+ * entrypoint. The badge of the reply denotes the channel index at the
+ * entrypoint or 'INVALID_BADGE' if the entrypoint refuses the channel.
+ */
+struct Connect_msg
+{
+	Protocol_header header;
+	long            pid;
+	long            tid;
+};
+
+
+typedef Ipc_channel_page Page;
+
+
+static bool map_failed(void *addr)
+{
+	return ((long)addr < 0) && ((long)addr > -4096);
+}
+
+
+static void *map_shared(int fd, size_t size)
+{
+	void * const addr = lx_mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	return map_failed(addr) ? nullptr : addr;
+}
+
+
+/**
+ * Create file with 'size' bytes of shared memory
+ *
+ * \return file descriptor, or negative value on error
+ */
+static int create_shared_memory(char const *name, size_t size)
+{
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC);
+	if (fd < 0)
+		return fd;
+
+	if (lx_ftruncate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Return fast-path state of the calling thread, allocated on first use
+ *
+ * The state is allocated from the Linux kernel because its allocation must
+ * not involve IPC.
+ */
+static Ipc_fast_path *ipc_fast_path(Native_thread &native_thread)
+{
+	if (native_thread.ipc_fast_path)
+		return native_thread.ipc_fast_path;
+
+	void * const addr = lx_mmap(0, sizeof(Ipc_fast_path), PROT_READ | PROT_WRITE,
+	                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map_failed(addr))
+		return nullptr;
+
+	native_thread.ipc_fast_path = construct_at<Ipc_fast_path>(addr);
+	return native_thread.ipc_fast_path;
+}
+
+
+/**
+ * Wake up entrypoint that blocks at its socket
+ */
+static void send_doorbell(int dst_sd)
+{
+	char  doorbell = 0;
+	iovec iov { &doorbell, sizeof(doorbell) };
+
+	msghdr msg;
+	Genode::memset(&msg, 0, sizeof(msg));
+	msg.msg_iov    = &iov;
+	msg.msg_iovlen = 1;
+
+	lx_sendmsg(dst_sd, &msg, 0);
+}
+
+
+/**
+ * Draw the attention of the entrypoint to the channel
+ */
+static void notify_entrypoint(Ipc_client_channel &channel)
+{
+	enum { BITS_PER_WORD = Ipc_ep_page::BITS_PER_WORD };
+
+	unsigned long const bit = 1UL << (channel.slot % BITS_PER_WORD);
+
+	__atomic_fetch_or(&channel.ep->pending[channel.slot / BITS_PER_WORD], bit,
+	                  __ATOMIC_SEQ_CST);
+
+	/*
+	 * The entrypoint announces that it is about to block before checking the
+	 * pending bits for the last time. So either the entrypoint observes our
+	 * pending bit or we observe its announcement. Only the first client that
+	 * observes the announcement sends a doorbell.
+	 */
+	if (__atomic_exchange_n(&channel.ep->sleeping, 0, __ATOMIC_SEQ_CST))
+		send_doorbell(channel.dst_sd);
+}
+
+
+static void close_client_channel(Ipc_client_channel &channel)
+{
+	if (channel.page) {
+
+		/* let the entrypoint release its end of the channel */
+		__atomic_store_n(&channel.page->state, (int)Page::CLOSED, __ATOMIC_SEQ_CST);
+		notify_entrypoint(channel);
+
+		lx_munmap(channel.page, Page::SIZE);
+	}
+
+	if (channel.ep)          lx_munmap(channel.ep, Ipc_ep_page::SIZE);
+	if (channel.socket != -1) lx_close(channel.socket);
+
+	channel = Ipc_client_channel();
+}
+
+
+/**
+ * Close file descriptors received with a message that is dropped
+ */
+static void close_sockets(Message const &msg)
+{
+	for (unsigned i = 0; i < msg.num_sockets(); i++)
+		lx_close(msg.socket_at_index(i));
+}
+
+
+/**
+ * Establish channel with the entrypoint behind 'dst_sd'
+ *
+ * \throw Blocking_canceled
+ */
+static bool connect_channel(Ipc_client_channel &channel, int dst_sd)
+{
+	int const page_fd = create_shared_memory("ipc-channel", Page::SIZE);
+	if (page_fd < 0)
+		return false;
+
+	Page * const page = (Page *)map_shared(page_fd, Page::SIZE);
+
+	int sd[2] = { -1, -1 };
+	if (!page || lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd) < 0) {
+		if (page) lx_munmap(page, Page::SIZE);
+		lx_close(page_fd);
+		return false;
+	}
+
+	page->state = Page::IDLE;
+
+	/* the remote end of the socket pair serves as reply channel */
+	Connect_msg request;
+	Genode::memset(&request, 0, sizeof(request));
+	request.header.protocol_word = Protocol_header::CONNECT_BADGE;
+	request.pid                 = lx_getpid();
+	request.tid                 = lx_gettid();
+
+	Message snd_msg(request.header.msg_start(), sizeof(request));
+	snd_msg.marshal_socket(sd[1]);
+	snd_msg.marshal_socket(page_fd);
+
+	int ret = lx_sendmsg(dst_sd, snd_msg.msg(), 0);
+
+	lx_close(page_fd);
+	lx_close(sd[1]);
+
+	Connect_msg reply;
+	Genode::memset(&reply, 0, sizeof(reply));
+
+	Message rcv_msg(reply.header.msg_start(), sizeof(reply));
+	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+	if (ret >= 0)
+		ret = lx_recvmsg(sd[0], rcv_msg.msg(), 0);
+
+	Ipc_ep_page *ep = nullptr;
+
+	if (ret == (int)sizeof(reply)
+	 && reply.header.protocol_word < Ipc_ep_page::MAX_CHANNELS
+	 && rcv_msg.num_sockets() == 1)
+		ep = (Ipc_ep_page *)map_shared(rcv_msg.socket_at_index(0), Ipc_ep_page::SIZE);
+
+	if (ret > 0)
+		close_sockets(rcv_msg);
+
+	if (!ep) {
+
+		/* an entrypoint that accepted the channel reclaims the closed page */
+		page->state = Page::CLOSED;
+		lx_munmap(page, Page::SIZE);
+		lx_close(sd[0]);
+
+		if (ret == -LX_EINTR)
+			throw Blocking_canceled();
+
+		return false;
+	}
+
+	channel.dst_sd     = dst_sd;
+	channel.slot       = reply.header.protocol_word;
+	channel.socket     = sd[0];
+	channel.server_pid = reply.pid;
+	channel.server_tid = reply.tid;
+	channel.page       = page;
+	channel.ep         = ep;
+	return true;
+}
+
+
+/*
+ * Generation of the destination sockets, incremented whenever a socket that
+ * may serve as RPC destination is closed
+ */
+static unsigned long volatile destination_generation;
+
+
+void Genode::invalidate_ipc_channels()
+{
+	__atomic_fetch_add(&destination_generation, 1UL, __ATOMIC_SEQ_CST);
+}
+
+
+/**
+ * Return inode of socket 'sd', which identifies the entrypoint behind it
+ *
+ * \return inode, or 0 if 'sd' is invalid
+ */
+static unsigned long socket_inode(int sd)
+{
+	struct stat64 st;
+	return lx_fstat(sd, &st) < 0 ? 0 : st.st_ino;
+}
+
+
+/**
+ * Return channel to the entrypoint behind 'dst_sd'
+ *
+ * \return channel, or nullptr if the call must take the socket-based path
+ * \throw  Blocking_canceled
+ */
+static Ipc_client_channel *client_channel(int dst_sd, Msgbuf_base &snd_msgbuf)
+{
+	/* capabilities can be transferred via sockets only */
+	if (!fast_path_enabled() || !Thread::myself() || snd_msgbuf.used_caps()
+	 || sizeof(Protocol_header) + snd_msgbuf.data_size() > Page::MSG_CAPACITY)
+		return nullptr;
+
+	Ipc_fast_path * const fast_path = ipc_fast_path(Thread::myself()->native_thread());
+	if (!fast_path)
+		return nullptr;
+
+	unsigned long const use_count  = ++fast_path->use_count;
+	unsigned long const generation = __atomic_load_n(&destination_generation,
+	                                                 __ATOMIC_ACQUIRE);
+
+	Ipc_client_channel *victim = nullptr;
+	for (Ipc_client_channel &channel : fast_path->client) {
+
+		/*
+		 * Channels are keyed by the identity of the destination socket. Once
+		 * a destination socket was closed, the socket number may refer to
+		 * another entrypoint. So the channel is revalidated.
+		 */
+		if (channel.dst_sd == dst_sd && channel.generation != generation) {
+			if (socket_inode(dst_sd) == channel.dst_ino)
+				channel.generation = generation;
+			else
+				close_client_channel(channel);
+		}
+
+		if (channel.dst_sd == dst_sd) {
+			channel.last_use = use_count;
+			return channel.refused ? nullptr : &channel;
+		}
+
+		/* a channel with an outstanding reply cannot be reused */
+		if (!channel.canceled && (!victim || channel.last_use < victim->last_use))
+			victim = &channel;
+	}
+
+	if (!victim)
+		return nullptr;
+
+	close_client_channel(*victim);
+
+	bool const connected = connect_channel(*victim, dst_sd);
+
+	victim->dst_sd     = dst_sd;
+	victim->dst_ino    = socket_inode(dst_sd);
+	victim->generation = generation;
+	victim->last_use   = use_count;
+
+	if (connected)
+		return victim;
+
+	/* remember refusal to avoid connection attempts for each call */
+	victim->refused = true;
+	return nullptr;
+}
+
+
+static bool server_alive(Ipc_client_channel const &channel)
+{
+	return !channel.ep->closed
+	    && lx_tgkill(channel.server_pid, channel.server_tid, 0) >= 0;
+}
+
+
+/**
+ * Wait until the entrypoint replied to the request in the channel page
+ *
+ * \throw Blocking_canceled
+ * \throw Ipc_error          entrypoint vanished
+ */
+static void await_reply(Ipc_client_channel &channel)
+{
+	int volatile &state = channel.page->state;
+
+	while (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == Page::REQUEST) {
+
+		/* check the liveliness of the entrypoint once in a while */
+		timespec timeout { 1, 0 };
+
+		int const ret = lx_futex((int *)&state, LX_FUTEX_WAIT, Page::REQUEST,
+		                         &timeout);
+
+		/* system call got interrupted by a signal */
+		if (ret == -LX_EINTR)
+			throw Blocking_canceled();
+
+		if (ret == -LX_ETIMEDOUT && !server_alive(channel)) {
+			close_client_channel(channel);
+			throw Ipc_error();
+		}
+	}
+}
+
+
+/**
+ * Receive reply that was sent via the socket of the channel
+ */
+static int receive_socket_reply(Ipc_client_channel &channel, Message &msg)
+{
+	msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+	int const ret = lx_recvmsg(channel.socket, msg.msg(), 0);
+	if (ret < 0)
+		PRAW("[%d] lx_recvmsg failed with %d in fast-path call", lx_getpid(), ret);
+
+	return ret;
+}
+
+
+static Rpc_exception_code fast_path_call(Ipc_client_channel &channel,
+                                         Native_capability   dst,
+                                         Msgbuf_base        &snd_msgbuf,
+                                         Msgbuf_base        &rcv_msgbuf)
+{
+	Page &page = *channel.page;
+
+	/* drop the reply of a canceled call before issuing a new request */
+	if (channel.canceled) {
+
+		await_reply(channel);
+
+		if (page.state == Page::REPLY_VIA_SOCKET) {
+			Protocol_header header;
+			Message msg(header.msg_start(), sizeof(header));
+			if (receive_socket_reply(channel, msg) > 0)
+				close_sockets(msg);
+		}
+		channel.canceled = false;
+	}
+
+	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
+	snd_header.protocol_word = dst.local_name();
+	snd_header.num_caps      = 0;
+
+	size_t const snd_size = sizeof(Protocol_header) + snd_msgbuf.data_size();
+	Genode::memcpy(page.msg, snd_header.msg_start(), snd_size);
+	page.size = snd_size;
+
+	__atomic_store_n(&page.state, (int)Page::REQUEST, __ATOMIC_RELEASE);
+
+	notify_entrypoint(channel);
+
+	/* if the call gets canceled, the reply must be collected later */
+	channel.canceled = true;
+	await_reply(channel);
+	channel.canceled = false;
+
+	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
+	rcv_header.protocol_word = 0;
+	rcv_msgbuf.reset();
+
+	size_t const rcv_capacity = sizeof(Protocol_header) + rcv_msgbuf.capacity();
+
+	if (page.state == Page::REPLY_VIA_SOCKET) {
+
+		Message rcv_msg(rcv_header.msg_start(), rcv_capacity);
+
+		int const ret = receive_socket_reply(channel, rcv_msg);
+
+		page.state = Page::IDLE;
+
+		if (ret < 0)
+			throw Genode::Ipc_error();
+
+		extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
+
+	} else {
+
+		Genode::memcpy(rcv_header.msg_start(), page.msg, min((size_t)page.size, rcv_capacity));
+		rcv_header.num_caps = 0;
+
+		page.state = Page::IDLE;
+	}
+
+	return Rpc_exception_code(rcv_header.protocol_word);
+}
+
+
+static void release_server_channel(Ipc_server_channel &channel)
+{
+	if (channel.page)         lx_munmap(channel.page, Page::SIZE);
+	if (channel.socket != -1) lx_close(channel.socket);
+
+	channel = Ipc_server_channel();
+}
+
+
+/**
+ * Allocate channel index at the entrypoint
+ *
+ * \return channel index, or -1 if all channels are in use
+ */
+static int alloc_server_channel(Ipc_fast_path &fast_path)
+{
+	for (unsigned pass = 0; pass < 2; pass++) {
+
+		for (unsigned i = 0; i < Ipc_ep_page::MAX_CHANNELS; i++)
+			if (fast_path.server[i].free())
+				return i;
+
+		/* reclaim channels of closed channels and vanished clients */
+		for (Ipc_server_channel &channel : fast_path.server)
+			if (channel.page->state == Page::CLOSED
+			 || lx_tgkill(channel.client_pid, channel.client_tid, 0) < 0)
+				release_server_channel(channel);
+	}
+	return -1;
+}
+
+
+/**
+ * Respond to the request for establishing a channel
+ */
+static void accept_channel(Ipc_fast_path *fast_path, Message const &msg,
+                           Msgbuf_base &request_msg)
+{
+	if (msg.num_sockets() != 2) {
+		close_sockets(msg);
+		return;
+	}
+
+	int const socket  = msg.socket_at_index(0);
+	int const page_fd = msg.socket_at_index(1);
+
+	Page *page = nullptr;
+	int   slot = -1;
+
+	if (fast_path && fast_path->ep) {
+		slot = alloc_server_channel(*fast_path);
+		if (slot >= 0)
+			page = (Page *)map_shared(page_fd, Page::SIZE);
+	}
+	lx_close(page_fd);
+
+	Connect_msg reply;
+	Genode::memset(&reply, 0, sizeof(reply));
+	reply.header.protocol_word = page ? (unsigned long)slot
+	                                  : (unsigned long)Protocol_header::INVALID_BADGE;
+	reply.pid                  = lx_getpid();
+	reply.tid                  = lx_gettid();
+
+	Message snd_msg(reply.header.msg_start(), sizeof(reply));
+	if (page)
+		snd_msg.marshal_socket(fast_path->ep_fd);
+
+	if (!page || lx_sendmsg(socket, snd_msg.msg(), 0) < 0) {
+		if (page) lx_munmap(page, Page::SIZE);
+		lx_close(socket);
+		return;
+	}
+
+	Ipc_server_channel &channel = fast_path->server[slot];
+	channel.page       = page;
+	channel.socket     = socket;
+	channel.client_pid = request_msg.word(0);
+	channel.client_tid = request_msg.word(1);
+}
+
+
+/**
+ * Return index of the next channel with a pending request
+ *
+ * \return channel index, or -1 if no request is pending
+ */
+static int next_fast_path_request(Ipc_fast_path &fast_path)
+{
+	enum {
+		BITS_PER_WORD = Ipc_ep_page::BITS_PER_WORD,
+		NUM_WORDS     = Ipc_ep_page::NUM_WORDS,
+		MAX_CHANNELS  = Ipc_ep_page::MAX_CHANNELS
+	};
+
+	/* take new pending bits once the previously taken ones are processed */
+	bool harvested = false;
+	for (unsigned i = 0; i < NUM_WORDS; i++)
+		harvested |= (fast_path.harvested[i] != 0);
+
+	if (!harvested)
+		for (unsigned i = 0; i < NUM_WORDS; i++)
+			fast_path.harvested[i] =
+				__atomic_exchange_n(&fast_path.ep->pending[i], 0UL, __ATOMIC_SEQ_CST);
+
+	/* serve channels in round-robin fashion */
+	for (unsigned n = 0; n < MAX_CHANNELS; n++) {
+
+		unsigned const slot = (fast_path.next_slot + n) % MAX_CHANNELS;
+
+		unsigned long      &word = fast_path.harvested[slot / BITS_PER_WORD];
+		unsigned long const bit  = 1UL << (slot % BITS_PER_WORD);
+
+		if (!(word & bit))
+			continue;
+
+		word &= ~bit;
+
+		Ipc_server_channel &channel = fast_path.server[slot];
+		if (channel.free())
+			continue;
+
+		int const state = __atomic_load_n(&channel.page->state, __ATOMIC_ACQUIRE);
+
+		if (state == Page::CLOSED)
+			release_server_channel(channel);
+
+		if (state != Page::REQUEST)
+			continue;
+
+		fast_path.next_slot = slot + 1;
+		return slot;
+	}
+	return -1;
+}
+
+
+/**
+ * Announce that the entrypoint is about to block at its socket
+ *
+ * \return false if a request became pending meanwhile
+ */
+static bool announce_sleep(Ipc_ep_page &ep)
+{
+	__atomic_store_n(&ep.sleeping, 1, __ATOMIC_SEQ_CST);
+
+	for (unsigned i = 0; i < Ipc_ep_page::NUM_WORDS; i++)
+		if (__atomic_load_n(&ep.pending[i], __ATOMIC_SEQ_CST)) {
+			__atomic_store_n(&ep.sleeping, 0, __ATOMIC_SEQ_CST);
+			return false;
+		}
+
+	return true;
+}
+
+
+static Rpc_request fast_path_request(Ipc_fast_path &fast_path, int slot,
+                                     Msgbuf_base &request_msg)
+{
+	Ipc_server_channel &channel = fast_path.server[slot];
+
+	Protocol_header &header = request_msg.header<Protocol_header>();
+
+	request_msg.reset();
+
+	size_t const capacity = sizeof(Protocol_header) + request_msg.capacity();
+	Genode::memcpy(header.msg_start(), channel.page->msg, min((size_t)channel.page->size, capacity));
+	header.num_caps = 0;
+
+	return Rpc_request(Capability_space::import(Rpc_destination(channel.socket, slot,
+	                                                            lx_gettid()),
+	                                            Rpc_obj_key()),
+	                   header.protocol_word);
+}
+
+
+/**
+ * Reply via the fast-path channel of the caller
+ *
+ * \throw Ipc_error  calling thread is not the entrypoint that received the
+ *                   request
+ */
+static void fast_path_reply(Rpc_destination dst, Rpc_exception_code exc,
+                            Msgbuf_base &snd_msgbuf)
+{
+	/*
+	 * The channel is private to the entrypoint that received the request.
+	 * The client waits at the channel page, not at the socket, so a reply
+	 * cannot be delivered by another thread.
+	 */
+	if (dst.owner != lx_gettid()) {
+		PRAW("[%d] fast-path reply must be sent by the receiving entrypoint %d",
+		     lx_gettid(), dst.owner);
+		throw Ipc_error();
+	}
+
+	Ipc_fast_path * const fast_path = Thread::myself()
+	                                ? Thread::myself()->native_thread().ipc_fast_path
+	                                : nullptr;
+
+	/* channel vanished since the request */
+	if (!fast_path || dst.channel >= Ipc_ep_page::MAX_CHANNELS
+	 || fast_path->server[dst.channel].socket != dst.socket)
+		return;
+
+	Page &page = *fast_path->server[dst.channel].page;
+
+	Protocol_header &header = snd_msgbuf.header<Protocol_header>();
+	header.protocol_word = exc.value;
+
+	size_t const size = sizeof(Protocol_header) + snd_msgbuf.data_size();
+
+	int state = Page::REPLY;
+
+	if (!snd_msgbuf.used_caps() && size <= Page::MSG_CAPACITY) {
+		header.num_caps = 0;
+		Genode::memcpy(page.msg, header.msg_start(), size);
+		page.size = size;
+	} else {
+		if (lx_send_reply(dst.socket, exc, snd_msgbuf) < 0)
+			return;
+		state = Page::REPLY_VIA_SOCKET;
+	}
+
+	/* the client may have closed the channel meanwhile */
+	int expected = Page::REQUEST;
+	if (__atomic_compare_exchange_n(&page.state, &expected, state, false,
+	                                __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		lx_futex((int *)&page.state, LX_FUTEX_WAKE, 1);
+}
+
+
+static void reply_to_caller(Native_capability const &caller, Rpc_exception_code exc,
+                            Msgbuf_base &snd_msgbuf)
+{
+	Rpc_destination const dst = Capability_space::ipc_cap_data(caller).dst;
+
+	if (dst.channel >= 0)
+		fast_path_reply(dst, exc, snd_msgbuf);
+	else
+		lx_reply(dst.socket, exc, snd_msgbuf);
+}
+
+
+static void release_server_side(Ipc_fast_path &fast_path)
+{
+	if (!fast_path.ep)
+		return;
+
+	fast_path.ep->closed = 1;
+
+	for (Ipc_server_channel &channel : fast_path.server)
+		release_server_channel(channel);
+
+	lx_munmap(fast_path.ep, Ipc_ep_page::SIZE);
+	lx_close(fast_path.ep_fd);
+
+	fast_path.ep    = nullptr;
+	fast_path.ep_fd = -1;
+}
+
+
+void Genode::release_ipc_fast_path(Native_thread &native_thread)
+{
+	Ipc_fast_path * const fast_path = native_thread.ipc_fast_path;
+	if (!fast_path)
+		return;
+
+	for (Ipc_client_channel &channel : fast_path->client)
+		close_client_channel(channel);
+
+	release_server_side(*fast_path);
+
+	lx_munmap(fast_path, sizeof(Ipc_fast_path));
+	native_thread.ipc_fast_path = nullptr;
+}
+
+
 /****************
  ** IPC client **
  ****************/
@@ -353,6 +1113,11 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
                                     Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
                                     size_t)
 {
+	int const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
+
+	if (Ipc_client_channel *channel = client_channel(dst_socket, snd_msgbuf))
+		return fast_path_call(*channel, dst, snd_msgbuf, rcv_msgbuf);
+
 	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
 	snd_header.protocol_word = dst.local_name();
 
@@ -399,8 +1164,6 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
 
-	int const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
-
 	int const send_ret = lx_sendmsg(dst_socket, snd_msg.msg(), 0);
 	if (send_ret < 0) {
 		raw(Pid(), " lx_sendmsg to sd ", dst_socket,
@@ -442,9 +1205,7 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 void Genode::ipc_reply(Native_capability caller, Rpc_exception_code exc,
                        Msgbuf_base &snd_msg)
 {
-	int const reply_socket = Capability_space::ipc_cap_data(caller).dst.socket;
-
-	try { lx_reply(reply_socket, exc, snd_msg); } catch (Ipc_error) { }
+	try { reply_to_caller(caller, exc, snd_msg); } catch (Ipc_error) { }
 }
 
 
@@ -455,7 +1216,7 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 {
 	/* when first called, there was no request yet */
 	if (last_caller.valid() && exc.value != Rpc_exception_code::INVALID_OBJECT)
-		lx_reply(Capability_space::ipc_cap_data(last_caller).dst.socket, exc, reply_msg);
+		reply_to_caller(last_caller, exc, reply_msg);
 
 	/*
 	 * Block infinitely if called from the main thread. This may happen if the
@@ -466,18 +1227,34 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 		for (;;) lx_nanosleep(&ts, 0);
 	}
 
+	Native_thread &native_thread = Thread::myself()->native_thread();
+
+	Ipc_fast_path * const fast_path = native_thread.ipc_fast_path;
+	Ipc_ep_page   * const ep        = fast_path ? fast_path->ep : nullptr;
+
 	for (;;) {
 
+		/* serve pending fast-path requests before blocking at the socket */
+		if (ep) {
+			int const slot = next_fast_path_request(*fast_path);
+			if (slot >= 0)
+				return fast_path_request(*fast_path, slot, request_msg);
+
+			if (!announce_sleep(*ep))
+				continue;
+		}
+
 		Protocol_header &header = request_msg.header<Protocol_header>();
 		Message msg(header.msg_start(), sizeof(Protocol_header) + request_msg.capacity());
 
 		msg.accept_sockets(Message::MAX_SDS_PER_MSG);
 
-		Native_thread &native_thread = Thread::myself()->native_thread();
-
 		request_msg.reset();
 		int const ret = lx_recvmsg(native_thread.socket_pair.server_sd, msg.msg(), 0);
 
+		if (ep)
+			__atomic_store_n(&ep->sleeping, 0, __ATOMIC_SEQ_CST);
+
 		/* system call got interrupted by a signal */
 		if (ret == -LX_EINTR)
 			continue;
@@ -488,6 +1265,17 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 			continue;
 		}
 
+		/* doorbell of a fast-path client */
+		if (ret < (int)sizeof(unsigned long)) {
+			close_sockets(msg);
+			continue;
+		}
+
+		if (header.protocol_word == Protocol_header::CONNECT_BADGE) {
+			accept_channel(fast_path, msg, request_msg);
+			continue;
+		}
+
 		int           const reply_socket = msg.socket_at_index(0);
 		unsigned long const badge        = header.protocol_word;
 
@@ -526,6 +1314,22 @@ Ipc_server::Ipc_server()
 	native_thread.socket_pair    = socket_pair;
 	native_thread.is_ipc_server = true;
 
+	/* provide the page shared with fast-path clients */
+	Ipc_fast_path * const fast_path = fast_path_enabled()
+	                                ? ipc_fast_path(native_thread) : nullptr;
+	if (fast_path) {
+		int const fd = create_shared_memory("ipc-ep", Ipc_ep_page::SIZE);
+		Ipc_ep_page * const ep = (fd >= 0)
+		                       ? (Ipc_ep_page *)map_shared(fd, Ipc_ep_page::SIZE)
+		                       : nullptr;
+		if (ep) {
+			fast_path->ep    = ep;
+			fast_path->ep_fd = fd;
+		} else if (fd >= 0) {
+			lx_close(fd);
+		}
+	}
+
 	/* override capability initialization */
 	*static_cast<Native_capability *>(this) =
 		Capability_space::import(Rpc_destination(socket_pair.client_sd),
@@ -547,6 +1351,9 @@ Ipc_server::~Ipc_server()
 	Genode::ep_sd_registry()->disassociate(native_thread.socket_pair.client_sd);
 	native_thread.is_ipc_server = false;
 
+	if (native_thread.ipc_fast_path)
+		release_server_side(*native_thread.ipc_fast_path);
+
 	destroy_server_socket_pair(native_thread.socket_pair);
 	native_thread.socket_pair = Socket_pair();
 }
@@ -23,6 +23,7 @@
 #include <base/internal/globals.h>
 #include <base/internal/parent_socket_handle.h>
 #include <base/internal/capability_space_tpl.h>
+#include <base/internal/ipc_channel.h>
 
 using namespace Genode;
 
@@ -197,6 +198,9 @@ namespace Genode {
 
 	void destroy_server_socket_pair(Socket_pair socket_pair)
 	{
+		/* channels to the entrypoint must not survive the reuse of the fds */
+		invalidate_ipc_channels();
+
 		/* close local file descriptor if it is valid */
 		if (socket_pair.server_sd != -1) lx_close(socket_pair.server_sd);
 		if (socket_pair.client_sd != -1) lx_close(socket_pair.client_sd);
@@ -155,6 +155,15 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 		throw Region_map::Region_conflict();
 	}
 
+	/*
+	 * Allow the kernel to back large writable dataspaces with transparent
+	 * huge pages. The advice takes effect only if the host enables huge
+	 * pages for shared memory ('shmem_enabled' set to 'advise').
+	 */
+	enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+	if (writable && size >= HUGE_PAGE_SIZE)
+		lx_madvise(addr_out, size, LX_MADV_HUGEPAGE);
+
 	return addr_out;
 }
 
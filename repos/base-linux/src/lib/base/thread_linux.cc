@@ -23,6 +23,7 @@
 
 /* base-internal includes */
 #include <base/internal/stack.h>
+#include <base/internal/ipc_channel.h>
 
 /* Linux syscall bindings */
 #include <linux_syscalls.h>
@@ -128,6 +129,9 @@ void Thread::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	/* the thread cannot use its IPC fast-path channels anymore */
+	release_ipc_fast_path(native_thread());
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
@@ -19,6 +19,7 @@
 
 /* base-internal includes */
 #include <base/internal/native_thread.h>
+#include <base/internal/ipc_channel.h>
 #include <base/internal/globals.h>
 #include <base/internal/platform_env.h>
 
@@ -543,6 +544,9 @@ Thread::~Thread()
 			        "with ", ret, " (errno=", errno, ")");
 	}
 
+	/* the thread cannot use its IPC fast-path channels anymore */
+	release_ipc_fast_path(native_thread());
+
 	Thread_meta_data_created *meta_data =
 		dynamic_cast<Thread_meta_data_created *>(native_thread().meta_data);
 
@@ -52,6 +52,7 @@
 #include <sys/un.h>
 #include <sys/socket.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 
 #undef size_t
 
@@ -213,6 +214,49 @@ inline int lx_munmap(void *addr, Genode::size_t length)
 }
 
 
+inline int lx_ftruncate(int fd, unsigned long length)
+{
+	return lx_syscall(SYS_ftruncate, fd, length);
+}
+
+
+inline int lx_fstat(int fd, struct stat64 *buf)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fstat, fd, buf);
+#else
+	return lx_syscall(SYS_fstat64, fd, buf);
+#endif
+}
+
+
+/* the flags of 'memfd_create' are not provided by older host headers */
+enum { LX_MFD_CLOEXEC = 0x0001U, LX_MFD_ALLOW_SEALING = 0x0002U };
+
+/**
+ * Create anonymous memory file
+ *
+ * \return file descriptor, or negative error code if the kernel does not
+ *         support memory files
+ */
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+#ifdef SYS_memfd_create
+	return lx_syscall(SYS_memfd_create, name, flags);
+#else
+	return -38; /* ENOSYS */
+#endif
+}
+
+
+enum { LX_MADV_HUGEPAGE = 14 };
+
+inline int lx_madvise(void *addr, Genode::size_t length, int advice)
+{
+	return lx_syscall(SYS_madvise, addr, length, advice);
+}
+
+
 /***********************************************************************
  ** Functions used by thread lib and core's cancel-blocking mechanism **
  ***********************************************************************/
@@ -349,6 +393,13 @@ inline int lx_futex(const int *uaddr, int op, int val)
 }
 
 
+inline int lx_futex(const int *uaddr, int op, int val,
+                    struct timespec const *timeout)
+{
+	return lx_syscall(SYS_futex, uaddr, op, val, timeout, 0, 0);
+}
+
+
 /**
  * Signal set corrsponding to glibc's 'sigset_t'
  */
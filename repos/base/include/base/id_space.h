@@ -15,7 +15,7 @@
 #define _INCLUDE__BASE__ID_SPACE_H_
 
 #include <util/noncopyable.h>
-#include <base/lock.h>
+#include <base/rw_lock.h>
 #include <base/log.h>
 #include <util/avl_tree.h>
 
@@ -84,7 +84,7 @@ class Genode::Id_space : public Noncopyable
 				:
 					_obj(obj), _id_space(id_space)
 				{
-					Lock::Guard guard(_id_space._lock);
+					Rw_lock::Write_guard guard(_id_space._lock);
 					_id = id_space._unused_id(*this);
 					_id_space._elements.insert(this);
 				}
@@ -98,14 +98,14 @@ class Genode::Id_space : public Noncopyable
 				:
 					_obj(obj), _id_space(id_space), _id(id)
 				{
-					Lock::Guard guard(_id_space._lock);
+					Rw_lock::Write_guard guard(_id_space._lock);
 					_id_space._check_conflict(*this, id);
 					_id_space._elements.insert(this);
 				}
 
 				~Element()
 				{
-					Lock::Guard guard(_id_space._lock);
+					Rw_lock::Write_guard guard(_id_space._lock);
 					_id_space._elements.remove(this);
 				}
 
@@ -121,7 +121,7 @@ class Genode::Id_space : public Noncopyable
 
 	private:
  
-		Lock mutable      _lock;       /* protect '_elements' and '_cnt' */
+		Rw_lock mutable   _lock;       /* protect '_elements' and '_cnt' */
 		Avl_tree<Element> _elements;
 		unsigned long     _cnt = 0;
 
@@ -174,7 +174,7 @@ class Genode::Id_space : public Noncopyable
 		template <typename ARG, typename FUNC>
 		void for_each(FUNC const &fn) const
 		{
-			Lock::Guard guard(_lock);
+			Rw_lock::Read_guard guard(_lock);
 
 			if (_elements.first())
 				_elements.first()->template _for_each<ARG>(fn);
@@ -192,7 +192,7 @@ class Genode::Id_space : public Noncopyable
 		{
 			T *obj = nullptr;
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (!_elements.first())
 					throw Unknown_id();
@@ -224,7 +224,7 @@ class Genode::Id_space : public Noncopyable
 		{
 			T *obj = nullptr;
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (_elements.first())
 					obj = &_elements.first()->_obj;
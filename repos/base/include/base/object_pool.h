@@ -20,6 +20,7 @@
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
+#include <base/rw_lock.h>
 
 namespace Genode { template <typename> class Object_pool; }
 
@@ -94,13 +95,18 @@ class Genode::Object_pool
 	private:
 
 		Avl_tree<Entry> _tree;
-		Lock            _lock;
+
+		/*
+		 * Lookups are by far more frequent than insertions and removals.
+		 * Hence, concurrent lookups do not exclude each other.
+		 */
+		Rw_lock _lock;
 
 	protected:
 
 		bool empty()
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Read_guard lock_guard(_lock);
 			return _tree.first() == nullptr;
 		}
 
@@ -108,13 +114,13 @@ class Genode::Object_pool
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Write_guard lock_guard(_lock);
 			_tree.insert(obj);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Write_guard lock_guard(_lock);
 			_tree.remove(obj);
 		}
 
@@ -130,7 +136,7 @@ class Genode::Object_pool
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Rw_lock::Read_guard lock_guard(_lock);
 
 				Entry * entry = _tree.first() ?
 					_tree.first()->find_by_obj_id(capid) : nullptr;
@@ -163,7 +169,7 @@ class Genode::Object_pool
 				OBJ_TYPE * obj;
 
 				{
-					Lock::Guard lock_guard(_lock);
+					Rw_lock::Write_guard lock_guard(_lock);
 
 					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
 
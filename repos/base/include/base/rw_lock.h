@@ -0,0 +1,291 @@
+/*
+ * \brief  Readers-writer lock
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__RW_LOCK_H_
+#define _INCLUDE__BASE__RW_LOCK_H_
+
+/* Genode includes */
+#include <base/lock.h>
+#include <util/fifo.h>
+#include <util/noncopyable.h>
+#include <cpu/atomic.h>
+
+namespace Genode { class Rw_lock; }
+
+
+/**
+ * Lock that is held either by one writer or by any number of readers
+ *
+ * With the 'PREFER_READERS' policy, readers enter whenever no writer holds
+ * the lock, which may starve writers. With the 'PREFER_WRITERS' policy, a
+ * waiting writer holds off newly arriving readers, and waiting writers take
+ * precedence over waiting readers when the lock becomes free.
+ *
+ * As long as no thread has to wait, acquiring and releasing the lock
+ * amounts to one atomic operation each. Threads that have to wait are
+ * queued and blocked under a meta lock. The lock is handed over directly
+ * to the woken-up threads.
+ *
+ * The lock is not recursive. In particular, a reader must not acquire the
+ * lock for writing.
+ */
+class Genode::Rw_lock : Noncopyable
+{
+	public:
+
+		enum Policy { PREFER_READERS, PREFER_WRITERS };
+
+	private:
+
+		/*
+		 * The state word contains the number of readers holding the lock
+		 * and two flags. While 'WAITING' is set, all state changes are
+		 * performed with the meta lock held.
+		 */
+		enum {
+			WRITER  = 1 << 30,  /* lock is held by a writer */
+			WAITING = 1 << 29,  /* threads are queued for the lock */
+			READERS = WAITING - 1
+		};
+
+		struct Waiter : Fifo<Waiter>::Element
+		{
+			Lock lock { Lock::LOCKED };
+
+			void block()   { lock.lock();   }
+			void wake_up() { lock.unlock(); }
+		};
+
+		Policy const _policy;
+
+		int volatile _state = 0;
+
+		Lock         _meta_lock;
+		Fifo<Waiter> _waiting_readers;
+		Fifo<Waiter> _waiting_writers;
+
+		/**
+		 * Atomically apply 'fn' to the state word
+		 *
+		 * \return  new state
+		 */
+		template <typename FN>
+		int _update(FN const &fn)
+		{
+			for (;;) {
+				int const old_state = _state;
+				int const new_state = fn(old_state);
+				if (cmpxchg(&_state, old_state, new_state))
+					return new_state;
+			}
+		}
+
+		bool _reader_may_enter(int state)
+		{
+			return !(state & WRITER)
+			    && !(_policy == PREFER_WRITERS && !_waiting_writers.empty());
+		}
+
+		/**
+		 * Hand the free lock over to waiting threads
+		 *
+		 * Must be called with '_meta_lock' held. The threads to wake up are
+		 * moved to 'wake_up'.
+		 */
+		void _hand_over(Fifo<Waiter> &wake_up)
+		{
+			bool const writer_first = (_policy == PREFER_WRITERS)
+			                       || _waiting_readers.empty();
+
+			int granted = 0;
+
+			if (writer_first && !_waiting_writers.empty()) {
+				wake_up.enqueue(_waiting_writers.dequeue());
+				granted = WRITER;
+			} else {
+				while (Waiter *waiter = _waiting_readers.dequeue()) {
+					wake_up.enqueue(waiter);
+					granted++;
+				}
+			}
+
+			bool const still_waiting = !_waiting_readers.empty()
+			                        || !_waiting_writers.empty();
+
+			_update([&] (int state) {
+				state += granted;
+				return still_waiting ? state : state & ~WAITING; });
+		}
+
+		/*
+		 * The waiters are woken up without holding the meta lock because
+		 * each woken-up thread may immediately destruct its 'Waiter'.
+		 */
+		static void _wake_up(Fifo<Waiter> &waiters)
+		{
+			while (Waiter *waiter = waiters.dequeue())
+				waiter->wake_up();
+		}
+
+		/**
+		 * Wait until the lock is handed over to us
+		 *
+		 * Must be called with '_meta_lock' held and 'WAITING' set.
+		 */
+		void _block(Fifo<Waiter> &queue)
+		{
+			Waiter waiter;
+			queue.enqueue(&waiter);
+			_meta_lock.unlock();
+
+			waiter.block();
+		}
+
+		void _lock_read_slow()
+		{
+			_meta_lock.lock();
+
+			for (;;) {
+				int const state = _state;
+
+				if (_reader_may_enter(state)) {
+					if (!cmpxchg(&_state, state, state + 1))
+						continue;
+
+					_meta_lock.unlock();
+					return;
+				}
+
+				if (cmpxchg(&_state, state, state | WAITING))
+					break;
+			}
+
+			_block(_waiting_readers);
+		}
+
+		void _lock_write_slow()
+		{
+			_meta_lock.lock();
+
+			for (;;) {
+				int const state = _state;
+
+				if (!(state & (WRITER | READERS))) {
+					if (!cmpxchg(&_state, state, state | WRITER))
+						continue;
+
+					_meta_lock.unlock();
+					return;
+				}
+
+				if (cmpxchg(&_state, state, state | WAITING))
+					break;
+			}
+
+			_block(_waiting_writers);
+		}
+
+		void _release_slow(int held)
+		{
+			Fifo<Waiter> wake_up;
+			{
+				Lock::Guard guard(_meta_lock);
+
+				int const state = _update([&] (int state) { return state - held; });
+
+				if (!(state & (WRITER | READERS)))
+					_hand_over(wake_up);
+			}
+			_wake_up(wake_up);
+		}
+
+	public:
+
+		explicit Rw_lock(Policy policy = PREFER_WRITERS) : _policy(policy) { }
+
+		~Rw_lock()
+		{
+			/* synchronize destruction with unfinished 'unlock_*()' */
+			try { _meta_lock.lock(); } catch (...) { }
+		}
+
+		void lock_read()
+		{
+			int const state = _state;
+			if (!(state & (WRITER | WAITING)) && cmpxchg(&_state, state, state + 1))
+				return;
+
+			_lock_read_slow();
+		}
+
+		void unlock_read()
+		{
+			for (int state; !((state = _state) & WAITING); )
+				if (cmpxchg(&_state, state, state - 1))
+					return;
+
+			_release_slow(1);
+		}
+
+		void lock_write()
+		{
+			if (cmpxchg(&_state, 0, WRITER))
+				return;
+
+			_lock_write_slow();
+		}
+
+		void unlock_write()
+		{
+			if (cmpxchg(&_state, WRITER, 0))
+				return;
+
+			_release_slow(WRITER);
+		}
+
+		/**
+		 * Guard for holding the lock as reader
+		 */
+		class Read_guard : Noncopyable
+		{
+			private:
+
+				Rw_lock &_lock;
+
+			public:
+
+				explicit Read_guard(Rw_lock &lock) : _lock(lock) {
+					_lock.lock_read(); }
+
+				~Read_guard() { _lock.unlock_read(); }
+		};
+
+		/**
+		 * Guard for holding the lock as writer
+		 */
+		class Write_guard : Noncopyable
+		{
+			private:
+
+				Rw_lock &_lock;
+
+			public:
+
+				explicit Write_guard(Rw_lock &lock) : _lock(lock) {
+					_lock.lock_write(); }
+
+				~Write_guard() { _lock.unlock_write(); }
+		};
+};
+
+#endif /* _INCLUDE__BASE__RW_LOCK_H_ */
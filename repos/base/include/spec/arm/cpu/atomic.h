@@ -54,6 +54,18 @@ namespace Genode {
 		Genode::memory_barrier();
 		return equal && !not_exclusive;
 	}
+
+	/**
+	 * Hint the CPU that the caller is spinning on a memory location
+	 *
+	 * The 'yield' hint is not available on all supported ARM cores. Hence,
+	 * the function merely prevents the compiler from caching the spun-on
+	 * value.
+	 */
+	inline void cpu_relax()
+	{
+		__asm__ __volatile__ ("" ::: "memory");
+	}
 }
 
 #endif /* _INCLUDE__SPEC__ARM__CPU__ATOMIC_H_ */
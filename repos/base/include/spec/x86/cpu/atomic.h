@@ -50,6 +50,17 @@ namespace Genode {
 
 		return tmp == cmp_val;
 	}
+
+	/**
+	 * Hint the CPU that the caller is spinning on a memory location
+	 *
+	 * The 'pause' instruction relieves the memory pipeline and the sibling
+	 * hyperthread while busy waiting.
+	 */
+	inline void cpu_relax()
+	{
+		__asm__ __volatile__ ("pause" ::: "memory");
+	}
 }
 
 #endif /* _INCLUDE__SPEC__X86__CPU__ATOMIC_H_ */
@@ -0,0 +1,558 @@
+/*
+ * \brief  Pre-parsed index of an XML node
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+
+
+/**
+ * Structure of an XML node and all its sub nodes
+ *
+ * Each method of 'Xml_node' that navigates to a sub node or attribute
+ * tokenizes the XML data anew, which makes the traversal of large documents
+ * quadratic. An 'Xml_index' parses the document once and records the
+ * location of each node, the relation of the nodes, and their attributes.
+ * Navigating the index takes constant time and attributes are looked up via
+ * a hash table. The XML data is not copied and must stay in place during
+ * the lifetime of the index.
+ *
+ * In contrast to 'Xml_node', the index validates the whole document. The
+ * constructor throws 'Xml_node::Invalid_syntax' if the start and end tag of
+ * any sub node do not match.
+ */
+class Genode::Xml_index : Noncopyable
+{
+	public:
+
+		typedef Xml_node::Nonexistent_sub_node  Nonexistent_sub_node;
+		typedef Xml_node::Nonexistent_attribute Nonexistent_attribute;
+		typedef Xml_node::Invalid_syntax        Invalid_syntax;
+
+		class Node;
+
+	private:
+
+		typedef Xml_node::Token   Token;
+		typedef Xml_node::Tag     Tag;
+		typedef Xml_node::Comment Comment;
+
+		enum { INVALID = ~0U };
+
+		struct Node_info
+		{
+			char const *addr;        /* begin of node                     */
+			char const *end;         /* begin of end tag or nullptr       */
+			char const *type;        /* begin of tag name                 */
+			unsigned    type_len;
+			unsigned    type_hash;
+			unsigned    parent;
+			unsigned    slot;        /* position in '_children' array     */
+			unsigned    first_child; /* first position of sub nodes       */
+			unsigned    num_sub_nodes;
+			unsigned    first_attr;  /* first position in '_attrs' array  */
+			unsigned    num_attrs;
+		};
+
+		struct Attr_info
+		{
+			char const *name;
+			unsigned    name_len;
+			unsigned    node;
+		};
+
+		Allocator   &_alloc;
+		char const  *_addr;
+		size_t const _max_len;
+		unsigned     _num_nodes    = 0;
+		unsigned     _num_attrs    = 0;
+		unsigned     _table_size   = 0;
+		Node_info   *_nodes        = nullptr;
+		unsigned    *_children     = nullptr;
+		Attr_info   *_attrs        = nullptr;
+		unsigned    *_attr_table   = nullptr;   /* attribute index + 1 */
+
+		static unsigned _hash(char const *s, size_t len)
+		{
+			unsigned hash = 2166136261U;
+			for (size_t i = 0; i < len; i++)
+				hash = (hash ^ (unsigned char)s[i]) * 16777619U;
+			return hash;
+		}
+
+		static unsigned _attr_hash(unsigned node, char const *name, size_t len) {
+			return _hash(name, len) ^ (node * 2654435761U); }
+
+		/**
+		 * Call 'fn' for each tag of 'node' in document order
+		 */
+		template <typename FN>
+		static void _for_each_tag(Xml_node const &node, FN const &fn)
+		{
+			char const *end = node.addr() + node.size();
+
+			for (Token t = node._start_tag.token(); t && t.start() < end; ) {
+
+				Comment comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				fn(tag);
+				t = tag.next_token();
+			}
+		}
+
+		/**
+		 * Call 'fn' with the first token of each attribute of 'tag'
+		 */
+		template <typename FN>
+		static void _for_each_attribute(Tag const &tag, FN const &fn)
+		{
+			for (Token t = tag.name().next().eat_whitespace();
+			     t.type() == Token::IDENT;
+			     t = Xml_attribute(t)._next().eat_whitespace())
+				fn(t);
+		}
+
+		template <typename T>
+		T *_alloc_array(unsigned num)
+		{
+			return num ? (T *)_alloc.alloc(num*sizeof(T)) : nullptr;
+		}
+
+		template <typename T>
+		void _free_array(T *array, unsigned num)
+		{
+			if (array)
+				_alloc.free(array, num*sizeof(T));
+		}
+
+		void _free()
+		{
+			_free_array(_nodes,      _num_nodes);
+			_free_array(_children,   _num_nodes);
+			_free_array(_attrs,      _num_attrs);
+			_free_array(_attr_table, _table_size);
+		}
+
+		void _insert_attr(unsigned idx)
+		{
+			Attr_info const &attr = _attrs[idx];
+
+			unsigned i = _attr_hash(attr.node, attr.name, attr.name_len);
+			for (;; i++) {
+				unsigned &entry = _attr_table[i & (_table_size - 1)];
+				if (!entry) {
+					entry = idx + 1;
+					return;
+				}
+			}
+		}
+
+		void _build(Xml_node const &node)
+		{
+			/* determine number of nodes and attributes */
+			_for_each_tag(node, [&] (Tag const &tag) {
+				if (!tag.node())
+					return;
+
+				_num_nodes++;
+				_for_each_attribute(tag, [&] (Token) { _num_attrs++; });
+			});
+
+			for (_table_size = 1; _table_size < 2*_num_attrs; _table_size <<= 1);
+
+			_nodes      = _alloc_array<Node_info>(_num_nodes);
+			_children   = _alloc_array<unsigned>(_num_nodes);
+			_attrs      = _alloc_array<Attr_info>(_num_attrs);
+			_attr_table = _alloc_array<unsigned>(_table_size);
+
+			for (unsigned i = 0; i < _table_size; i++)
+				_attr_table[i] = 0;
+
+			/*
+			 * Record nodes in document order
+			 *
+			 * Like 'Xml_node::sub_node', the first sub node of a node starts
+			 * right after the start tag of its parent.
+			 */
+			unsigned    num_nodes = 0, num_attrs = 0, curr = INVALID;
+			char const *content   = node.addr();
+			_for_each_tag(node, [&] (Tag const &tag) {
+
+				if (tag.type() == Tag::END) {
+
+					if (curr == INVALID)
+						throw Invalid_syntax();
+
+					Node_info &info = _nodes[curr];
+					Token const name = tag.name();
+					if (name.len() != info.type_len
+					 || strcmp(name.start(), info.type, info.type_len))
+						throw Invalid_syntax();
+
+					info.end = tag.token().start();
+					curr     = info.parent;
+					content  = nullptr;
+					return;
+				}
+
+				unsigned const id   = num_nodes++;
+				Token    const name = tag.name();
+
+				Node_info &info = _nodes[id];
+				info.addr          = content ? content : tag.token().start();
+				info.end           = nullptr;
+				info.type          = name.start();
+				info.type_len      = name.len();
+				info.type_hash     = _hash(name.start(), name.len());
+				info.parent        = curr;
+				info.slot          = 0;
+				info.first_child   = 0;
+				info.num_sub_nodes = 0;
+				info.first_attr    = num_attrs;
+				info.num_attrs     = 0;
+
+				if (curr != INVALID)
+					_nodes[curr].num_sub_nodes++;
+
+				_for_each_attribute(tag, [&] (Token t) {
+					Attr_info &attr = _attrs[num_attrs];
+					attr.name     = t.start();
+					attr.name_len = t.len();
+					attr.node     = id;
+					_insert_attr(num_attrs++);
+					info.num_attrs++;
+				});
+
+				content = nullptr;
+				if (tag.type() == Tag::START) {
+					curr    = id;
+					content = tag.next_token().start();
+				}
+			});
+
+			if (curr != INVALID)
+				throw Invalid_syntax();
+
+			/*
+			 * Assign contiguous ranges of the '_children' array to the sub
+			 * nodes of each node. Traversing the nodes in reverse document
+			 * order fills each range from its end.
+			 */
+			unsigned first = 1;
+			for (unsigned i = 0; i < _num_nodes; i++) {
+				first += _nodes[i].num_sub_nodes;
+				_nodes[i].first_child = first;
+			}
+			_children[0] = 0;
+			for (unsigned i = _num_nodes - 1; i > 0; i--) {
+				unsigned const slot = --_nodes[_nodes[i].parent].first_child;
+				_children[slot] = i;
+				_nodes[i].slot  = slot;
+			}
+		}
+
+		Node_info const &_info(unsigned id) const { return _nodes[id]; }
+
+		unsigned _sub_node(unsigned id, unsigned idx) const
+		{
+			Node_info const &info = _nodes[id];
+			if (idx >= info.num_sub_nodes)
+				throw Nonexistent_sub_node();
+
+			return _children[info.first_child + idx];
+		}
+
+		unsigned _attr(unsigned id, char const *name) const
+		{
+			size_t const len = strlen(name);
+
+			for (unsigned i = _attr_hash(id, name, len);; i++) {
+				unsigned const entry = _attr_table[i & (_table_size - 1)];
+				if (!entry)
+					throw Nonexistent_attribute();
+
+				Attr_info const &attr = _attrs[entry - 1];
+				if (attr.node == id && attr.name_len == len
+				 && !strcmp(attr.name, name, len))
+					return entry - 1;
+			}
+		}
+
+		Xml_attribute _attribute(unsigned idx) const
+		{
+			char const *name = _attrs[idx].name;
+			return Xml_attribute(Token(name, _max_len - (name - _addr)));
+		}
+
+		Xml_node _xml_node(unsigned id) const
+		{
+			Node_info const &info = _nodes[id];
+			return Xml_node(info.addr, _max_len - (info.addr - _addr),
+			                info.end, info.num_sub_nodes);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the index data
+		 * \param node   XML node to index
+		 *
+		 * \throw Invalid_syntax
+		 * \throw Allocator::Out_of_memory
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			_alloc(alloc), _addr(node.addr()), _max_len(node._max_len)
+		{
+			try { _build(node); }
+			catch (...) { _free(); throw; }
+		}
+
+		~Xml_index() { _free(); }
+
+		/**
+		 * Return number of indexed nodes including the top-level node
+		 */
+		size_t num_nodes() const { return _num_nodes; }
+
+		/**
+		 * Return top-level node
+		 */
+		inline Node root() const;
+
+		/**
+		 * Return indexed counterpart of 'node'
+		 *
+		 * The lookup takes logarithmic time.
+		 *
+		 * \throw Nonexistent_sub_node  'node' is not part of the index
+		 */
+		inline Node node(Xml_node const &node) const;
+};
+
+
+/**
+ * Indexed XML node
+ *
+ * The interface corresponds to the one of 'Xml_node'. A 'Node' refers to
+ * its 'Xml_index' and must not be used after the index is destructed.
+ */
+class Genode::Xml_index::Node
+{
+	private:
+
+		friend class Xml_index;
+
+		Xml_index const *_index;
+		unsigned         _id;
+
+		Node(Xml_index const &index, unsigned id) : _index(&index), _id(id) { }
+
+		Node_info const &_info() const { return _index->_info(_id); }
+
+	public:
+
+		/**
+		 * Return node as 'Xml_node' without scanning the XML data
+		 */
+		Xml_node xml() const { return _index->_xml_node(_id); }
+
+		Xml_node::Type type() const {
+			return Xml_node::Type(Cstring(_info().type, _info().type_len)); }
+
+		bool has_type(char const *type) const
+		{
+			Node_info const &info = _info();
+			return strlen(type) == info.type_len
+			    && !strcmp(type, info.type, info.type_len);
+		}
+
+		size_t num_sub_nodes() const { return _info().num_sub_nodes; }
+
+		/**
+		 * Return sub node with specified index
+		 *
+		 * \throw Nonexistent_sub_node
+		 */
+		Node sub_node(unsigned idx = 0U) const {
+			return Node(*_index, _index->_sub_node(_id, idx)); }
+
+		/**
+		 * Return first sub node that matches the specified type
+		 *
+		 * \throw Nonexistent_sub_node
+		 */
+		Node sub_node(char const *type) const
+		{
+			Node_info const &info = _info();
+			size_t   const len  = strlen(type);
+			unsigned const hash = _hash(type, len);
+
+			for (unsigned i = 0; i < info.num_sub_nodes; i++) {
+				unsigned   const  id    = _index->_sub_node(_id, i);
+				Node_info  const &child = _index->_info(id);
+				if (child.type_hash == hash && child.type_len == len
+				 && !strcmp(child.type, type, len))
+					return Node(*_index, id);
+			}
+			throw Nonexistent_sub_node();
+		}
+
+		bool has_sub_node(char const *type) const
+		{
+			try { sub_node(type); return true; }
+			catch (Nonexistent_sub_node) { return false; }
+		}
+
+		/**
+		 * Return node following the current one
+		 *
+		 * \throw Nonexistent_sub_node
+		 */
+		Node next() const
+		{
+			Node_info const &info = _info();
+			if (info.parent == INVALID)
+				throw Nonexistent_sub_node();
+
+			Node_info const &parent = _index->_info(info.parent);
+			if (info.slot + 1 >= parent.first_child + parent.num_sub_nodes)
+				throw Nonexistent_sub_node();
+
+			return Node(*_index, _index->_children[info.slot + 1]);
+		}
+
+		/**
+		 * Return true if node is the last of a node sequence
+		 */
+		bool last() const
+		{
+			try { next(); return false; }
+			catch (Nonexistent_sub_node) { return true; }
+		}
+
+		/**
+		 * Return node that contains the current one
+		 *
+		 * \throw Nonexistent_sub_node  node is the top-level node
+		 */
+		Node parent() const
+		{
+			if (_info().parent == INVALID)
+				throw Nonexistent_sub_node();
+
+			return Node(*_index, _info().parent);
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node of specified type
+		 *
+		 * The functor is called with a 'Node const &' argument.
+		 */
+		template <typename FN>
+		void for_each_sub_node(char const *type, FN const &fn) const
+		{
+			Node_info const &info = _info();
+			for (unsigned i = 0; i < info.num_sub_nodes; i++) {
+				Node const node(*_index, _index->_sub_node(_id, i));
+				if (!type || node.has_type(type))
+					fn(node);
+			}
+		}
+
+		template <typename FN>
+		void for_each_sub_node(FN const &fn) const {
+			for_each_sub_node(nullptr, fn); }
+
+		size_t num_attributes() const { return _info().num_attrs; }
+
+		/**
+		 * Return Nth attribute of node
+		 *
+		 * \throw Nonexistent_attribute
+		 */
+		Xml_attribute attribute(unsigned idx) const
+		{
+			if (idx >= _info().num_attrs)
+				throw Nonexistent_attribute();
+
+			return _index->_attribute(_info().first_attr + idx);
+		}
+
+		/**
+		 * Return attribute of specified type
+		 *
+		 * \throw Nonexistent_attribute
+		 */
+		Xml_attribute attribute(char const *type) const {
+			return _index->_attribute(_index->_attr(_id, type)); }
+
+		template <typename T>
+		T attribute_value(char const *type, T default_value) const
+		{
+			T result = default_value;
+			try { attribute(type).value(&result); } catch (...) { }
+			return result;
+		}
+
+		bool has_attribute(char const *type) const
+		{
+			try { _index->_attr(_id, type); return true; }
+			catch (Nonexistent_attribute) { return false; }
+		}
+};
+
+
+Genode::Xml_index::Node Genode::Xml_index::root() const
+{
+	if (!_num_nodes)
+		throw Nonexistent_sub_node();
+
+	return Node(*this, 0);
+}
+
+
+Genode::Xml_index::Node Genode::Xml_index::node(Xml_node const &node) const
+{
+	/* nodes are recorded in document order, search by address */
+	unsigned lo = 0, hi = _num_nodes;
+	while (lo < hi) {
+		unsigned const mid = lo + (hi - lo)/2;
+		if (_nodes[mid].addr < node.addr())
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < _num_nodes && _nodes[lo].addr == node.addr())
+		return Node(*this, lo);
+
+	throw Nonexistent_sub_node();
+}
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
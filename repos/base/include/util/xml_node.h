@@ -20,6 +20,7 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 }
 
 
@@ -49,6 +50,7 @@ class Genode::Xml_attribute
 		Token _value;
 
 		friend class Xml_node;
+		friend class Xml_index;
 
 		/*
 		 * Even though 'Tag' is part of 'Xml_node', the friendship
@@ -195,6 +197,8 @@ class Genode::Xml_node
 		 */
 		class Tag;
 
+		friend class Xml_index;
+
 	public:
 
 		/*********************
@@ -565,6 +569,26 @@ class Genode::Xml_node
 			return Xml_node(at, _max_len - (at - addr()));
 		}
 
+		/**
+		 * Constructor used by 'Xml_index' for nodes with known structure
+		 *
+		 * \param end            first character of the end tag, or
+		 *                       nullptr for an empty-element tag
+		 * \param num_sub_nodes  number of immediate sub nodes
+		 *
+		 * In contrast to the public constructor, the node content is not
+		 * scanned for the end tag.
+		 */
+		Xml_node(char const *addr, size_t max_len, char const *end,
+		         int num_sub_nodes)
+		:
+			_addr(addr),
+			_max_len(max_len),
+			_num_sub_nodes(num_sub_nodes),
+			_start_tag(skip_non_tag_characters(Token(addr, max_len))),
+			_end_tag(end ? Tag(Token(end, max_len - (end - addr))) : _start_tag)
+		{ }
+
 	public:
 
 		/**
@@ -0,0 +1,60 @@
+/*
+ * \brief  Bounded backoff for busy waiting
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__SPIN_BACKOFF_H_
+#define _INCLUDE__BASE__INTERNAL__SPIN_BACKOFF_H_
+
+/* Genode includes */
+#include <cpu/atomic.h>
+
+namespace Genode { class Spin_backoff; }
+
+
+/**
+ * Bounded exponential backoff for busy waiting
+ *
+ * The holder of a contended lock usually executes on another CPU and
+ * releases the lock within a few hundred cycles. Yielding the CPU right away
+ * would add the costs of a kernel entry or, on Linux, a sleep of at least
+ * one microsecond. Hence, the waiting thread spins using the CPU's pause
+ * hint with an exponentially growing delay before falling back to yielding.
+ */
+class Genode::Spin_backoff
+{
+	private:
+
+		enum { MAX_DELAY = 64 };
+
+		unsigned _delay = 1;
+
+	public:
+
+		/**
+		 * Spin for the current delay
+		 *
+		 * \return false if the spin budget is exhausted
+		 */
+		bool spin()
+		{
+			if (_delay > MAX_DELAY)
+				return false;
+
+			for (unsigned i = 0; i < _delay; i++)
+				Genode::cpu_relax();
+
+			_delay <<= 1;
+			return true;
+		}
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__SPIN_BACKOFF_H_ */
@@ -22,6 +22,7 @@
 /* base-internal includes */
 #include <base/internal/native_thread.h>
 #include <base/internal/lock_helper.h>
+#include <base/internal/spin_backoff.h>
 
 /*
  * Spinlock functions used for protecting the critical sections within the
@@ -34,12 +35,22 @@ enum State { SPINLOCK_LOCKED, SPINLOCK_UNLOCKED };
 
 static inline void spinlock_lock(volatile int *lock_variable)
 {
+	Genode::Spin_backoff backoff;
+
 	while (!Genode::cmpxchg(lock_variable, SPINLOCK_UNLOCKED, SPINLOCK_LOCKED)) {
-		/*
-		 * Yield our remaining time slice to help the spinlock holder to pass
-		 * the critical section.
-		 */
-		thread_yield();
+
+		/* wait for the release without hammering the cache line */
+		while (*lock_variable == SPINLOCK_LOCKED) {
+
+			if (backoff.spin())
+				continue;
+
+			/*
+			 * Yield our remaining time slice to help the spinlock holder to
+			 * pass the critical section.
+			 */
+			thread_yield();
+		}
 	}
 }
 
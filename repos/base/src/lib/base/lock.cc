@@ -17,6 +17,7 @@
 
 /* base-internal includes */
 #include <base/internal/spin_lock.h>
+#include <base/internal/spin_backoff.h>
 
 using namespace Genode;
 
@@ -64,6 +65,16 @@ void Cancelable_lock::lock()
 {
 	Applicant myself(Thread::myself());
 
+	/*
+	 * If the lock is held but nobody waits for it, the holder is likely
+	 * executing a short critical section on another CPU. Spin for a bounded
+	 * time before resorting to the expensive blocking and wake-up. Once
+	 * applicants are queued, the lock is handed over in FIFO order, which
+	 * renders spinning futile.
+	 */
+	for (Spin_backoff backoff;
+	     _state == LOCKED && _last_applicant == &_owner && backoff.spin(); );
+
 	spinlock_lock(&_spinlock_state);
 
 	if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_name;
 	struct Dynamic;
 }
 
@@ -53,6 +55,106 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * In contrast to the SysV hash table, the table starts with a bloom filter
+ * that rejects most lookups of symbols not defined by the object without
+ * touching the hash chains. The chains are sorted by bucket and hold the
+ * hash values of the symbols, which avoids most string comparisons. The
+ * symbols below 'symoffset' are not covered by the table.
+ */
+struct Linker::Gnu_hash_table
+{
+	enum { BLOOM_BITS = sizeof(Elf::Addr)*8 };
+
+	Elf::Hashelt const *_words() const { return (Elf::Hashelt const *)this; }
+
+	unsigned long nbuckets()   const { return _words()[0]; }
+	unsigned long symoffset()  const { return _words()[1]; }
+	unsigned long bloom_size() const { return _words()[2]; }
+	unsigned long bloom_shift() const { return _words()[3]; }
+
+	Elf::Addr const *bloom() const { return (Elf::Addr const *)(_words() + 4); }
+
+	Elf::Hashelt const *buckets() const {
+		return (Elf::Hashelt const *)(bloom() + bloom_size()); }
+
+	/**
+	 * Return hash chain, indexed by symbol index
+	 */
+	Elf::Hashelt const *chains() const { return buckets() + nbuckets() - symoffset(); }
+
+	/**
+	 * Return true if the object may define a symbol with the given hash
+	 */
+	bool may_contain(Elf::Hashelt hash) const
+	{
+		Elf::Addr const word = bloom()[(hash / BLOOM_BITS) & (bloom_size() - 1)];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BLOOM_BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift()) % BLOOM_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols in the dynamic symbol table
+	 *
+	 * The table has no explicit size. It ends with the last entry of the
+	 * longest-indexed chain, which carries the lowest bit set.
+	 */
+	unsigned long nsymbols() const SELF_RELOC
+	{
+		unsigned long max_index = 0;
+		for (unsigned long i = 0; i < nbuckets(); i++)
+			if (buckets()[i] > max_index)
+				max_index = buckets()[i];
+
+		if (max_index < symoffset())
+			return symoffset();
+
+		while (!(chains()[max_index] & 1))
+			max_index++;
+
+		return max_index + 1;
+	}
+
+	/**
+	 * GNU hash function (Bernstein hash)
+	 */
+	static Elf::Hashelt hash(char const *name)
+	{
+		unsigned char const *p = (unsigned char const *)name;
+		Elf::Hashelt         h = 5381;
+
+		while (*p)
+			h = (h << 5) + h + *p++;
+
+		return h;
+	}
+};
+
+
+/**
+ * Symbol name along with its hash values
+ *
+ * The hash values are computed once per lookup, not once per object.
+ */
+struct Linker::Symbol_name
+{
+	char const * const string;
+
+	unsigned long const sysv_hash;
+	Elf::Hashelt  const gnu_hash;
+
+	Symbol_name(char const *string)
+	:
+		string(string), sysv_hash(Hash_table::hash(string)),
+		gnu_hash(Gnu_hash_table::hash(string))
+	{ }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -88,6 +190,8 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -152,6 +256,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -167,6 +272,77 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+			else if (_gnu_hash)
+				_num_symbols = _gnu_hash->nsymbols();
+		}
+
+		bool _matches(Elf::Sym const *sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym->type() > STT_FUNC)
+				return false;
+
+			if (sym->st_value == 0)
+				return false;
+
+			char const *sym_name = symbol_name(*sym);
+
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_sysv(Symbol_name const &name) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[name.sysv_hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				Elf::Sym const *sym = symbol(sym_index);
+
+				if (_matches(sym, name.string))
+					return sym;
+			}
+
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_gnu(Symbol_name const &name) const
+		{
+			Gnu_hash_table const *h = _gnu_hash;
+
+			if (!h->nbuckets() || !h->may_contain(name.gnu_hash))
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[name.gnu_hash % h->nbuckets()];
+			if (sym_index < h->symoffset())
+				return nullptr;
+
+			/* traverse hash chain, the last entry has the lowest bit set */
+			for (; sym_index < _num_symbols; sym_index++) {
+
+				Elf::Hashelt const chain_hash = h->chains()[sym_index];
+
+				if ((chain_hash | 1) == (name.gnu_hash | 1)
+				 && _matches(symbol(sym_index), name.string))
+					return symbol(sym_index);
+
+				if (chain_hash & 1)
+					break;
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -210,12 +386,31 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
 		}
 
+		/**
+		 * Return index of symbol within the symbol table
+		 */
+		unsigned symbol_index(Elf::Sym const &sym) const { return &sym - _symtab; }
+
+		unsigned long num_symbols() const { return _num_symbols; }
+
+		/**
+		 * Call 'fn' for each memory range that determines symbol resolution
+		 *
+		 * The ranges are the symbol table and the string table.
+		 */
+		template <typename FN>
+		void for_each_symbol_range(FN const &fn) const
+		{
+			fn((char const *)_symtab, _num_symbols*sizeof(Elf::Sym));
+			fn((char const *)_strtab, _strtab_size);
+		}
+
 		char const *symbol_name(Elf::Sym const &sym) const
 		{
 			return _strtab + sym.st_name;
@@ -228,46 +423,27 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
-		 * the beginning of the file
+		 * Use DT_HASH or DT_GNU_HASH table address for linker, assuming that it
+		 * will always be at the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred if present.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(Symbol_name const &name) const
 		{
-			Hash_table *h = _hash_table;
+			if (_gnu_hash)
+				return _lookup_gnu(name);
 
-			if (!h->buckets())
-				return nullptr;
-
-			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_sysv(name);
 
 			return nullptr;
 		}
@@ -279,7 +455,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
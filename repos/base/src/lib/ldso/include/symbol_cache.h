@@ -0,0 +1,370 @@
+/*
+ * \brief  Persistent cache of symbol resolutions
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_CACHE_H_
+#define _INCLUDE__SYMBOL_CACHE_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <report_session/connection.h>
+
+/* local includes */
+#include <linker.h>
+#include <dynamic.h>
+
+namespace Linker { class Symbol_cache; }
+
+
+/**
+ * Symbol resolutions of the binary and its dependencies
+ *
+ * On the first start of a component, the results of the symbol lookups
+ * performed by the relocations are recorded and reported as "ld.cache".
+ * If the report is provided as ROM module "ld.cache" on the next start,
+ * lookups are answered from the cache instead of probing the hash tables
+ * of all objects.
+ *
+ * Symbol resolution solely depends on the link order and the symbol and
+ * string tables of the objects. The cache is keyed by a fingerprint of
+ * these. Hence, a cache is ignored as soon as any object is replaced by a
+ * version that might resolve differently.
+ *
+ * The reported cache is the hash table used for lookups. So a valid cache
+ * is used in place without parsing.
+ */
+class Linker::Symbol_cache
+{
+	private:
+
+		enum {
+			MAGIC        = 0x6c64632e,
+			MAX_OBJECTS  = 256,
+			MIN_CAPACITY = 1024,
+			INVALID      = 0xffff,
+		};
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t num_objects;
+			uint64_t fingerprint;
+			uint32_t capacity;  /* number of entries, power of two */
+			uint32_t used;
+		};
+
+		/**
+		 * Resolution of symbol 'ref_sym' of object 'ref_obj' to symbol
+		 * 'def_sym' of object 'def_obj'
+		 *
+		 * Objects are referred to by their position in link order.
+		 */
+		struct Entry
+		{
+			uint32_t ref_sym;
+			uint16_t ref_obj;  /* 'INVALID' if entry is unused */
+			uint16_t def_obj;
+			uint32_t def_sym;
+		};
+
+		Env       &_env;
+		Allocator &_alloc;
+
+		Dependency const *_deps[MAX_OBJECTS];
+		unsigned          _num_deps = 0;
+		unsigned          _last_ref = 0;  /* index of last referencing object */
+
+		uint64_t _fingerprint = 0;
+
+		Constructible<Attached_rom_dataspace> _rom;
+
+		/*
+		 * Lookup table, located either in the ROM module or, while
+		 * recording, at the heap
+		 */
+		Entry const *_table    = nullptr;
+		unsigned     _capacity = 0;
+
+		Entry   *_recorded = nullptr;
+		unsigned _used     = 0;
+
+		bool _reported = false;
+
+		static unsigned _slot(unsigned ref_obj, unsigned ref_sym, unsigned capacity)
+		{
+			return ((ref_sym*2654435761U) ^ (ref_obj*40503U)) & (capacity - 1);
+		}
+
+		static uint64_t _hash(uint64_t h, char const *data, size_t size)
+		{
+			/* FNV-1a */
+			for (size_t i = 0; i < size; i++)
+				h = (h ^ (unsigned char)data[i])*0x100000001b3ULL;
+
+			return h;
+		}
+
+		uint64_t _calc_fingerprint() const
+		{
+			uint64_t h = 0xcbf29ce484222325ULL;
+
+			for (unsigned i = 0; i < _num_deps; i++) {
+				Object const &obj = _deps[i]->obj();
+
+				h = _hash(h, obj.name(), strlen(obj.name()) + 1);
+
+				obj.dynamic().for_each_symbol_range([&] (char const *data, size_t size) {
+					h = _hash(h, data, size); });
+			}
+			return h;
+		}
+
+		/**
+		 * Return index of 'dep' in link order, or 'INVALID'
+		 */
+		unsigned _index(Dependency const &dep)
+		{
+			if (_last_ref < _num_deps && _deps[_last_ref] == &dep)
+				return _last_ref;
+
+			for (unsigned i = 0; i < _num_deps; i++)
+				if (_deps[i] == &dep)
+					return _last_ref = i;
+
+			return INVALID;
+		}
+
+		/**
+		 * Return index of object located at 'reloc_base', or 'INVALID'
+		 */
+		unsigned _index(Elf::Addr reloc_base) const
+		{
+			for (unsigned i = 0; i < _num_deps; i++)
+				if (_deps[i]->obj().reloc_base() == reloc_base)
+					return i;
+
+			return INVALID;
+		}
+
+		bool _use_rom()
+		{
+			try { _rom.construct(_env, "ld.cache"); }
+			catch (Rom_connection::Rom_connection_failed) { return false; }
+
+			if (_rom->size() < sizeof(Header))
+				return false;
+
+			Header const &header = *_rom->local_addr<Header const>();
+
+			size_t const capacity = header.capacity;
+
+			if (header.magic       != MAGIC
+			 || header.num_objects != _num_deps
+			 || header.fingerprint != _fingerprint
+			 || capacity < MIN_CAPACITY || (capacity & (capacity - 1))
+			 || _rom->size() < sizeof(Header) + capacity*sizeof(Entry))
+				return false;
+
+			_table    = (Entry const *)(&header + 1);
+			_capacity = capacity;
+			return true;
+		}
+
+		Entry *_alloc_table(unsigned capacity)
+		{
+			Entry *table = nullptr;
+			if (!_alloc.alloc(capacity*sizeof(Entry), (void **)&table))
+				throw Allocator::Out_of_memory();
+
+			for (unsigned i = 0; i < capacity; i++)
+				table[i].ref_obj = INVALID;
+
+			return table;
+		}
+
+		void _insert(Entry *table, unsigned capacity, Entry const &entry)
+		{
+			unsigned i = _slot(entry.ref_obj, entry.ref_sym, capacity);
+			while (table[i].ref_obj != INVALID)
+				i = (i + 1) & (capacity - 1);
+
+			table[i] = entry;
+		}
+
+		void _grow()
+		{
+			unsigned const capacity = 2*_capacity;
+			Entry   *const table    = _alloc_table(capacity);
+
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_recorded[i].ref_obj != INVALID)
+					_insert(table, capacity, _recorded[i]);
+
+			_alloc.free(_recorded, _capacity*sizeof(Entry));
+
+			_recorded = table;
+			_table    = table;
+			_capacity = capacity;
+		}
+
+	public:
+
+		Symbol_cache(Env &env, Allocator &alloc) : _env(env), _alloc(alloc) { }
+
+		~Symbol_cache()
+		{
+			if (_recorded)
+				_alloc.free(_recorded, _capacity*sizeof(Entry));
+		}
+
+		/**
+		 * Bind cache to the dependencies of the binary
+		 *
+		 * Must be called after all dependencies are loaded and before any
+		 * relocation takes place.
+		 */
+		void bind(Dependency const &first)
+		{
+			for (Dependency const *d = &first; d; d = d->next()) {
+				if (_num_deps == MAX_OBJECTS) {
+					warning("LD: too many objects, symbol cache disabled");
+					_num_deps = 0;
+					return;
+				}
+				_deps[_num_deps++] = d;
+			}
+
+			_fingerprint = _calc_fingerprint();
+
+			if (_use_rom()) {
+				if (verbose)
+					log("LD: using symbol cache with ", _capacity, " entries");
+				return;
+			}
+
+			_rom.destruct();
+
+			_capacity = MIN_CAPACITY;
+			_recorded = _alloc_table(_capacity);
+			_table    = _recorded;
+
+			if (verbose)
+				log("LD: recording symbol cache");
+		}
+
+		/**
+		 * Look up cached resolution of symbol 'sym_index' referenced by 'dep'
+		 *
+		 * \return  defined symbol, or nullptr if not cached
+		 */
+		Elf::Sym const *lookup(Dependency const &dep, unsigned sym_index,
+		                       Elf::Addr *base)
+		{
+			if (!_table)
+				return nullptr;
+
+			unsigned const ref_obj = _index(dep);
+			if (ref_obj == INVALID)
+				return nullptr;
+
+			unsigned i = _slot(ref_obj, sym_index, _capacity);
+			for (unsigned n = 0; n < _capacity; n++, i = (i + 1) & (_capacity - 1)) {
+
+				Entry const &e = _table[i];
+
+				if (e.ref_obj == INVALID)
+					return nullptr;
+
+				if (e.ref_obj != ref_obj || e.ref_sym != sym_index)
+					continue;
+
+				if (e.def_obj >= _num_deps)
+					return nullptr;
+
+				Object const &obj = _deps[e.def_obj]->obj();
+				Elf::Sym const *sym = obj.dynamic().symbol(e.def_sym);
+				if (sym)
+					*base = obj.reloc_base();
+
+				return sym;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Record resolution of symbol 'sym_index' referenced by 'dep'
+		 *
+		 * \param sym   defined symbol
+		 * \param base  relocation base of the defining object
+		 */
+		void record(Dependency const &dep, unsigned sym_index,
+		            Elf::Sym const &sym, Elf::Addr base)
+		{
+			if (!_recorded)
+				return;
+
+			unsigned const ref_obj = _index(dep);
+			unsigned const def_obj = _index(base);
+			if (ref_obj == INVALID || def_obj == INVALID)
+				return;
+
+			if (4*(_used + 1) > 3*_capacity)
+				_grow();
+
+			Entry const entry {
+				sym_index, (uint16_t)ref_obj, (uint16_t)def_obj,
+				_deps[def_obj]->obj().dynamic().symbol_index(sym) };
+
+			_insert(_recorded, _capacity, entry);
+			_used++;
+		}
+
+		/**
+		 * Report recorded cache
+		 *
+		 * Resolutions recorded after the report, e.g., by lazy binding, are
+		 * used but not reported.
+		 */
+		void report()
+		{
+			if (!_recorded || _reported)
+				return;
+
+			_reported = true;
+
+			size_t const size = sizeof(Header) + _capacity*sizeof(Entry);
+
+			try {
+				Report::Connection report(_env, "ld.cache", size);
+				Attached_dataspace ds(_env.rm(), report.dataspace());
+
+				Header &header = *ds.local_addr<Header>();
+				header.magic       = MAGIC;
+				header.num_objects = _num_deps;
+				header.fingerprint = _fingerprint;
+				header.capacity    = _capacity;
+				header.used        = _used;
+
+				memcpy(&header + 1, _recorded, _capacity*sizeof(Entry));
+
+				report.submit(size);
+			}
+			catch (...) {
+				warning("LD: could not report symbol cache"); }
+
+			if (verbose)
+				log("LD: reported symbol cache with ", _used, " entries");
+		}
+};
+
+#endif /* _INCLUDE__SYMBOL_CACHE_H_ */
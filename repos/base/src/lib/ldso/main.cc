@@ -28,6 +28,7 @@
 #include <dynamic.h>
 #include <init.h>
 #include <region_map.h>
+#include <symbol_cache.h>
 
 using namespace Linker;
 
@@ -42,6 +43,7 @@ namespace Linker {
 };
 
 static    Binary *binary_ptr = nullptr;
+static    Symbol_cache *symbol_cache_ptr = nullptr;
 bool      Linker::verbose  = false;
 Link_map *Link_map::first;
 
@@ -171,9 +173,9 @@ class Linker::Elf_object : public Object, public Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(Symbol_name const &name) const
 		{
-			return _dyn.lookup_symbol(name, hash);
+			return _dyn.lookup_symbol(name);
 		}
 
 		/**
@@ -361,6 +363,9 @@ struct Linker::Binary : Root_object, Elf_object
 		/* load dependencies */
 		binary->load_needed(env, md_alloc, deps(), DONT_KEEP);
 
+		if (symbol_cache_ptr)
+			symbol_cache_ptr->bind(*first_dep());
+
 		/* relocate and call constructors */
 		Init::list()->initialize(bind, STAGE_BINARY);
 	}
@@ -515,6 +520,17 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 		return symbol;
 	}
 
+	/* the cache covers the default lookups of the binary's relocations */
+	if (symbol_cache_ptr && !undef && !other) {
+
+		if (Elf::Sym const *cached = symbol_cache_ptr->lookup(dep, sym_index, base))
+			return cached;
+
+		Elf::Sym const *sym = lookup_symbol(elf.symbol_name(*symbol), dep, base);
+		symbol_cache_ptr->record(dep, sym_index, *sym, *base);
+		return sym;
+	}
+
 	return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
 }
 
@@ -523,7 +539,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_name const hashed_name(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -536,7 +552,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 
 		Elf_object const &elf = static_cast<Elf_object const &>(curr->obj());
 
-		if ((symbol = elf.lookup_symbol(name, hash)) && (symbol->st_value || undef)) {
+		if ((symbol = elf.lookup_symbol(hashed_name)) && (symbol->st_value || undef)) {
 
 			if (dep.root() && verbose_lookup)
 				log("LD: lookup ", name, " obj_src ", elf.name(),
@@ -610,6 +626,7 @@ class Linker::Config
 
 		Bind _bind    = BIND_LAZY;
 		bool _verbose = false;
+		bool _cache   = false;
 
 	public:
 
@@ -622,11 +639,13 @@ class Linker::Config
 					_bind = BIND_NOW;
 
 				_verbose = config.xml().attribute_value("ld_verbose", false);
+				_cache   = config.xml().attribute_value("ld_cache", false);
 			} catch (Rom_connection::Rom_connection_failed) { }
 		}
 
 		Bind bind()    const { return _bind; }
 		bool verbose() const { return _verbose; }
+		bool cache()   const { return _cache; }
 };
 
 
@@ -657,6 +676,9 @@ void Component::construct(Genode::Env &env)
 	static Config config(env);
 	verbose = config.verbose();
 
+	if (config.cache())
+		symbol_cache_ptr = unmanaged_singleton<Symbol_cache>(env, *heap());
+
 	/* load binary and all dependencies */
 	try {
 		binary_ptr = unmanaged_singleton<Binary>(env, *heap(), config.bind());
@@ -665,6 +687,9 @@ void Component::construct(Genode::Env &env)
 		throw;
 	}
 
+	if (symbol_cache_ptr)
+		symbol_cache_ptr->report();
+
 	/* print loaded object information */
 	try {
 		if (verbose) {
@@ -0,0 +1,109 @@
+/*
+ * \brief  Latency samples of a benchmark with percentile report
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__TEST__INCLUDE__LATENCY_SAMPLES_H_
+#define _SRC__TEST__INCLUDE__LATENCY_SAMPLES_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/log.h>
+#include <trace/timestamp.h>
+
+namespace Test { class Latency_samples; }
+
+
+class Test::Latency_samples
+{
+	public:
+
+		typedef Genode::Trace::Timestamp Timestamp;
+
+	private:
+
+		Genode::Allocator &_alloc;
+		unsigned    const  _num;
+		Timestamp  *const  _samples;
+
+		/**
+		 * Heap sort, which needs no additional memory
+		 */
+		void _sort()
+		{
+			Timestamp * const a = _samples;
+
+			auto sift_down = [&] (unsigned i, unsigned n) {
+				for (unsigned child; (child = 2*i + 1) < n; i = child) {
+					if (child + 1 < n && a[child + 1] > a[child])
+						child++;
+					if (a[i] >= a[child])
+						return;
+					Timestamp const tmp = a[i]; a[i] = a[child]; a[child] = tmp;
+				}
+			};
+
+			for (unsigned i = _num/2; i-- > 0; )
+				sift_down(i, _num);
+
+			for (unsigned n = _num; n-- > 1; ) {
+				Timestamp const tmp = a[0]; a[0] = a[n]; a[n] = tmp;
+				sift_down(0, n);
+			}
+		}
+
+		/**
+		 * Return latency of the given percentile of the sorted samples
+		 *
+		 * \param per_mille  percentile in 1/1000
+		 */
+		unsigned long _latency_ns(unsigned per_mille, unsigned long ticks_per_ms) const
+		{
+			unsigned const index = (unsigned)(((unsigned long long)_num - 1)
+			                                  * per_mille / 1000);
+			return _samples[index]*1000*1000 / ticks_per_ms;
+		}
+
+	public:
+
+		Latency_samples(Genode::Allocator &alloc, unsigned num)
+		:
+			_alloc(alloc), _num(num),
+			_samples((Timestamp *)alloc.alloc(num*sizeof(Timestamp)))
+		{ }
+
+		~Latency_samples() { _alloc.free(_samples, _num*sizeof(Timestamp)); }
+
+		unsigned num() const { return _num; }
+
+		Timestamp &operator [] (unsigned i) { return _samples[i]; }
+
+		/**
+		 * Log the latency percentiles of the samples
+		 *
+		 * \param ticks_per_ms  frequency of the timestamp counter
+		 *
+		 * The samples are sorted in place.
+		 */
+		void log_percentiles(char const *name, unsigned long ticks_per_ms)
+		{
+			_sort();
+
+			Genode::log(name, ": latency [ns]"
+			            " p50=",  _latency_ns(500,  ticks_per_ms),
+			            " p90=",  _latency_ns(900,  ticks_per_ms),
+			            " p99=",  _latency_ns(990,  ticks_per_ms),
+			            " p999=", _latency_ns(999,  ticks_per_ms),
+			            " max=",  _latency_ns(1000, ticks_per_ms));
+		}
+};
+
+#endif /* _SRC__TEST__INCLUDE__LATENCY_SAMPLES_H_ */
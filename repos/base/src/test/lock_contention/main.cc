@@ -0,0 +1,255 @@
+/*
+ * \brief  Contended lock benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Threads spread over all available CPUs repeatedly enter a short critical
+ * section protected by the lock under test. The benchmark reports the
+ * latency of the lock acquisition and checks that the lock semantics hold.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/lock.h>
+#include <base/rw_lock.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+/* test includes */
+#include <latency_samples.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	typedef Trace::Timestamp Timestamp;
+	typedef Latency_samples  Samples;
+
+	struct Lock_test;
+	struct Rw_lock_test;
+	struct Worker;
+	struct Main;
+}
+
+
+/**
+ * Mutual exclusion via 'Genode::Lock'
+ */
+struct Test::Lock_test
+{
+	Lock          lock;
+	unsigned long counter = 0;
+	unsigned      inside  = 0;
+	unsigned      errors  = 0;
+
+	Timestamp enter(unsigned)
+	{
+		Timestamp const start = Trace::timestamp();
+		lock.lock();
+		Timestamp const latency = Trace::timestamp() - start;
+
+		if (inside++)
+			errors++;
+
+		counter++;
+		inside--;
+
+		lock.unlock();
+		return latency;
+	}
+};
+
+
+/**
+ * Readers and writers of a 'Genode::Rw_lock', one in 'WRITE_RATIO' is a writer
+ */
+struct Test::Rw_lock_test
+{
+	enum { WRITE_RATIO = 8 };
+
+	Rw_lock       lock;
+	unsigned long counter = 0;
+	int volatile  readers = 0;
+	int volatile  writers = 0;
+	unsigned      errors  = 0;
+
+	Rw_lock_test(Rw_lock::Policy policy) : lock(policy) { }
+
+	static void _add(int volatile &value, int amount)
+	{
+		int old;
+		do { old = value; } while (!cmpxchg(&value, old, old + amount));
+	}
+
+	Timestamp enter(unsigned i)
+	{
+		Timestamp const start = Trace::timestamp();
+
+		if (i % WRITE_RATIO == 0) {
+			lock.lock_write();
+			Timestamp const latency = Trace::timestamp() - start;
+
+			_add(writers, 1);
+			if (writers != 1 || readers)
+				errors++;
+			counter++;
+			_add(writers, -1);
+
+			lock.unlock_write();
+			return latency;
+		}
+
+		lock.lock_read();
+		Timestamp const latency = Trace::timestamp() - start;
+
+		_add(readers, 1);
+		if (writers)
+			errors++;
+		_add(readers, -1);
+
+		lock.unlock_read();
+		return latency;
+	}
+};
+
+
+struct Test::Worker : Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Samples  &_samples;
+	unsigned  _first;
+	unsigned  _num;
+
+	Timestamp (*_enter)(void *, unsigned);
+	void      *_test;
+
+	Worker(Env &env, Affinity::Location location, Samples &samples,
+	       unsigned first, unsigned num,
+	       Timestamp (*enter)(void *, unsigned), void *test)
+	:
+		Thread(env, "worker", STACK_SIZE, location, Weight(), env.cpu()),
+		_samples(samples), _first(first), _num(num), _enter(enter), _test(test)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _num; i++)
+			_samples[_first + i] = _enter(_test, _first + i);
+	}
+};
+
+
+struct Test::Main
+{
+	enum { MAX_WORKERS = 8, ACQUISITIONS_PER_WORKER = 50000 };
+
+	Env &env;
+
+	Heap heap { env.ram(), env.rm() };
+
+	Timer::Connection timer { env };
+
+	Affinity::Space cpus = env.cpu().affinity_space();
+
+	unsigned const num_workers = max(min(cpus.total(), (unsigned)MAX_WORKERS), 2U);
+
+	bool failed = false;
+
+	/**
+	 * Determine timestamp frequency
+	 */
+	unsigned long ticks_per_ms()
+	{
+		Timestamp const start = Trace::timestamp();
+		timer.msleep(100);
+		return (Trace::timestamp() - start)/100;
+	}
+
+	unsigned long const ticks = ticks_per_ms();
+
+	template <typename TEST>
+	void run(char const *name, TEST &test)
+	{
+		unsigned const num = num_workers*ACQUISITIONS_PER_WORKER;
+
+		Samples samples(heap, num);
+
+		auto enter = [] (void *test, unsigned i) {
+			return ((TEST *)test)->enter(i); };
+
+		Worker *workers[MAX_WORKERS];
+		for (unsigned i = 0; i < num_workers; i++)
+			workers[i] = new (heap)
+				Worker(env, cpus.location_of_index(i % cpus.total()), samples,
+				       i*ACQUISITIONS_PER_WORKER, ACQUISITIONS_PER_WORKER,
+				       enter, &test);
+
+		unsigned long const start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_workers; i++)
+			workers[i]->start();
+
+		for (unsigned i = 0; i < num_workers; i++) {
+			workers[i]->join();
+			destroy(heap, workers[i]);
+		}
+
+		unsigned long const duration_ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+		log(name, ": ", num, " acquisitions by ", num_workers, " threads in ",
+		    duration_ms, " ms");
+
+		samples.log_percentiles(name, ticks);
+
+		if (test.errors) {
+			error(name, ": lock semantics violated ", test.errors, " times");
+			failed = true;
+		}
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- lock contention benchmark ---");
+		log("detected ", cpus.width(), "x", cpus.height(), " CPUs");
+
+		{
+			Lock_test test;
+			run("lock", test);
+			if (test.counter != num_workers*ACQUISITIONS_PER_WORKER) {
+				error("lock: lost updates");
+				failed = true;
+			}
+		}
+
+		{
+			Rw_lock_test test(Rw_lock::PREFER_READERS);
+			run("rw_lock (prefer readers)", test);
+		}
+
+		{
+			Rw_lock_test test(Rw_lock::PREFER_WRITERS);
+			run("rw_lock (prefer writers)", test);
+		}
+
+		if (failed) {
+			env.parent().exit(-1);
+			return;
+		}
+
+		log("--- lock contention benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,163 @@
+/*
+ * \brief  RPC ping-pong benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A client repeatedly calls an entrypoint of the same component and reports
+ * the achieved calls per second along with latency percentiles. The
+ * benchmark covers plain calls and calls that transfer a capability.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+/* test includes */
+#include <latency_samples.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Benchmark;
+	struct Main;
+}
+
+
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "PINGPONG"; }
+
+	GENODE_RPC(Rpc_ping, unsigned long, ping, unsigned long);
+	GENODE_RPC(Rpc_ping_cap, unsigned long, ping_cap, Native_capability);
+	GENODE_RPC_INTERFACE(Rpc_ping, Rpc_ping_cap);
+};
+
+
+struct Test::Client : Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	unsigned long ping(unsigned long value) {
+		return call<Rpc_ping>(value); }
+
+	unsigned long ping_cap(Native_capability cap) {
+		return call<Rpc_ping_cap>(cap); }
+};
+
+
+struct Test::Component : Rpc_object<Session, Component>
+{
+	unsigned long ping(unsigned long value) { return value + 1; }
+
+	unsigned long ping_cap(Native_capability cap) { return cap.valid(); }
+};
+
+
+/**
+ * Measurement of one kind of call
+ */
+struct Test::Benchmark
+{
+	Latency_samples _samples;
+
+	Benchmark(Allocator &alloc, unsigned num_calls) : _samples(alloc, num_calls) { }
+
+	template <typename FN>
+	void run(char const *name, Timer::Connection &timer,
+	         unsigned long ticks_per_ms, FN const &fn)
+	{
+		unsigned const num_calls = _samples.num();
+
+		/* warm up, e.g., establish communication channels */
+		for (unsigned i = 0; i < 1000; i++)
+			fn(i);
+
+		unsigned long const start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_calls; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			fn(i);
+			_samples[i] = Trace::timestamp() - start;
+		}
+
+		unsigned long const duration_ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+		log(name, ": ", num_calls, " calls in ", duration_ms, " ms, ",
+		    num_calls*1000UL/duration_ms, " calls/s");
+
+		_samples.log_percentiles(name, ticks_per_ms);
+	}
+};
+
+
+struct Test::Main
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long), NUM_CALLS = 100000 };
+
+	Env &env;
+
+	Heap heap { env.ram(), env.rm() };
+
+	Timer::Connection timer { env };
+
+	Rpc_entrypoint ep { &env.pd(), STACK_SIZE, "pingpong_ep" };
+
+	Component component;
+
+	Capability<Session> cap { ep.manage(&component) };
+
+	Client client { cap };
+
+	/**
+	 * Determine timestamp frequency
+	 */
+	unsigned long ticks_per_ms()
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		timer.msleep(100);
+		return (Trace::timestamp() - start)/100;
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- RPC ping-pong benchmark ---");
+
+		unsigned long const ticks = ticks_per_ms();
+
+		{
+			Benchmark benchmark(heap, NUM_CALLS);
+			benchmark.run("ping", timer, ticks, [&] (unsigned i) {
+				if (client.ping(i) != i + 1)
+					error("unexpected result of ping"); });
+		}
+
+		{
+			Benchmark benchmark(heap, NUM_CALLS/10);
+			benchmark.run("ping with capability", timer, ticks, [&] (unsigned) {
+				client.ping_cap(cap); });
+		}
+
+		ep.dissolve(&component);
+
+		log("--- RPC ping-pong benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
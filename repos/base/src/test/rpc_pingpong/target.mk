@@ -0,0 +1,4 @@
+TARGET = test-rpc_pingpong
+SRC_CC = main.cc
+LIBS   = base
+INC_DIR += $(REP_DIR)/src/test/include
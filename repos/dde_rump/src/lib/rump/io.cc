@@ -14,6 +14,7 @@
 #include "sched.h"
 #include <base/allocator_avl.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <block_session/connection.h>
 #include <rump/env.h>
 #include <rump_fs/fs.h>
@@ -25,23 +26,183 @@ enum  { GENODE_FD = 64 };
 
 /**
  * Block session connection
+ *
+ * Block requests are processed asynchronously. 'submit' returns as soon as
+ * the packet is queued at the block session. The acknowledgements are
+ * collected by a dedicated completion thread, which calls the 'biodone'
+ * callback of the respective request. Hence, the rump kernel can keep
+ * multiple requests in flight, e.g., for read ahead or the write back of
+ * the buffer cache.
  */
 class Backend
 {
 	private:
 
+		enum {
+			MAX_REQUESTS = Block::Session::TX_QUEUE_SIZE - 1,
+			TX_BUF_SIZE  = 4*1024*1024,
+		};
+
+		struct Request
+		{
+			Block::Packet_descriptor packet;
+			void                    *data    = nullptr;
+			size_t                   length  = 0;
+			rump_biodone_fn          biodone = nullptr;
+			void                    *donearg = nullptr;
+			int                      op      = 0;
+			bool                     used    = false;
+		};
+
 		Genode::Allocator_avl              _alloc { &Rump::env().heap() };
-		Block::Connection                  _session { Rump::env().env(), &_alloc };
+		Block::Connection                  _session { Rump::env().env(), &_alloc, TX_BUF_SIZE };
 		Genode::size_t                     _blk_size; /* block size of the device   */
 		Block::sector_t                    _blk_cnt;  /* number of blocks of device */
 		Block::Session::Operations         _blk_ops;
+
+		/*
+		 * The lock protects the request table, the packet allocator, and
+		 * the submit queue of the session, which are accessed by several
+		 * submitting threads as well as by the completion thread.
+		 */
 		Genode::Lock                       _session_lock;
 
+		Request                            _requests[MAX_REQUESTS];
+
+		/*
+		 * Threads waiting for a free request or for space in the packet
+		 * buffer, woken up on completion of a request
+		 */
+		unsigned                           _num_waiters = 0;
+		Genode::Semaphore                  _completion_sem;
+
+		Hard_context_thread                _completion_thread {
+			"rump_io", _completion_entry, this, 0, false };
+
+		/**
+		 * Allocate request and packet
+		 *
+		 * Must be called with '_session_lock' held.
+		 *
+		 * \return  nullptr if no request or packet-buffer space is available
+		 */
+		Request *_alloc_request(Block::Packet_descriptor::Opcode opcode,
+		                        int64_t offset, size_t length)
+		{
+			Request *request = nullptr;
+			for (Request &r : _requests)
+				if (!r.used) { request = &r; break; }
+
+			if (!request)
+				return nullptr;
+
+			try {
+				request->packet = Block::Packet_descriptor(
+					_session.dma_alloc_packet(length), opcode,
+					offset / _blk_size, length / _blk_size);
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return nullptr;
+			}
+
+			request->used = true;
+			return request;
+		}
+
+		/**
+		 * Return true if any request awaits its completion, must be called
+		 * with '_session_lock' held
+		 */
+		bool _requests_in_flight() const
+		{
+			for (Request const &r : _requests)
+				if (r.used) return true;
+
+			return false;
+		}
+
+		/**
+		 * Free request, must be called with '_session_lock' held
+		 */
+		void _free_request(Request &request)
+		{
+			_session.tx()->release_packet(request.packet);
+			request = Request();
+
+			if (_num_waiters) {
+				_num_waiters--;
+				_completion_sem.up();
+			}
+		}
+
+		Request &_lookup(Block::Packet_descriptor const &packet)
+		{
+			Genode::Lock::Guard guard(_session_lock);
+
+			for (Request &r : _requests)
+				if (r.used && r.packet.offset() == packet.offset())
+					return r;
+
+			/* cannot happen as all packets are submitted by us */
+			Genode::error("I/O back end: acknowledgement of unknown packet");
+			throw Genode::Exception();
+		}
+
+		static void *_completion_entry(void *arg)
+		{
+			/* attach a lwp to the thread to allow for calling 'biodone' */
+			_rump_upcalls.hyp_schedule();
+			_rump_upcalls.hyp_lwproc_newlwp(0);
+			_rump_upcalls.hyp_unschedule();
+
+			((Backend *)arg)->_complete_requests();
+			return nullptr;
+		}
+
+		void _complete_requests()
+		{
+			for (;;) {
+				Block::Packet_descriptor const packet =
+					_session.tx()->get_acked_packet();
+
+				Request &request = _lookup(packet);
+
+				size_t const length = request.length;
+
+				/* in packet */
+				if (packet.operation() == Block::Packet_descriptor::READ
+				 && packet.succeeded())
+					Genode::memcpy(request.data,
+					               _session.tx()->packet_content(packet), length);
+
+				/* sync request */
+				if (request.op & RUMPUSER_BIO_SYNC)
+					_session.sync();
+
+				int              const error   = packet.succeeded() ? 0 : EIO;
+				rump_biodone_fn  const biodone = request.biodone;
+				void            *const donearg = request.donearg;
+
+				{
+					Genode::Lock::Guard guard(_session_lock);
+					_free_request(request);
+				}
+
+				if (!biodone)
+					continue;
+
+				int nlocks;
+				rumpkern_sched(0, 0);
+				biodone(donearg, length, error);
+				rumpkern_unsched(&nlocks, 0);
+			}
+		}
+
 	public:
 
 		Backend()
 		{
 			_session.info(&_blk_cnt, &_blk_size, &_blk_ops);
+			_completion_thread.start();
 		}
 
 		uint64_t block_count() const { return (uint64_t)_blk_cnt; }
@@ -54,51 +215,64 @@ class Backend
 
 		void sync()
 		{
-			Genode::Lock::Guard guard(_session_lock);
 			_session.sync();
 		}
 
-		bool submit(int op, int64_t offset, size_t length, void *data)
+		/**
+		 * Submit block request
+		 *
+		 * Blocks as long as the maximum number of requests is in flight or
+		 * the packet buffer is exhausted.
+		 *
+		 * \return  false if no packet can be allocated for the request
+		 *          even though no other request is in flight
+		 */
+		bool submit(int op, int64_t offset, size_t length, void *data,
+		            rump_biodone_fn biodone, void *donearg)
 		{
 			using namespace Block;
 
-			Genode::Lock::Guard guard(_session_lock);
-
 			Packet_descriptor::Opcode opcode;
 			opcode = op & RUMPUSER_BIO_WRITE ? Packet_descriptor::WRITE :
 			                                   Packet_descriptor::READ;
-			/* allocate packet */
-			try {
-				Packet_descriptor packet( _session.dma_alloc_packet(length),
-				                         opcode, offset / _blk_size,
-				                         length / _blk_size);
-
-				/* out packet -> copy data */
-				if (opcode == Packet_descriptor::WRITE)
-					Genode::memcpy(_session.tx()->packet_content(packet), data, length);
-
-				_session.tx()->submit_packet(packet);
-			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-				Genode::error("I/O back end: Packet allocation failed!");
-				return false;
-			}
-
-			/* wait and process result */
-			Packet_descriptor packet = _session.tx()->get_acked_packet();
 
-			/* in packet */
-			if (opcode == Packet_descriptor::READ)
-				Genode::memcpy(data, _session.tx()->packet_content(packet), length);
-
-			bool succeeded = packet.succeeded();
-			_session.tx()->release_packet(packet);
-
-			/* sync request */
-			if (op & RUMPUSER_BIO_SYNC) {
-				_session.sync();
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_session_lock);
+
+					Request *request = _alloc_request(opcode, offset, length);
+					if (request) {
+						request->data    = data;
+						request->length  = length;
+						request->biodone = biodone;
+						request->donearg = donearg;
+						request->op      = op;
+
+						/* out packet -> copy data */
+						if (opcode == Packet_descriptor::WRITE)
+							Genode::memcpy(_session.tx()->packet_content(request->packet),
+							               data, length);
+
+						/*
+						 * The submit queue is single-producer, so the packet
+						 * is submitted with the lock held. This never blocks
+						 * because at most 'MAX_REQUESTS' packets, which is
+						 * less than the queue size, are in flight.
+						 */
+						_session.tx()->submit_packet(request->packet);
+						return true;
+					}
+
+					/* no completion will make room in the packet buffer */
+					if (!_requests_in_flight()) {
+						Genode::error("I/O back end: Packet allocation failed!");
+						return false;
+					}
+
+					_num_waiters++;
+				}
+				_completion_sem.down();
 			}
-
-			return succeeded;
 		}
 };
 
@@ -154,12 +328,12 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 		            "bio ",   donearg, " "
 		            "sync: ", !!(op & RUMPUSER_BIO_SYNC));
 
-	bool succeeded = backend().submit(op, off, dlen, data);
+	bool const submitted = backend().submit(op, off, dlen, data, biodone, donearg);
 
 	rumpkern_sched(nlocks, 0);
 
-	if (biodone)
-		biodone(donearg, dlen, succeeded ? 0 : EIO);
+	if (!submitted && biodone)
+		biodone(donearg, 0, EIO);
 }
 
 
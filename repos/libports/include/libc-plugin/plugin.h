@@ -21,6 +21,7 @@
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <sys/mount.h>  /* for 'struct statfs' */
 
 namespace Genode { class Env; }
@@ -124,6 +125,32 @@ namespace Libc {
 			virtual int pipe(File_descriptor *pipefd[2]);
 			virtual ssize_t read(File_descriptor *, void *buf, ::size_t count);
 			virtual ssize_t readlink(const char *path, char *buf, ::size_t bufsiz);
+
+			/**
+			 * Return ready I/O events of file descriptor
+			 *
+			 * \param events  bit mask of 'POLLIN', 'POLLOUT', and 'POLLPRI'
+			 *
+			 * The method must not block. If the descriptor is not ready, the
+			 * plugin should arrange for a later notification. The default
+			 * implementation queries the plugin's 'select' method.
+			 */
+			virtual int ready_events(File_descriptor *, int events);
+
+			/**
+			 * Return true if the plugin reports I/O events of its file
+			 * descriptors individually by passing the descriptor's context
+			 * to 'Libc::notify_io_event'
+			 */
+			virtual bool notifies_io_events() { return false; }
+
+			/**
+			 * Scatter read
+			 *
+			 * The default implementation reads one buffer after the other.
+			 * The arguments are validated by the caller.
+			 */
+			virtual ssize_t readv(File_descriptor *, const struct iovec *iov, int iovcnt);
 			virtual ssize_t recv(File_descriptor *, void *buf, ::size_t len, int flags);
 			virtual ssize_t recvfrom(File_descriptor *, void *buf, ::size_t len, int flags,
 			                         struct sockaddr *src_addr, socklen_t *addrlen);
@@ -146,6 +173,16 @@ namespace Libc {
 			virtual int symlink(const char *oldpath, const char *newpath);
 			virtual int unlink(const char *path);
 			virtual ssize_t write(File_descriptor *, const void *buf, ::size_t count);
+
+			/**
+			 * Gather write
+			 *
+			 * The default implementation writes one buffer after the other.
+			 * Plugins override this method to pass the buffers to their
+			 * back end in one operation. The arguments are validated by the
+			 * caller.
+			 */
+			virtual ssize_t writev(File_descriptor *, const struct iovec *iov, int iovcnt);
 	};
 }
 
@@ -20,7 +20,21 @@
 /* libc includes */
 #include <stdlib.h>
 
-namespace Libc { struct Allocator; }
+namespace Genode { class Thread; }
+
+namespace Libc {
+
+	struct Allocator;
+
+	/**
+	 * Return the blocks cached by malloc for 'thread' to the shared pools
+	 *
+	 * Must be called after the thread finished, e.g., on the destruction of
+	 * its 'Thread' object. Otherwise, the blocks of the thread's cache stay
+	 * unavailable to other threads.
+	 */
+	void release_malloc_cache(Genode::Thread const &thread);
+}
 
 
 struct Libc::Allocator : Genode::Allocator
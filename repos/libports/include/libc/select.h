@@ -26,6 +26,7 @@ namespace Libc {
 	struct Select_handler_base
 	{
 		Select_handler_cb *_select_cb;
+		int                _nfds = 0;
 
 		Select_handler_base();
 		~Select_handler_base();
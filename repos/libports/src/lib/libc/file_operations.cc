@@ -36,6 +36,7 @@
 #include "libc_file.h"
 #include "libc_mem_alloc.h"
 #include "libc_mmap_registry.h"
+#include "kqueue.h"
 
 using namespace Libc;
 
@@ -220,6 +221,10 @@ extern "C" int chdir(const char *path)
 
 extern "C" int _close(int libc_fd)
 {
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (fd)
+		drop_knotes(libc_fd, fd->context);
+
 	FD_FUNC_WRAPPER(close, libc_fd);
 }
 
@@ -0,0 +1,531 @@
+/*
+ * \brief  'kqueue()' and 'kevent()' implementations
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/lock.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/poll.h>
+#include <sys/time.h>
+#include <errno.h>
+
+/* libc plugin interface */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
+
+/* libc-internal includes */
+#include "kqueue.h"
+#include "libc_errno.h"
+#include "task.h"
+
+using namespace Libc;
+
+
+/**
+ * Global index of all knotes by the file-descriptor context they watch
+ *
+ * Knotes of plugins that do not report I/O events individually are kept in
+ * a separate list and are queued on any I/O event.
+ */
+struct Libc::Knote_registry
+{
+	enum { NUM_BUCKETS = 256 };
+
+	Genode::Lock lock;
+
+	Knote *_targeted[NUM_BUCKETS] { };
+	Knote *_untargeted = nullptr;
+
+	static unsigned _hash(Plugin_context const *source) {
+		return ((Genode::addr_t)source >> 4) % NUM_BUCKETS; }
+
+	Knote *&_head(Knote const &knote)
+	{
+		return knote.targeted ? _targeted[_hash(knote.source)] : _untargeted;
+	}
+
+	void insert(Knote &knote)
+	{
+		Knote *&head = _head(knote);
+		knote.source_next = head;
+		head = &knote;
+	}
+
+	void remove(Knote &knote)
+	{
+		for (Knote **k = &_head(knote); *k; k = &(*k)->source_next)
+			if (*k == &knote) {
+				*k = knote.source_next;
+				break;
+			}
+	}
+
+	/**
+	 * Destroy knotes of file descriptor 'fd' watching 'source'
+	 */
+	void drop(int fd, Plugin_context const *source)
+	{
+		Genode::Lock::Guard guard(lock);
+
+		auto drop_chain = [&] (Knote *&head) {
+			for (Knote **k = &head; *k; ) {
+				Knote &knote = **k;
+				if (knote.fd == fd && knote.source == source)
+					knote.kqueue._destroy(knote);
+				else
+					k = &knote.source_next;
+			}
+		};
+
+		drop_chain(_targeted[_hash(source)]);
+		drop_chain(_untargeted);
+	}
+
+	/**
+	 * Queue knotes affected by an I/O event of 'source'
+	 *
+	 * \return true if any knote got queued
+	 */
+	bool notify(Plugin_context const *source)
+	{
+		Genode::Lock::Guard guard(lock);
+
+		bool queued = false;
+
+		auto queue_chain = [&] (Knote *knote) {
+			for (; knote; knote = knote->source_next)
+				if (!source || !knote->targeted || knote->source == source)
+					queued |= knote->kqueue._enqueue(*knote); };
+
+		if (source)
+			queue_chain(_targeted[_hash(source)]);
+		else
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				queue_chain(_targeted[i]);
+
+		queue_chain(_untargeted);
+
+		return queued;
+	}
+};
+
+
+static Knote_registry &knote_registry()
+{
+	static Knote_registry inst;
+	return inst;
+}
+
+
+void Libc::notify_io_event(Plugin_context *context)
+{
+	if (knote_registry().notify(context))
+		Libc::resume_all();
+}
+
+
+void Libc::drop_knotes(int fd, Plugin_context *context)
+{
+	knote_registry().drop(fd, context);
+}
+
+
+/************
+ ** Kqueue **
+ ************/
+
+Knote *Kqueue::_lookup(int fd, int filter)
+{
+	for (Knote *k = _bucket(fd); k; k = k->kqueue_next)
+		if (k->fd == fd && k->filter == filter)
+			return k;
+
+	return nullptr;
+}
+
+
+bool Kqueue::_enqueue(Knote &knote)
+{
+	if (knote.queued || !knote.enabled)
+		return false;
+
+	knote.queued     = true;
+	knote.queue_next = nullptr;
+
+	if (_queue_tail)
+		_queue_tail->queue_next = &knote;
+	else
+		_queue_head = &knote;
+
+	_queue_tail = &knote;
+	_num_queued++;
+	return true;
+}
+
+
+void Kqueue::_dequeue(Knote &knote)
+{
+	if (!knote.queued)
+		return;
+
+	Knote *prev = nullptr;
+	for (Knote *k = _queue_head; k; prev = k, k = k->queue_next) {
+		if (k != &knote)
+			continue;
+
+		if (prev) prev->queue_next = k->queue_next;
+		else      _queue_head      = k->queue_next;
+
+		if (_queue_tail == k)
+			_queue_tail = prev;
+
+		break;
+	}
+
+	knote.queued     = false;
+	knote.queue_next = nullptr;
+	_num_queued--;
+}
+
+
+void Kqueue::_destroy(Knote &knote)
+{
+	_dequeue(knote);
+
+	knote_registry().remove(knote);
+
+	for (Knote **k = &_bucket(knote.fd); *k; k = &(*k)->kqueue_next)
+		if (*k == &knote) {
+			*k = knote.kqueue_next;
+			break;
+		}
+
+	Genode::destroy(_alloc, &knote);
+}
+
+
+bool Kqueue::_next_event(Event &event, unsigned &budget)
+{
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	while (budget && _queue_head) {
+
+		budget--;
+
+		Knote &knote = *_queue_head;
+		_dequeue(knote);
+
+		File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(knote.fd);
+
+		/* drop knote of closed file descriptor */
+		if (!fd || !fd->plugin || fd->context != knote.source) {
+			_destroy(knote);
+			continue;
+		}
+
+		if (!(fd->plugin->ready_events(fd, knote.filter) & knote.filter))
+			continue;
+
+		event = Event { knote.fd, knote.filter, knote.flags, knote.udata };
+
+		if (knote.flags & EV_ONESHOT)
+			_destroy(knote);
+		else if (knote.flags & EV_DISPATCH)
+			knote.enabled = false;
+		else if (!(knote.flags & EV_CLEAR))
+			_enqueue(knote);
+
+		return true;
+	}
+	return false;
+}
+
+
+Kqueue::~Kqueue()
+{
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	for (unsigned i = 0; i < NUM_BUCKETS; i++)
+		while (_knotes[i])
+			_destroy(*_knotes[i]);
+}
+
+
+int Kqueue::add(int fd, int filter, unsigned flags, void *udata)
+{
+	File_descriptor *fdo = file_descriptor_allocator()->find_by_libc_fd(fd);
+	if (!fdo || !fdo->plugin)
+		return EBADF;
+
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	Knote *knote = _lookup(fd, filter);
+
+	/* replace knote of a formerly closed file descriptor */
+	if (knote && knote->source != fdo->context) {
+		_destroy(*knote);
+		knote = nullptr;
+	}
+
+	if (!knote) {
+		knote = new (&_alloc)
+			Knote(*this, fd, filter, fdo->context,
+			      fdo->plugin->notifies_io_events());
+
+		knote->kqueue_next = _bucket(fd);
+		_bucket(fd) = knote;
+		knote_registry().insert(*knote);
+	}
+
+	knote->flags   = flags & (EV_CLEAR | EV_ONESHOT | EV_DISPATCH);
+	knote->udata   = udata;
+	knote->enabled = !(flags & EV_DISABLE);
+
+	/* evaluate the initial state on the next collection */
+	_enqueue(*knote);
+	return 0;
+}
+
+
+int Kqueue::remove(int fd, int filter)
+{
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	Knote *knote = _lookup(fd, filter);
+	if (!knote)
+		return ENOENT;
+
+	_destroy(*knote);
+	return 0;
+}
+
+
+int Kqueue::enable(int fd, int filter, bool enabled)
+{
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	Knote *knote = _lookup(fd, filter);
+	if (!knote)
+		return ENOENT;
+
+	knote->enabled = enabled;
+
+	if (enabled)
+		_enqueue(*knote);
+	else
+		_dequeue(*knote);
+
+	return 0;
+}
+
+
+bool Kqueue::watches(int fd, int filter)
+{
+	Genode::Lock::Guard guard(knote_registry().lock);
+
+	return _lookup(fd, filter) != nullptr;
+}
+
+
+unsigned long Kqueue::wait(unsigned long timeout_ms)
+{
+	struct Check : Suspend_functor
+	{
+		Kqueue &kqueue;
+
+		Check(Kqueue &kqueue) : kqueue(kqueue) { }
+
+		bool suspend() override { return !kqueue.pending(); }
+	} check { *this };
+
+	return Libc::suspend(check, timeout_ms);
+}
+
+
+/************************************
+ ** Kqueue as libc file descriptor **
+ ************************************/
+
+namespace {
+
+	struct Kqueue_context : Plugin_context
+	{
+		Kqueue kqueue;
+	};
+
+	struct Kqueue_plugin : Plugin
+	{
+		Libc::Allocator _alloc;
+
+		static Kqueue &kqueue(File_descriptor *fd) {
+			return static_cast<Kqueue_context *>(fd->context)->kqueue; }
+
+		File_descriptor *create()
+		{
+			Kqueue_context *context = new (&_alloc) Kqueue_context;
+
+			File_descriptor *fd = file_descriptor_allocator()->alloc(this, context);
+			if (!fd)
+				Genode::destroy(_alloc, context);
+
+			return fd;
+		}
+
+		int close(File_descriptor *fd) override
+		{
+			Genode::destroy(_alloc, static_cast<Kqueue_context *>(fd->context));
+			file_descriptor_allocator()->free(fd);
+			return 0;
+		}
+
+		/**
+		 * A kqueue is readable if events may be pending
+		 */
+		int ready_events(File_descriptor *fd, int events) override
+		{
+			return (events & POLLIN) && kqueue(fd).pending() ? POLLIN : 0;
+		}
+	};
+
+	Kqueue_plugin &kqueue_plugin()
+	{
+		static Kqueue_plugin inst;
+		return inst;
+	}
+}
+
+
+static int filter_from_kevent(short filter)
+{
+	switch (filter) {
+	case EVFILT_READ:  return POLLIN;
+	case EVFILT_WRITE: return POLLOUT;
+	default:           return 0;
+	}
+}
+
+
+/**
+ * Apply change of the change list
+ *
+ * \return 0 on success, or errno value
+ */
+static int apply_change(Kqueue &kqueue, struct kevent const &change)
+{
+	int const filter = filter_from_kevent(change.filter);
+	if (!filter)
+		return EINVAL;
+
+	int const fd = change.ident;
+
+	if (change.flags & EV_ADD)
+		return kqueue.add(fd, filter, change.flags, change.udata);
+
+	if (change.flags & EV_DELETE)
+		return kqueue.remove(fd, filter);
+
+	if (change.flags & EV_ENABLE)
+		return kqueue.enable(fd, filter, true);
+
+	if (change.flags & EV_DISABLE)
+		return kqueue.enable(fd, filter, false);
+
+	return 0;
+}
+
+
+extern "C" int kqueue(void)
+{
+	File_descriptor *fd = kqueue_plugin().create();
+	if (!fd)
+		return Errno(EMFILE);
+
+	return fd->libc_fd;
+}
+
+
+extern "C" int kevent(int kq, const struct kevent *changelist, int nchanges,
+                      struct kevent *eventlist, int nevents,
+                      const struct timespec *timeout)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(kq);
+	if (!fd || fd->plugin != &kqueue_plugin())
+		return Errno(EBADF);
+
+	if (nchanges < 0 || nevents < 0)
+		return Errno(EINVAL);
+
+	Kqueue &kqueue = Kqueue_plugin::kqueue(fd);
+
+	int n = 0;
+
+	/* errors and receipts are reported in the event list if possible */
+	for (int i = 0; i < nchanges; i++) {
+
+		struct kevent const &change = changelist[i];
+
+		int const error = apply_change(kqueue, change);
+
+		if (!error && !(change.flags & EV_RECEIPT))
+			continue;
+
+		if (n == nevents) {
+			if (error)
+				return Errno(error);
+			continue;
+		}
+
+		eventlist[n]       = change;
+		eventlist[n].flags = EV_ERROR;
+		eventlist[n].data  = error;
+		n++;
+	}
+
+	struct Timeout
+	{
+		bool    const valid;
+		unsigned long duration;
+
+		bool expired() const { return valid && duration == 0; }
+
+		static unsigned long _ms(timespec const *ts)
+		{
+			unsigned long const ms = ts->tv_sec*1000 + ts->tv_nsec/1000000;
+
+			/* round up timeouts below the granularity */
+			return (ms == 0 && ts->tv_nsec) ? 1 : ms;
+		}
+
+		Timeout(timespec const *ts)
+		: valid(ts != nullptr), duration(valid ? _ms(ts) : 0UL) { }
+	} wait_timeout { timeout };
+
+	for (;;) {
+
+		struct kevent *out = eventlist + n;
+
+		n += kqueue.collect(nevents - n, [&] (Kqueue::Event const &event) {
+			EV_SET(out, event.fd,
+			       event.filter == POLLIN ? EVFILT_READ : EVFILT_WRITE,
+			       event.flags, 0, 0, event.udata);
+			out++;
+		});
+
+		if (n || nevents == 0 || wait_timeout.expired())
+			return n;
+
+		wait_timeout.duration = kqueue.wait(wait_timeout.duration);
+	}
+}
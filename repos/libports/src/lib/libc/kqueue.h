@@ -0,0 +1,211 @@
+/*
+ * \brief  Persistent interest set for I/O events
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__KQUEUE_H_
+#define _LIBC__KQUEUE_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <libc/allocator.h>
+
+/* libc plugin interface */
+#include <libc-plugin/fd_alloc.h>
+
+
+namespace Libc {
+
+	class Kqueue;
+	struct Knote;
+	struct Knote_registry;
+
+	/**
+	 * Report a change of the I/O state of a file descriptor
+	 *
+	 * \param context  plugin context of the affected file descriptor, or
+	 *                 nullptr if the origin of the event is unknown
+	 *
+	 * Only the knotes watching 'context' are queued for re-evaluation, plus
+	 * the knotes of plugins that do not report I/O events individually.
+	 * Waiting user contexts are resumed if any knote got queued.
+	 */
+	void notify_io_event(Plugin_context *context);
+
+	/**
+	 * Remove all knotes watching file descriptor 'fd' with 'context'
+	 *
+	 * Must be called when the file descriptor is closed. Otherwise, its
+	 * knotes stay registered until the next evaluation.
+	 */
+	void drop_knotes(int fd, Plugin_context *context);
+}
+
+
+/**
+ * Interest in one I/O event of a file descriptor
+ */
+struct Libc::Knote : Genode::Noncopyable
+{
+	Kqueue         &kqueue;
+	int      const  fd;
+	int      const  filter;      /* 'POLLIN', 'POLLOUT', or 'POLLPRI' */
+	Plugin_context *source;      /* context of 'fd' at registration time */
+	bool            targeted;    /* plugin reports events of 'source' */
+
+	unsigned  flags   = 0;       /* 'EV_CLEAR', 'EV_ONESHOT', 'EV_DISPATCH' */
+	void     *udata   = nullptr;
+	bool      enabled = true;
+	bool      queued  = false;
+
+	Knote *kqueue_next = nullptr;  /* hash chain of the kqueue */
+	Knote *source_next = nullptr;  /* hash chain of the knote registry */
+	Knote *queue_next  = nullptr;  /* queue of knotes to evaluate */
+
+	Knote(Kqueue &kqueue, int fd, int filter, Plugin_context *source,
+	      bool targeted)
+	:
+		kqueue(kqueue), fd(fd), filter(filter), source(source),
+		targeted(targeted)
+	{ }
+};
+
+
+/**
+ * Set of knotes with a queue of knotes to evaluate
+ *
+ * A knote is queued on registration and whenever an I/O event is reported
+ * for its file descriptor. The readiness of queued knotes is evaluated when
+ * the events are collected. Hence, the cost of an I/O event is proportional
+ * to the number of knotes watching the affected descriptor, not to the
+ * number of registered descriptors.
+ *
+ * Knotes are level triggered by default, i.e., a knote stays queued as long
+ * as the event is ready. With 'EV_CLEAR', a knote is reported once per I/O
+ * event (edge triggered). With 'EV_ONESHOT', the knote is removed, and with
+ * 'EV_DISPATCH', it is disabled after being reported.
+ */
+class Libc::Kqueue : Genode::Noncopyable
+{
+	public:
+
+		struct Event
+		{
+			int       fd;
+			int       filter;
+			unsigned  flags;
+			void     *udata;
+		};
+
+	private:
+
+		friend struct Knote_registry;
+
+		enum { NUM_BUCKETS = 64 };
+
+		Libc::Allocator _alloc;
+
+		Knote    *_knotes[NUM_BUCKETS] { };
+		Knote    *_queue_head = nullptr;
+		Knote    *_queue_tail = nullptr;
+		unsigned  _num_queued = 0;
+
+		Knote *&_bucket(int fd) { return _knotes[(unsigned)fd % NUM_BUCKETS]; }
+
+		Knote *_lookup(int fd, int filter);
+
+		/*
+		 * The following methods must be called with the registry lock held
+		 */
+		bool _enqueue(Knote &);
+		void _dequeue(Knote &);
+		void _destroy(Knote &);
+
+		/**
+		 * Evaluate queued knotes until one is ready
+		 *
+		 * \param budget  maximum number of knotes to evaluate, decremented
+		 *                for each evaluated knote
+		 */
+		bool _next_event(Event &, unsigned &budget);
+
+	public:
+
+		~Kqueue();
+
+		/**
+		 * Add knote or modify the existing knote of 'fd' and 'filter'
+		 *
+		 * \return 0 on success, or errno value
+		 */
+		int add(int fd, int filter, unsigned flags, void *udata);
+
+		/**
+		 * Remove knote
+		 *
+		 * \return 0 on success, or errno value
+		 */
+		int remove(int fd, int filter);
+
+		/**
+		 * Enable or disable knote
+		 *
+		 * \return 0 on success, or errno value
+		 */
+		int enable(int fd, int filter, bool enabled);
+
+		/**
+		 * Return true if a knote of 'fd' and 'filter' is registered
+		 */
+		bool watches(int fd, int filter);
+
+		/**
+		 * Return true if knotes await evaluation
+		 */
+		bool pending() const { return _num_queued > 0; }
+
+		/**
+		 * Suspend the calling user context until knotes await evaluation
+		 *
+		 * \param timeout_ms  maximum time to stay suspended, 0 for infinite
+		 *
+		 * \return  remaining duration until timeout, 0 if the timeout expired
+		 */
+		unsigned long wait(unsigned long timeout_ms);
+
+		/**
+		 * Evaluate queued knotes and call 'fn' for each ready event
+		 *
+		 * \param max  maximum number of events to report
+		 *
+		 * \return  number of reported events
+		 *
+		 * Each queued knote is evaluated at most once per call.
+		 */
+		template <typename FN>
+		int collect(int max, FN const &fn)
+		{
+			unsigned budget = _num_queued;
+
+			int   n = 0;
+			Event event;
+			for (; n < max && _next_event(event, budget); n++)
+				fn(event);
+
+			return n;
+		}
+};
+
+#endif /* _LIBC__KQUEUE_H_ */
@@ -1,5 +1,5 @@
 /*
- * \brief  Simplistic malloc and free implementation
+ * \brief  Thread-caching malloc and free implementation
  * \author Norman Feske
  * \author Sebastian Sumpf
  * \date   2006-07-21
@@ -16,9 +16,11 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/construct_at.h>
 #include <util/string.h>
 #include <util/misc_math.h>
+#include <libc/allocator.h>
 
 /* libc includes */
 extern "C" {
@@ -62,7 +64,118 @@ namespace Genode {
 
 
 /**
- * Allocator that uses slabs for small objects sizes
+ * Unused block, linked via its first word
+ */
+struct Free_block { Free_block *next; };
+
+
+/**
+ * Singly-linked list of free blocks
+ */
+struct Free_list
+{
+	Free_block *first = nullptr;
+	unsigned    num   = 0;
+
+	void push(void *addr)
+	{
+		Free_block *block = (Free_block *)addr;
+		block->next = first;
+		first = block;
+		num++;
+	}
+
+	void *pop()
+	{
+		Free_block *block = first;
+		first = block->next;
+		num--;
+		return block;
+	}
+
+	/**
+	 * Move up to 'max' blocks from 'other' to this list
+	 */
+	void take(Free_list &other, unsigned max)
+	{
+		for (; max && other.num; max--)
+			push(other.pop());
+	}
+};
+
+
+/**
+ * Shared pool of blocks of one size class
+ *
+ * Threads obtain and return blocks in batches, which amortizes the costs of
+ * the lock over many allocations.
+ */
+class Size_class
+{
+	private:
+
+		typedef Genode::size_t size_t;
+
+		Genode::Lock       _lock;
+		Genode::Slab_alloc _slab;
+		Free_list          _free;
+
+	public:
+
+		size_t   const size;    /* block size including the header */
+		unsigned const batch;   /* number of blocks moved at once  */
+
+		Size_class(size_t size, Genode::Allocator *backing_store)
+		:
+			_slab(size, backing_store), size(size),
+			batch(Genode::max(4UL, Genode::min(64UL, 8192UL/size)))
+		{ }
+
+		/**
+		 * Move up to 'num' blocks to 'list'
+		 *
+		 * \return false if no block could be allocated
+		 */
+		bool alloc(Free_list &list, unsigned num)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			unsigned const old_num = list.num;
+
+			list.take(_free, num);
+
+			for (void *addr; list.num - old_num < num && (addr = _slab.alloc()); )
+				list.push(addr);
+
+			return list.num != old_num;
+		}
+
+		/**
+		 * Move up to 'num' blocks from 'list' to the pool
+		 */
+		void free(Free_list &list, unsigned num)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			_free.take(list, num);
+
+			/* return surplus blocks to the slab, which may release memory */
+			while (_free.num > 4*batch)
+				_slab.free(_free.pop());
+		}
+
+		size_t overhead(size_t size) const { return _slab.overhead(size); }
+};
+
+
+/**
+ * Allocator that uses per-thread caches of slab blocks for small objects
+ *
+ * Each thread keeps a free list per size class. Allocations and
+ * deallocations operate on the list of the calling thread without any lock.
+ * Only if a list runs empty or exceeds its limit, a batch of blocks is
+ * exchanged with the shared pool of the size class. Blocks may be freed by
+ * any thread. They end up in the cache of the freeing thread.
  */
 class Malloc : public Genode::Allocator
 {
@@ -71,72 +184,215 @@ class Malloc : public Genode::Allocator
 		typedef Genode::size_t size_t;
 
 		enum {
-			SLAB_START = 2,  /* 4 Byte (log2) */
-			SLAB_STOP  = 11, /* 2048 Byte (log2) */
-			NUM_SLABS = (SLAB_STOP - SLAB_START) + 1
+			SLAB_STOP   = 11, /* 2048 Byte (log2) */
+			NUM_SMALL   = 8,  /* classes of 16 to 128 Byte in steps of 16 */
+			NUM_CLASSES = NUM_SMALL + 4*(SLAB_STOP - 7),
+			MAX_THREADS = 256,
 		};
 
-		Genode::Allocator  *_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+		struct Thread_cache { Free_list lists[NUM_CLASSES]; };
+
+		/*
+		 * Registry of thread caches, keyed by the address of the 'Thread'
+		 * object
+		 *
+		 * Each thread looks up and registers only its own entry. Hence, the
+		 * lookup is lock-free. The lock serializes the registration and
+		 * release of entries. A released entry is marked as 'RELEASED'
+		 * instead of being cleared so that the lookup of entries registered
+		 * behind it still succeeds. It is reused by the next registration.
+		 */
+		struct Cache_entry
+		{
+			Genode::Thread * volatile thread;
+			Thread_cache   * volatile cache;
+		};
+
+		static Genode::Thread *_released() { return (Genode::Thread *)~0UL; }
+
+		Genode::Allocator *_backing_store;              /* back-end allocator */
+		Size_class        *_classes[NUM_CLASSES];
+		Cache_entry        _caches[MAX_THREADS];
+		Genode::Lock       _caches_lock;
 
-		unsigned long _slab_log2(unsigned long size) const
+		/**
+		 * Return size-class index for block size in the range of 1 to 2048
+		 *
+		 * Above 128 bytes, each power-of-two range is divided into four
+		 * classes.
+		 */
+		static unsigned _class_idx(unsigned long size)
 		{
-			unsigned msb = Genode::log2(size);
-			/* size is greater than msb */
-			if (size > (1U << msb))
-				msb++;
+			if (size <= 128)
+				return (size + 15)/16 - 1;
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			unsigned const msb = Genode::log2(size - 1);
+			return NUM_SMALL + 4*(msb - 7) + ((size - 1) >> (msb - 2)) - 4;
+		}
 
-			return msb;
+		static unsigned long _class_size(unsigned idx)
+		{
+			if (idx < NUM_SMALL)
+				return 16*(idx + 1);
+
+			unsigned const group = (idx - NUM_SMALL)/4;
+			unsigned const step  = (idx - NUM_SMALL)%4;
+			return (128UL << group) + (step + 1)*(32UL << group);
+		}
+
+		static unsigned _hash(Genode::Thread *thread) {
+			return ((unsigned long)thread >> 12) % MAX_THREADS; }
+
+		/**
+		 * Return cache of the calling thread, or nullptr if unavailable
+		 */
+		Thread_cache *_thread_cache()
+		{
+			Genode::Thread * const myself = Genode::Thread::myself();
+
+			/* the main thread on some platforms is not known as 'Thread' */
+			if (!myself)
+				return nullptr;
+
+			unsigned const start = _hash(myself);
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache_entry &entry = _caches[(start + i) % MAX_THREADS];
+				if (entry.thread == myself) return entry.cache;
+				if (!entry.thread)          break;
+			}
+
+			/* register new cache */
+			Genode::Lock::Guard lock_guard(_caches_lock);
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache_entry &entry = _caches[(start + i) % MAX_THREADS];
+				if (entry.thread && entry.thread != _released())
+					continue;
+
+				void *cache = nullptr;
+				if (!_backing_store->alloc(sizeof(Thread_cache), &cache))
+					return nullptr;
+
+				entry.cache  = Genode::construct_at<Thread_cache>(cache);
+				entry.thread = myself;
+				return entry.cache;
+			}
+
+			/* too many threads, the caller uses the pools directly */
+			return nullptr;
+		}
+
+		void *_alloc_small(unsigned idx)
+		{
+			Size_class   &size_class = *_classes[idx];
+			Thread_cache *cache      = _thread_cache();
+
+			if (!cache) {
+				Free_list list;
+				return size_class.alloc(list, 1) ? list.pop() : nullptr;
+			}
+
+			Free_list &list = cache->lists[idx];
+			if (!list.num && !size_class.alloc(list, size_class.batch))
+				return nullptr;
+
+			return list.pop();
+		}
+
+		void _free_small(unsigned idx, void *addr)
+		{
+			Size_class   &size_class = *_classes[idx];
+			Thread_cache *cache      = _thread_cache();
+
+			if (!cache) {
+				Free_list list;
+				list.push(addr);
+				size_class.free(list, 1);
+				return;
+			}
+
+			Free_list &list = cache->lists[idx];
+			list.push(addr);
+			if (list.num > 2*size_class.batch)
+				size_class.free(list, size_class.batch);
 		}
 
 	public:
 
 		Malloc(Genode::Allocator *backing_store) : _backing_store(backing_store)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] = new (backing_store)
-				                                 Genode::Slab_alloc(1U << i, backing_store);
-			}
+			for (unsigned i = 0; i < NUM_CLASSES; i++)
+				_classes[i] = new (backing_store)
+				              Size_class(_class_size(i), backing_store);
+
+			for (unsigned i = 0; i < MAX_THREADS; i++)
+				_caches[i] = Cache_entry { nullptr, nullptr };
 		}
 
 		~Malloc() { Genode::warning(__func__, " unexpectedly called"); }
 
+		/**
+		 * Return cached blocks of 'thread' to the pools and drop its cache
+		 */
+		void release_cache(Genode::Thread const &thread)
+		{
+			Genode::Lock::Guard lock_guard(_caches_lock);
+
+			unsigned const start = _hash(const_cast<Genode::Thread *>(&thread));
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache_entry &entry = _caches[(start + i) % MAX_THREADS];
+
+				if (!entry.thread)
+					return;
+
+				if (entry.thread != &thread)
+					continue;
+
+				Thread_cache * const cache = entry.cache;
+
+				for (unsigned idx = 0; idx < NUM_CLASSES; idx++)
+					_classes[idx]->free(cache->lists[idx], cache->lists[idx].num);
+
+				entry.cache  = nullptr;
+				entry.thread = _released();
+
+				cache->~Thread_cache();
+				_backing_store->free(cache, sizeof(Thread_cache));
+				return;
+			}
+		}
+
 		/**
 		 * Allocator interface
 		 */
 
 		bool alloc(size_t size, void **out_addr) override
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
-			/* enforce size to be a multiple of 4 bytes */
-			size = (size + 3) & ~3;
-
 			/*
-			 * We store the size of the allocation at the very
-			 * beginning of the allocated block and return
-			 * the subsequent address. This way, we can retrieve
-			 * the size information when freeing the block.
+			 * We store the size of the block at the very beginning of the
+			 * allocated block and return the subsequent address. This way,
+			 * we can retrieve the size information when freeing the block.
 			 */
 			unsigned long real_size = size + sizeof(Block_header);
-			unsigned long msb = _slab_log2(real_size);
 			void *addr = 0;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP) {
+			if (real_size > (1U << SLAB_STOP)) {
+
+				/* enforce size to be a multiple of 4 bytes */
+				real_size = (real_size + 3) & ~3UL;
 
 				if (!(_backing_store->alloc(real_size, &addr)))
 					return false;
 			}
-			else
-				if (!(addr = _allocator[msb - SLAB_START]->alloc()))
+			else {
+				unsigned const idx = _class_idx(real_size);
+				if (!(addr = _alloc_small(idx)))
 					return false;
 
+				real_size = _classes[idx]->size;
+			}
+
 			*(Block_header *)addr = real_size;
 			*out_addr = (Block_header *)addr + 1;
 			return true;
@@ -144,17 +400,13 @@ class Malloc : public Genode::Allocator
 
 		void free(void *ptr, size_t /* size */) override
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			unsigned long *addr = ((unsigned long *)ptr) - 1;
 			unsigned long  real_size = *addr;
 
 			if (real_size > (1U << SLAB_STOP))
 				_backing_store->free(addr, real_size);
-			else {
-				unsigned long msb = _slab_log2(real_size);
-				_allocator[msb - SLAB_START]->free(addr);
-			}
+			else
+				_free_small(_class_idx(real_size), addr);
 		}
 
 		size_t overhead(size_t size) const override
@@ -164,14 +416,14 @@ class Malloc : public Genode::Allocator
 			if (size > (1U << SLAB_STOP))
 				return _backing_store->overhead(size);
 
-			return _allocator[_slab_log2(size) - SLAB_START]->overhead(size);
+			return _classes[_class_idx(size)]->overhead(size);
 		}
 
 		bool need_size_for_free() const override { return false; }
 };
 
 
-static Genode::Allocator *allocator()
+static Malloc *allocator()
 {
 	static bool constructed = 0;
 	static char placeholder[sizeof(Malloc)];
@@ -184,6 +436,12 @@ static Genode::Allocator *allocator()
 }
 
 
+void Libc::release_malloc_cache(Genode::Thread const &thread)
+{
+	allocator()->release_cache(thread);
+}
+
+
 extern "C" void *malloc(size_t size)
 {
 	void *addr;
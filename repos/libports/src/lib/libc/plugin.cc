@@ -14,6 +14,9 @@
 /* Genode includes */
 #include <base/log.h>
 
+/* libc includes */
+#include <sys/poll.h>
+
 /* libc plugin interface */
 #include <libc-plugin/fd_alloc.h>
 #include <libc-plugin/plugin_registry.h>
@@ -211,3 +214,81 @@ DUMMY(int, -1, select,       (int, fd_set *, fd_set *, fd_set *, struct timeval
 DUMMY(int, -1, stat,         (const char*, struct stat*));
 DUMMY(int, -1, symlink,      (const char*, const char*));
 DUMMY(int, -1, unlink,       (const char*));
+
+
+int Plugin::ready_events(File_descriptor *fd, int events)
+{
+	int const libc_fd = fd->libc_fd;
+	int const nfds    = libc_fd + 1;
+
+	fd_set readfds, writefds, exceptfds;
+	FD_ZERO(&readfds);
+	FD_ZERO(&writefds);
+	FD_ZERO(&exceptfds);
+
+	if (events & POLLIN)  FD_SET(libc_fd, &readfds);
+	if (events & POLLOUT) FD_SET(libc_fd, &writefds);
+	if (events & POLLPRI) FD_SET(libc_fd, &exceptfds);
+
+	/* zero timeout for polling */
+	struct timeval tv_0 = { 0, 0 };
+
+	if (!supports_select(nfds, &readfds, &writefds, &exceptfds, &tv_0)
+	 || select(nfds, &readfds, &writefds, &exceptfds, &tv_0) <= 0)
+		return 0;
+
+	return (FD_ISSET(libc_fd, &readfds)   ? POLLIN  : 0)
+	     | (FD_ISSET(libc_fd, &writefds)  ? POLLOUT : 0)
+	     | (FD_ISSET(libc_fd, &exceptfds) ? POLLPRI : 0);
+}
+
+
+/*
+ * Vectored I/O, falling back to one operation per buffer
+ */
+
+ssize_t Plugin::readv(File_descriptor *fd, const struct iovec *iov, int iovcnt)
+{
+	ssize_t total = 0;
+
+	for (int i = 0; i < iovcnt; i++) {
+
+		if (!iov[i].iov_len)
+			continue;
+
+		ssize_t const n = read(fd, iov[i].iov_base, iov[i].iov_len);
+
+		/* report an error only if no data was transferred */
+		if (n < 0)
+			return total ? total : n;
+
+		total += n;
+
+		if ((::size_t)n < iov[i].iov_len)
+			break;
+	}
+	return total;
+}
+
+
+ssize_t Plugin::writev(File_descriptor *fd, const struct iovec *iov, int iovcnt)
+{
+	ssize_t total = 0;
+
+	for (int i = 0; i < iovcnt; i++) {
+
+		if (!iov[i].iov_len)
+			continue;
+
+		ssize_t const n = write(fd, iov[i].iov_base, iov[i].iov_len);
+
+		if (n < 0)
+			return total ? total : n;
+
+		total += n;
+
+		if ((::size_t)n < iov[i].iov_len)
+			break;
+	}
+	return total;
+}
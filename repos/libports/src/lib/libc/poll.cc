@@ -3,8 +3,8 @@
  * \author Josef Soentgen
  * \date   2012-07-12
  *
- * this 'poll()' implementation is based on OpenSSHp's and
- * uses our 'select()' function internally.
+ * The 'poll()' implementation registers the requested events at a kqueue,
+ * which evaluates only the descriptors affected by I/O events.
  */
 
 /*
@@ -15,94 +15,111 @@
  */
 
 /* Libc includes */
-#include <libc-plugin/plugin_registry.h>
-#include <libc-plugin/plugin.h>
-#include <sys/select.h>
 #include <sys/poll.h>
-#include <stdlib.h>
+#include <errno.h>
+
+#include "kqueue.h"
 
 using namespace Libc;
 
 
+enum {
+	POLL_READ   = POLLIN  | POLLRDNORM,
+	POLL_WRITE  = POLLOUT | POLLWRNORM,
+	POLL_EXCEPT = POLLPRI | POLLRDBAND,
+};
+
+
 /**
- * The poll function was taken from OpenSSH portable (bsd-poll.c) and adepted
- * to better fit within Genode's libc.
- *
- * Copyright (c) 2004, 2005, 2007 Darren Tucker (dtucker at zip com au).
- *
- * Permission to use, copy, modify, and distribute this software for any
- * purpose with or without fee is hereby granted, provided that the above
- * copyright notice and this permission notice appear in all copies.
+ * Register event 'filter' of 'pfd' at 'kqueue' if requested
  *
- * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
- * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
- * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
- * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
- * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
- * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
- * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ * \return 0 on success, or errno value
  */
+static int add(Kqueue &kqueue, pollfd &pfd, int filter, short mask,
+               bool &duplicates)
+{
+	if (!(pfd.events & mask))
+		return 0;
+
+	/*
+	 * There is only one knote per descriptor and filter, which refers to
+	 * the first 'pollfd' entry of the descriptor.
+	 */
+	if (kqueue.watches(pfd.fd, filter)) {
+		duplicates = true;
+		return 0;
+	}
+
+	return kqueue.add(pfd.fd, filter, 0, &pfd);
+}
+
+
 extern "C" int
 __attribute__((weak))
-poll(struct pollfd fds[], nfds_t nfds, int timeout)
+poll(struct pollfd fds[], nfds_t nfds, int timeout_ms)
 {
-	nfds_t i;
-	int ret, fd, maxfd = 0;
-	fd_set readfds, writefds, exceptfds;
-	struct timeval tv, *tvp = NULL;
-
-	for (i = 0; i < nfds; i++) {
-		fd = fds[i].fd;
-		if (fd >= (int)FD_SETSIZE) {
-			/*errno = EINVAL;*/
-			return -1;
-		}
-		maxfd = MAX(maxfd, fd);
-	}
+	Kqueue kqueue;
+
+	int nready = 0;
+
+	/* true if a descriptor appears in multiple entries */
+	bool duplicates = false;
+
+	for (nfds_t i = 0; i < nfds; i++) {
+
+		pollfd &pfd = fds[i];
+
+		pfd.revents = 0;
 
-	/* populate event bit vectors for the events we're interested in */
-	for (i = 0; i < nfds; i++) {
-		fd = fds[i].fd;
-		if (fd == -1)
+		if (pfd.fd < 0)
 			continue;
-		if (fds[i].events & POLLIN) {
-			FD_SET(fd, &readfds);
-			FD_SET(fd, &exceptfds);
-		}
-		if (fds[i].events & POLLOUT) {
-			FD_SET(fd, &writefds);
-			FD_SET(fd, &exceptfds);
+
+		int error = 0;
+		if (!error) error = add(kqueue, pfd, POLLIN,  POLL_READ,   duplicates);
+		if (!error) error = add(kqueue, pfd, POLLOUT, POLL_WRITE,  duplicates);
+		if (!error) error = add(kqueue, pfd, POLLPRI, POLL_EXCEPT, duplicates);
+
+		if (error == EBADF) {
+			pfd.revents = POLLNVAL;
+			nready++;
 		}
 	}
 
-	/* poll timeout is msec, select is timeval (sec + usec) */
-	if (timeout >= 0) {
-		tv.tv_sec = timeout / 1000;
-		tv.tv_usec = (timeout % 1000) * 1000;
-		tvp = &tv;
-	}
-	ret = select(maxfd + 1, &readfds, &writefds, &exceptfds, tvp);
-	/*saved_errno = errno;*/
-	/* scan through select results and set poll() flags */
-	for (i = 0; i < nfds; i++) {
-		fd = fds[i].fd;
-		fds[i].revents = 0;
-		if (fd == -1)
-			continue;
-		if (FD_ISSET(fd, &readfds)) {
-			fds[i].revents |= POLLIN;
-		}
-		if (FD_ISSET(fd, &writefds)) {
-			fds[i].revents |= POLLOUT;
-		}
-		if (FD_ISSET(fd, &exceptfds)) {
-			fds[i].revents |= POLLERR;
+	auto report = [&] (pollfd &pfd, int filter) {
+
+		short const revents = pfd.revents;
+
+		switch (filter) {
+		case POLLIN:  pfd.revents |= pfd.events & POLL_READ;   break;
+		case POLLOUT: pfd.revents |= pfd.events & POLL_WRITE;  break;
+		case POLLPRI: pfd.revents |= pfd.events & POLL_EXCEPT; break;
 		}
-	}
 
-	/*
-	if (ret == -1)
-		errno = saved_errno;
-	*/
-	return ret;
+		if (!revents && pfd.revents)
+			nready++;
+	};
+
+	bool          const valid    = timeout_ms >= 0;
+	unsigned long       duration = valid ? timeout_ms : 0;
+
+	for (;;) {
+
+		kqueue.collect(3*nfds, [&] (Kqueue::Event const &event) {
+
+			if (!duplicates) {
+				report(*(pollfd *)event.udata, event.filter);
+				return;
+			}
+
+			/* fan the event out to all entries of the descriptor */
+			for (pollfd *pfd = (pollfd *)event.udata; pfd < fds + nfds; pfd++)
+				if (pfd->fd == event.fd)
+					report(*pfd, event.filter);
+		});
+
+		if (nready || (valid && duration == 0))
+			return nready;
+
+		duration = kqueue.wait(duration);
+	}
 }
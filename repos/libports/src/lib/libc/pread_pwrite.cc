@@ -1,5 +1,5 @@
 /*
- * \brief  'pread()' and 'pwrite()' implementations
+ * \brief  'pread()', 'pwrite()', 'preadv()', and 'pwritev()' implementations
  * \author Christian Prochaska
  * \date   2012-07-11
  */
@@ -39,8 +39,26 @@ struct Write
 };
 
 
-template <typename Rw_func, typename Buf_type>
-static ssize_t pread_pwrite_impl(Rw_func rw_func, int fd, Buf_type buf, ::size_t count, ::off_t offset)
+struct Readv
+{
+	ssize_t operator()(int fd, const struct iovec *iov, int iovcnt)
+	{
+		return readv(fd, iov, iovcnt);
+	}
+};
+
+
+struct Writev
+{
+	ssize_t operator()(int fd, const struct iovec *iov, int iovcnt)
+	{
+		return writev(fd, iov, iovcnt);
+	}
+};
+
+
+template <typename Rw_func, typename Buf_type, typename Count_type>
+static ssize_t pread_pwrite_impl(Rw_func rw_func, int fd, Buf_type buf, Count_type count, ::off_t offset)
 {
 	Libc::File_descriptor *fdesc = Libc::file_descriptor_allocator()->find_by_libc_fd(fd);
 	if (fdesc == 0)
@@ -75,3 +93,15 @@ extern "C" ssize_t pwrite(int fd, const void *buf, ::size_t count, ::off_t offse
 {
 	return pread_pwrite_impl(Write(), fd, buf, count, offset);
 }
+
+
+extern "C" ssize_t preadv(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	return pread_pwrite_impl(Readv(), fd, iov, iovcnt, offset);
+}
+
+
+extern "C" ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	return pread_pwrite_impl(Writev(), fd, iov, iovcnt, offset);
+}
@@ -12,90 +12,56 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-/* Genode includes */
-#include <base/lock.h>
+/* libc plugin interface */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
 
 /* libc includes */
 #include <sys/uio.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <unistd.h>
 #include <errno.h>
-#include <stdio.h>
 
+/* libc-internal includes */
+#include "libc_file.h"
 
-static Genode::Lock rw_lock;
+using namespace Libc;
 
 
-struct Read
+/**
+ * Return total length of the I/O vector, or -1 if the vector is invalid
+ */
+static ssize_t iov_length(const struct iovec *iov, int iovcnt)
 {
-     ssize_t operator()(int fd, void *buf, size_t count)
-     {
-    	 return read(fd, buf, count);
-     }
-};
+	if (iovcnt < 1 || iovcnt > IOV_MAX)
+		return -1;
 
+	::size_t len = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		if (iov[i].iov_len > SSIZE_MAX - len)
+			return -1;
+		len += iov[i].iov_len;
+	}
+	return len;
+}
 
-struct Write
-{
-     ssize_t operator()(int fd, const void *buf, size_t count)
-     {
-    	 return write(fd, buf, count);
-     }
-};
 
+/*
+ * The vector is passed to the plugin of the file descriptor as a whole. So
+ * no lock is needed to keep the transfer in one piece and operations on
+ * different file descriptors proceed in parallel.
+ */
 
-template <typename Rw_func>
-static ssize_t readv_writev_impl(Rw_func rw_func, int fd, const struct iovec *iov, int iovcnt)
+extern "C" ssize_t _readv(int libc_fd, const struct iovec *iov, int iovcnt)
 {
-	Genode::Lock_guard<Genode::Lock> rw_lock_guard(rw_lock);
-
-	char *v;
-	ssize_t bytes_transfered_total = 0;
-	size_t v_len = 0;
-	int i;
-
-	if (iovcnt < 1 || iovcnt > IOV_MAX) {
-		errno = EINVAL;
-		return -1;
-	}
-
-	for (i = 0; i < iovcnt; i++)
-		v_len += iov->iov_len;
-
-	if (v_len > SSIZE_MAX) {
+	ssize_t const len = iov_length(iov, iovcnt);
+	if (len == -1) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	while (iovcnt > 0) {
-		v = static_cast<char *>(iov->iov_base);
-		v_len = iov->iov_len;
-
-		while (v_len > 0) {
-			ssize_t bytes_transfered = rw_func(fd, v, v_len);
-
-			if (bytes_transfered == -1)
-				return -1;
-
-			if (bytes_transfered == 0)
-				return bytes_transfered_total;
-
-			v_len -= bytes_transfered;
-			v += bytes_transfered;
-			bytes_transfered_total += bytes_transfered;
-		}
-
-		iov++;
-		iovcnt--;
-	}
-
-	return bytes_transfered_total;
-}
-
-
-extern "C" ssize_t _readv(int fd, const struct iovec *iov, int iovcnt)
-{
-	return readv_writev_impl(Read(), fd, iov, iovcnt);
+	FD_FUNC_WRAPPER(readv, libc_fd, iov, iovcnt);
 }
 
 
@@ -105,9 +71,23 @@ extern "C" ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
 }
 
 
-extern "C" ssize_t _writev(int fd, const struct iovec *iov, int iovcnt)
+extern "C" ssize_t _writev(int libc_fd, const struct iovec *iov, int iovcnt)
 {
-	return readv_writev_impl(Write(), fd, iov, iovcnt);
+	ssize_t const len = iov_length(iov, iovcnt);
+	if (len == -1) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (len == 0)
+		return 0;
+
+	int flags = fcntl(libc_fd, F_GETFL);
+
+	if ((flags != -1) && (flags & O_APPEND))
+		lseek(libc_fd, 0, SEEK_END);
+
+	FD_FUNC_WRAPPER(writev, libc_fd, iov, iovcnt);
 }
 
 
@@ -23,6 +23,7 @@
 /* Genode includes */
 #include <base/log.h>
 #include <util/reconstructible.h>
+#include <util/construct_at.h>
 
 /* Libc includes */
 #include <libc-plugin/plugin_registry.h>
@@ -30,174 +31,123 @@
 #include <libc/select.h>
 #include <stdlib.h>
 #include <sys/select.h>
+#include <sys/poll.h>
 #include <signal.h>
 
+#include "kqueue.h"
 #include "task.h"
 
 
-namespace Libc {
-	struct Select_cb;
-	struct Select_cb_list;
-}
-
+namespace Libc { struct Select_cb; }
 
-void (*libc_select_notify)() __attribute__((weak));
 
+/*
+ * Notification hook for plugins that do not report I/O events of individual
+ * file descriptors
+ */
+static void select_notify() { Libc::notify_io_event(nullptr); }
 
-/** Description for a task waiting in select */
-struct Libc::Select_cb
-{
-	Select_cb *next = nullptr;
-
-	int const nfds;
-	int       nready = 0;
-	fd_set    readfds;
-	fd_set    writefds;
-	fd_set    exceptfds;
-
-	Select_cb(int nfds, fd_set const &readfds, fd_set const &writefds, fd_set const &exceptfds)
-	:
-		nfds(nfds), readfds(readfds), writefds(writefds), exceptfds(exceptfds)
-	{ }
-};
+void (*libc_select_notify)() __attribute__((weak)) = select_notify;
 
 
-struct Libc::Select_cb_list
+/**
+ * Interest set of a select handler
+ *
+ * The kqueue is kept across calls. Each call updates the knotes according to
+ * the difference between the previous and the new fd sets.
+ */
+struct Libc::Select_cb
 {
-	Genode::Lock  _mutex;
-	Select_cb    *_first = nullptr;
+	Kqueue kqueue;
 
-	struct Guard : Genode::Lock::Guard
-	{
-Select_cb_list *l;
+	int    nfds = 0;
+	fd_set readfds, writefds, exceptfds;
 
-		Guard(Select_cb_list &list) : Genode::Lock::Guard(list._mutex), l(&list) { }
-	};
-
-	void unsynchronized_insert(Select_cb *scb)
-	{
-		scb->next = _first;
-		_first = scb;
-	}
+	bool armed = false;  /* waiting for 'select_ready' */
 
-	void insert(Select_cb *scb)
+	Select_cb()
 	{
-		Guard guard(*this);
-		unsynchronized_insert(scb);
+		FD_ZERO(&readfds);
+		FD_ZERO(&writefds);
+		FD_ZERO(&exceptfds);
 	}
 
-	void remove(Select_cb *scb)
+	void update(int new_nfds, fd_set const &new_readfds,
+	            fd_set const &new_writefds, fd_set const &new_exceptfds)
 	{
-		Guard guard(*this);
-
-		/* address of pointer to next allows to change the head */
-		for (Select_cb **next = &_first; *next; next = &(*next)->next) {
-			if (*next == scb) {
-				*next = scb->next;
-				break;
-			}
+		auto update_fd = [&] (int fd, fd_set &old_set, fd_set const &new_set,
+		                      int filter) {
+			bool const was_set = fd < nfds     && FD_ISSET(fd, &old_set);
+			bool const is_set  = fd < new_nfds && FD_ISSET(fd, &new_set);
+
+			/* re-adding an existing knote re-evaluates its state */
+			if (is_set)
+				kqueue.add(fd, filter, 0, nullptr);
+			else if (was_set)
+				kqueue.remove(fd, filter);
+		};
+
+		int const max_nfds = nfds > new_nfds ? nfds : new_nfds;
+
+		for (int fd = 0; fd < max_nfds; fd++) {
+			update_fd(fd, readfds,   new_readfds,   POLLIN);
+			update_fd(fd, writefds,  new_writefds,  POLLOUT);
+			update_fd(fd, exceptfds, new_exceptfds, POLLPRI);
 		}
-	}
-
-	template <typename FUNC>
-	void for_each(FUNC const &func)
-	{
-		Guard guard(*this);
 
-		for (Select_cb *scb = _first; scb; scb = scb->next)
-			func(*scb);
+		nfds      = new_nfds;
+		readfds   = new_readfds;
+		writefds  = new_writefds;
+		exceptfds = new_exceptfds;
 	}
 };
 
-/** The global list of tasks waiting for select */
-static Libc::Select_cb_list select_cb_list;
-
 
 /**
- * Poll plugin select() functions
+ * Register the file descriptors of the fd sets at the kqueue
  *
- * We iterate over all file descriptors in each list and count the number of
- * ready descriptors. Output file-descriptor sets are cleared by this function
- * (according to POSIX).
+ * Descriptors not known to the libc are ignored, like they were ignored
+ * by the plugins' select() functions.
  */
-static int selscan(int nfds,
-                   fd_set *in_readfds,  fd_set *in_writefds,  fd_set *in_exceptfds,
-                   fd_set *out_readfds, fd_set *out_writefds, fd_set *out_exceptfds)
+static void register_fds(Libc::Kqueue &kqueue, int nfds,
+                         fd_set const &readfds, fd_set const &writefds,
+                         fd_set const &exceptfds)
 {
-	int nready = 0;
-
-	 /* zero timeout for polling of the plugins' select() functions */
-	struct timeval tv_0 = { 0, 0 };
-
-	/* temporary fd sets that are passed to the plugins */
-	int    plugin_nready;
-	fd_set plugin_readfds;
-	fd_set plugin_writefds;
-	fd_set plugin_exceptfds;
-
-	/* clear fd sets */
-	if (out_readfds)   FD_ZERO(out_readfds);
-	if (out_writefds)  FD_ZERO(out_writefds);
-	if (out_exceptfds) FD_ZERO(out_exceptfds);
-
-	for (Libc::Plugin *plugin = Libc::plugin_registry()->first();
-	     plugin;
-	     plugin = plugin->next()) {
-		if (plugin->supports_select(nfds, in_readfds, in_writefds, in_exceptfds, &tv_0)) {
-
-			plugin_readfds = *in_readfds;
-			plugin_writefds = *in_writefds;
-			plugin_exceptfds = *in_exceptfds;
-
-			plugin_nready = plugin->select(nfds, &plugin_readfds, &plugin_writefds, &plugin_exceptfds, &tv_0);
-
-			if (plugin_nready > 0) {
-				for (int libc_fd = 0; libc_fd < nfds; libc_fd++) {
-					if (out_readfds && FD_ISSET(libc_fd, &plugin_readfds)) {
-						FD_SET(libc_fd, out_readfds);
-					}
-					if (out_writefds && FD_ISSET(libc_fd, &plugin_writefds)) {
-						FD_SET(libc_fd, out_writefds);
-					}
-					if (out_exceptfds && FD_ISSET(libc_fd, &plugin_exceptfds)) {
-						FD_SET(libc_fd, out_exceptfds);
-					}
-				}
-				nready += plugin_nready;
-			} else if (plugin_nready < 0) {
-				Genode::error("plugin->select() returned error value ", plugin_nready);
-			}
-		}
+	for (int fd = 0; fd < nfds; fd++) {
+		if (FD_ISSET(fd, &readfds))   kqueue.add(fd, POLLIN,  0, nullptr);
+		if (FD_ISSET(fd, &writefds))  kqueue.add(fd, POLLOUT, 0, nullptr);
+		if (FD_ISSET(fd, &exceptfds)) kqueue.add(fd, POLLPRI, 0, nullptr);
 	}
-
-	return nready;
 }
 
 
-/* this function gets called by plugin backends when file descripors become ready */
-static void select_notify()
+/**
+ * Collect ready file descriptors
+ *
+ * Output file-descriptor sets are cleared by this function (according to
+ * POSIX).
+ *
+ * \return number of ready descriptors summed over all sets
+ */
+static int collect_fds(Libc::Kqueue &kqueue, int nfds,
+                       fd_set *readfds, fd_set *writefds, fd_set *exceptfds)
 {
-	bool resume_all = false;
-	fd_set tmp_readfds, tmp_writefds, tmp_exceptfds;
-
-	/* check for each waiting select() function if one of its fds is ready now
-	 * and if so, wake all up */
-
-	select_cb_list.for_each([&] (Libc::Select_cb &scb) {
-		scb.nready = selscan(scb.nfds,
-		                     &scb.readfds, &scb.writefds, &scb.exceptfds,
-		                     &tmp_readfds,  &tmp_writefds,  &tmp_exceptfds);
-		if (scb.nready > 0) {
-			scb.readfds   = tmp_readfds;
-			scb.writefds  = tmp_writefds;
-			scb.exceptfds = tmp_exceptfds;
-
-			resume_all = true;
+	if (readfds)   FD_ZERO(readfds);
+	if (writefds)  FD_ZERO(writefds);
+	if (exceptfds) FD_ZERO(exceptfds);
+
+	return kqueue.collect(3*nfds, [&] (Libc::Kqueue::Event const &event) {
+
+		fd_set *set = nullptr;
+		switch (event.filter) {
+		case POLLIN:  set = readfds;   break;
+		case POLLOUT: set = writefds;  break;
+		case POLLPRI: set = exceptfds; break;
 		}
-	});
 
-	if (resume_all)
-		Libc::resume_all();
+		if (set)
+			FD_SET(event.fd, set);
+	});
 }
 
 
@@ -222,41 +172,13 @@ _select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
 {
 	fd_set in_readfds, in_writefds, in_exceptfds;
 
-	Genode::Constructible<Libc::Select_cb> select_cb;
-
-	/* initialize the select notification function pointer */
-	if (!libc_select_notify)
-		libc_select_notify = select_notify;
-
 	if (readfds)   in_readfds   = *readfds;   else FD_ZERO(&in_readfds);
 	if (writefds)  in_writefds  = *writefds;  else FD_ZERO(&in_writefds);
 	if (exceptfds) in_exceptfds = *exceptfds; else FD_ZERO(&in_exceptfds);
 
-	{
-		/*
-		 * We use the guard directly to atomically check is any descripor is
-		 * ready, and insert into select-callback list otherwise.
-		 */
-		Libc::Select_cb_list::Guard guard(select_cb_list);
-
-		int const nready = selscan(nfds,
-		                           &in_readfds, &in_writefds, &in_exceptfds,
-		                           readfds, writefds, exceptfds);
-
-		/* return if any descripor is ready */
-		if (nready)
-			return nready;
-
-		/* return on zero-timeout */
-		if (tv && (tv->tv_sec) == 0 && (tv->tv_usec == 0))
-			return 0;
-
-		/* suspend as we don't have any immediate events */
+	Libc::Kqueue kqueue;
 
-		select_cb.construct(nfds, in_readfds, in_writefds, in_exceptfds);
-
-		select_cb_list.unsynchronized_insert(&(*select_cb));
-	}
+	register_fds(kqueue, nfds, in_readfds, in_writefds, in_exceptfds);
 
 	struct Timeout
 	{
@@ -269,32 +191,17 @@ _select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
 		Timeout(timeval *tv) : _tv(tv) { }
 	} timeout { tv };
 
-	struct Check : Libc::Suspend_functor {
-		struct Timeout  *timeout;
-		Libc::Select_cb *select_cb;
-
-		Check(Timeout *timeout, Libc::Select_cb * select_cb)
-		: timeout(timeout), select_cb(select_cb) { }
-
-		bool suspend() override {
-			return !timeout->expired() && select_cb->nready == 0; }
-	} check ( &timeout, &*select_cb );
-
-	while (!timeout.expired() && select_cb->nready == 0)
-		timeout.duration = Libc::suspend(check, timeout.duration);
-
-	select_cb_list.remove(&(*select_cb));
-
-	if (timeout.expired())
-		return 0;
+	for (;;) {
 
-	/* not timed out -> results have been stored in select_cb by select_notify() */
+		int const nready = collect_fds(kqueue, nfds, readfds, writefds, exceptfds);
 
-	if (readfds)   *readfds   = select_cb->readfds;
-	if (writefds)  *writefds  = select_cb->writefds;
-	if (exceptfds) *exceptfds = select_cb->exceptfds;
+		/* return if any descripor is ready or on timeout */
+		if (nready || timeout.expired())
+			return nready;
 
-	return select_cb->nready;
+		/* suspend as we don't have any immediate events */
+		timeout.duration = kqueue.wait(timeout.duration);
+	}
 }
 
 
@@ -349,42 +256,26 @@ pselect(int nfds, fd_set *readfds, fd_set *writefds,
 int Libc::Select_handler_base::select(int nfds, fd_set &readfds,
                                       fd_set &writefds, fd_set &exceptfds)
 {
-	fd_set in_readfds, in_writefds, in_exceptfds;
+	if (!_select_cb->constructed())
+		_select_cb->construct();
 
-	/* initialize the select notification function pointer */
-	if (!libc_select_notify)
-		libc_select_notify = select_notify;
+	Select_cb &select_cb = **_select_cb;
 
-	in_readfds   = readfds;
-	in_writefds  = writefds;
-	in_exceptfds = exceptfds;
-
-	/* remove potentially enqueued callback from list */
-	if (_select_cb->constructed())
-		select_cb_list.remove(&(**_select_cb));
-
-	{
-		/*
-		 * We use the guard directly to atomically check is any descripor is
-		 * ready, and insert into select-callback list otherwise.
-		 */
-		Libc::Select_cb_list::Guard guard(select_cb_list);
-
-		int const nready = selscan(nfds,
-		                           &in_readfds, &in_writefds, &in_exceptfds,
-		                           &readfds, &writefds, &exceptfds);
-
-		/* return if any descripor is ready */
-		if (nready)
-			return nready;
+	select_cb.update(nfds, readfds, writefds, exceptfds);
 
-		/* suspend as we don't have any immediate events */
+	_nfds = nfds;
 
-		_select_cb->construct(nfds, in_readfds, in_writefds, in_exceptfds);
+	int const nready = collect_fds(select_cb.kqueue, nfds,
+	                               &readfds, &writefds, &exceptfds);
 
-		select_cb_list.unsynchronized_insert(&(**_select_cb));
+	/* return if any descripor is ready */
+	if (nready) {
+		select_cb.armed = false;
+		return nready;
 	}
 
+	/* suspend as we don't have any immediate events */
+	select_cb.armed = true;
 	Libc::schedule_select(this);
 
 	return 0;
@@ -395,20 +286,29 @@ void Libc::Select_handler_base::dispatch_select()
 {
 	Select_handler_cb &select_cb = *_select_cb;
 
-	if (select_cb->nready == 0) return;
+	if (!select_cb.constructed() || !select_cb->armed
+	 || !select_cb->kqueue.pending()) return;
+
+	fd_set readfds, writefds, exceptfds;
+
+	int const nready = collect_fds(select_cb->kqueue, _nfds,
+	                               &readfds, &writefds, &exceptfds);
+	if (nready == 0) return;
 
-	select_cb_list.remove(&(*select_cb));
+	select_cb->armed = false;
 	Libc::schedule_select(nullptr);
 
-	select_ready(select_cb->nready, select_cb->readfds,
-	             select_cb->writefds, select_cb->exceptfds);
+	select_ready(nready, readfds, writefds, exceptfds);
 }
 
 
 Libc::Select_handler_base::Select_handler_base()
 :
-	_select_cb((Select_handler_cb*)malloc(sizeof(*_select_cb)))
+	_select_cb(Genode::construct_at<Select_handler_cb>(malloc(sizeof(Select_handler_cb))))
 { }
 
 Libc::Select_handler_base::~Select_handler_base()
-{ }
+{
+	_select_cb->destruct();
+	free(_select_cb);
+}
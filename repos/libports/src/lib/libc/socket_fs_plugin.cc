@@ -29,6 +29,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <sys/poll.h>
 #include <stdio.h>
 
 /* libc-internal includes */
@@ -185,9 +186,11 @@ namespace {
 
 		ssize_t read(Libc::File_descriptor *, void *, ::size_t) override;
 		ssize_t write(Libc::File_descriptor *, const void *, ::size_t) override;
+		ssize_t writev(Libc::File_descriptor *, const struct iovec *, int) override;
 		int fcntl(Libc::File_descriptor *, int, long) override;
 		int close(Libc::File_descriptor *) override;
 		int select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
+		int ready_events(Libc::File_descriptor *, int) override;
 	};
 
 	Socket_plugin & socket_plugin()
@@ -782,6 +785,21 @@ ssize_t Socket_plugin::write(Libc::File_descriptor *fd, const void *buf, ::size_
 }
 
 
+ssize_t Socket_plugin::writev(Libc::File_descriptor *fd, const struct iovec *iov, int iovcnt)
+{
+	Socket_context *context = dynamic_cast<Socket_context *>(fd->context);
+	if (!context) return Errno(ENOTSOCK);
+
+	/* pass the whole I/O vector to the data file at once */
+	try {
+		lseek(context->data_fd(), 0, 0);
+		return ::writev(context->data_fd(), iov, iovcnt);
+	} catch (Socket_context::Inaccessible) {
+		return Errno(EINVAL);
+	}
+}
+
+
 bool Socket_plugin::supports_select(int nfds,
                                     fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
                                     struct timeval *timeout)
@@ -851,6 +869,18 @@ int Socket_plugin::select(int nfds,
 }
 
 
+int Socket_plugin::ready_events(Libc::File_descriptor *fd, int events)
+{
+	Socket_context *context = dynamic_cast<Socket_context *>(fd->context);
+	if (!context) return 0;
+
+	/* same conditions as evaluated by 'select' */
+	try {
+		return (events & POLLIN) && context->read_ready() ? POLLIN : 0;
+	} catch (Socket_context::Inaccessible) { return 0; }
+}
+
+
 int Socket_plugin::close(Libc::File_descriptor *fd)
 {
 	Socket_context *context = dynamic_cast<Socket_context *>(fd->context);
@@ -36,6 +36,7 @@
 #include "vfs_plugin.h"
 #include "libc_init.h"
 #include "task.h"
+#include "kqueue.h"
 
 extern char **environ;
 
@@ -325,15 +326,16 @@ struct Libc::Pthreads
 };
 
 
-extern void (*libc_select_notify)();
-
 struct Libc::Io_response_handler : Vfs::Io_response_handler
 {
-	void handle_io_response(Vfs::Vfs_handle::Context *) override
+	void handle_io_response(Vfs::Vfs_handle::Context *context) override
 	{
-		/* some contexts may have been deblocked from select() */
-		if (libc_select_notify)
-			libc_select_notify();
+		/*
+		 * Some contexts may have been deblocked from select(). The VFS
+		 * plugin uses the plugin context of the file descriptor as handle
+		 * context.
+		 */
+		Libc::notify_io_event(reinterpret_cast<Libc::Plugin_context *>(context));
 
 		/* resume all as any context may have been deblocked from blocking I/O */
 		Libc::resume_all();
@@ -30,6 +30,7 @@
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <sys/disk.h>
+#include <sys/poll.h>
 #include <dlfcn.h>
 
 /* libc plugin interface */
@@ -194,6 +195,9 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags,
 	Libc::File_descriptor *fd =
 		Libc::file_descriptor_allocator()->alloc(this, vfs_context(handle), libc_fd);
 
+	/* identify the file descriptor in I/O responses of the handle */
+	handle->context = reinterpret_cast<Vfs::Vfs_handle::Context *>(fd->context);
+
 	fd->flags = flags & (O_NONBLOCK|O_APPEND);
 
 	if ((flags & O_TRUNC) && (ftruncate(fd, 0) == -1)) {
@@ -302,6 +306,75 @@ ssize_t Libc::Vfs_plugin::write(Libc::File_descriptor *fd, const void *buf,
 }
 
 
+ssize_t Libc::Vfs_plugin::writev(Libc::File_descriptor *fd,
+                                 const struct iovec *iov, int iovcnt)
+{
+	typedef Vfs::File_io_service::Write_result Result;
+	typedef Vfs::File_io_service::Write_chunk  Chunk;
+
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+
+	/*
+	 * The I/O vector is handed to the file system in batches of chunks. As
+	 * the file system may transfer less than a batch per call, e.g., one
+	 * packet, the remainder is submitted as long as progress is made.
+	 */
+	enum { MAX_CHUNKS = 64 };
+	Chunk chunks[MAX_CHUNKS];
+
+	ssize_t  total  = 0;
+	int      i      = 0;  /* first I/O-vector element not written completely */
+	::size_t offset = 0;  /* bytes of element 'i' written already */
+
+	while (i < iovcnt) {
+
+		unsigned num_chunks = 0;
+		for (int j = i; j < iovcnt && num_chunks < MAX_CHUNKS; j++) {
+
+			::size_t const skip = (j == i) ? offset : 0;
+
+			if (iov[j].iov_len > skip)
+				chunks[num_chunks++] = Chunk { (char const *)iov[j].iov_base + skip,
+				                               iov[j].iov_len - skip };
+		}
+
+		if (!num_chunks)
+			break;
+
+		Vfs::file_size out_count = 0;
+
+		Result const result = handle->fs().writev(handle, chunks, num_chunks, out_count);
+
+		/* report an error only if no data was transferred */
+		if (result != Result::WRITE_OK && total)
+			break;
+
+		switch (result) {
+		case Result::WRITE_ERR_AGAIN:       return Errno(EAGAIN);
+		case Result::WRITE_ERR_WOULD_BLOCK: return Errno(EWOULDBLOCK);
+		case Result::WRITE_ERR_INVALID:     return Errno(EINVAL);
+		case Result::WRITE_ERR_IO:          return Errno(EIO);
+		case Result::WRITE_ERR_INTERRUPT:   return Errno(EINTR);
+		case Result::WRITE_OK:              break;
+		}
+
+		if (!out_count)
+			break;
+
+		handle->advance_seek(out_count);
+		total += out_count;
+
+		/* skip the elements written completely */
+		::size_t left = offset + out_count;
+		for (; i < iovcnt && left >= iov[i].iov_len; i++)
+			left -= iov[i].iov_len;
+		offset = left;
+	}
+
+	return total;
+}
+
+
 typedef Vfs::File_io_service::Read_result Result;
 
 struct Read_check : Libc::Suspend_functor {
@@ -863,6 +936,30 @@ int Libc::Vfs_plugin::select(int nfds,
 	return nready;
 }
 
+int Libc::Vfs_plugin::ready_events(Libc::File_descriptor *fd, int events)
+{
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+	if (!handle) return 0;
+
+	int ready = 0;
+
+	if (events & POLLIN) {
+		if (handle->fs().read_ready(handle))
+			ready |= POLLIN;
+		else
+			/* the I/O response of the handle re-queues the knote */
+			handle->fs().notify_read_ready(handle);
+	}
+
+	if (events & POLLOUT)
+		ready |= POLLOUT; /* XXX always writeable */
+
+	/* XXX exceptions not supported */
+
+	return ready;
+}
+
+
 namespace Libc {
 
 	bool read_ready(Libc::File_descriptor *fd)
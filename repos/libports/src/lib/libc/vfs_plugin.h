@@ -140,9 +140,12 @@ class Libc::Vfs_plugin : public Libc::Plugin
 		int     symlink(const char *, const char *) override;
 		int     unlink(const char *) override;
 		ssize_t write(Libc::File_descriptor *, const void *, ::size_t ) override;
+		ssize_t writev(Libc::File_descriptor *, const struct iovec *, int) override;
 		void   *mmap(void *, ::size_t, int, int, Libc::File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
 		int     select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout) override;
+		int     ready_events(Libc::File_descriptor *, int) override;
+		bool    notifies_io_events() override { return true; }
 };
 
 #endif
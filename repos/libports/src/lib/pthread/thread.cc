@@ -18,6 +18,8 @@
 #include <base/thread.h>
 #include <os/timed_semaphore.h>
 #include <util/list.h>
+#include <util/string.h>
+#include <cpu/atomic.h>
 
 #include <errno.h>
 #include <pthread.h>
@@ -104,6 +106,182 @@ Pthread_registry &pthread_registry()
 }
 
 
+/*
+ * Each thread that sets a key owns a 'Key_slots' object, which holds the
+ * values of the thread in lazily allocated chunks of slots. The objects
+ * are found via a hash table indexed by the 'Thread' object of the
+ * calling thread. A 'Key_slots' object is modified by its owning thread
+ * only and never freed but recycled for other threads. Hence, accessing
+ * thread-specific data requires no lock.
+ *
+ * A slot is valid only if its generation matches the generation of the
+ * key, which is incremented on 'pthread_key_delete'. So, the slots of
+ * all threads need not be cleared when deleting a key.
+ */
+
+struct Key
+{
+	enum State { FREE, USED };
+
+	int      volatile state      = FREE;
+	unsigned volatile generation = 0;
+
+	void (* volatile destructor)(void *) = nullptr;
+};
+
+
+struct Key_slot
+{
+	void const *value;
+	unsigned    generation;
+};
+
+
+struct Key_slots
+{
+	enum {
+		KEYS_PER_CHUNK = 32,
+		NUM_CHUNKS     = (PTHREAD_KEYS_MAX + KEYS_PER_CHUNK - 1)/KEYS_PER_CHUNK,
+		NO_OWNER       = 0
+	};
+
+	addr_t     volatile owner;
+	Key_slots         *next = nullptr;  /* hash chain, never changes */
+	Key_slot          *chunks[NUM_CHUNKS] { };
+
+	Key_slots(addr_t owner) : owner(owner) { }
+
+	Key_slot *slot(pthread_key_t key)
+	{
+		Key_slot * const chunk = chunks[key / KEYS_PER_CHUNK];
+		return chunk ? &chunk[key % KEYS_PER_CHUNK] : nullptr;
+	}
+
+	Key_slot &alloc_slot(pthread_key_t key)
+	{
+		Key_slot *&chunk = chunks[key / KEYS_PER_CHUNK];
+		if (!chunk) {
+			chunk = (Key_slot *)env()->heap()->alloc(KEYS_PER_CHUNK*sizeof(Key_slot));
+			memset(chunk, 0, KEYS_PER_CHUNK*sizeof(Key_slot));
+		}
+		return chunk[key % KEYS_PER_CHUNK];
+	}
+
+	void clear()
+	{
+		for (unsigned i = 0; i < NUM_CHUNKS; i++)
+			if (chunks[i])
+				memset(chunks[i], 0, KEYS_PER_CHUNK*sizeof(Key_slot));
+	}
+};
+
+
+static Key keys[PTHREAD_KEYS_MAX];
+
+enum { NUM_KEY_SLOTS_BUCKETS = 64 };
+
+static Key_slots * volatile key_slots_buckets[NUM_KEY_SLOTS_BUCKETS];
+
+
+/*
+ * The 'Thread' objects of different threads lie at multiples of the
+ * stack size apart. So, the address bits are mixed to spread them.
+ */
+static Key_slots * volatile &key_slots_bucket(addr_t owner)
+{
+	unsigned long long const hash = owner * 0x9e3779b97f4a7c15ULL;
+	return key_slots_buckets[(hash >> 58) % NUM_KEY_SLOTS_BUCKETS];
+}
+
+
+static addr_t key_slots_owner(Thread const *thread)
+{
+	/* the main thread may run outside of the stack area */
+	return thread ? (addr_t)thread : 1;
+}
+
+
+static Key_slots *lookup_key_slots(addr_t owner)
+{
+	for (Key_slots *s = key_slots_bucket(owner); s; s = s->next)
+		if (s->owner == owner)
+			return s;
+
+	return nullptr;
+}
+
+
+static Key_slots &claim_key_slots(addr_t owner)
+{
+	if (Key_slots *s = lookup_key_slots(owner))
+		return *s;
+
+	Key_slots * volatile &bucket = key_slots_bucket(owner);
+
+	/* recycle slots released by another thread */
+	for (Key_slots *s = bucket; s; s = s->next) {
+		addr_t free = Key_slots::NO_OWNER;
+		if (s->owner == free &&
+		    __atomic_compare_exchange_n(&s->owner, &free, owner, false,
+		                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+			return *s;
+	}
+
+	Key_slots *s = new (env()->heap()) Key_slots(owner);
+
+	s->next = bucket;
+	while (!__atomic_compare_exchange_n(&bucket, &s->next, s, false,
+	                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+	return *s;
+}
+
+
+void release_key_slots(Thread const &thread)
+{
+	Key_slots *s = lookup_key_slots(key_slots_owner(&thread));
+	if (!s)
+		return;
+
+	s->clear();
+	__atomic_store_n(&s->owner, (addr_t)Key_slots::NO_OWNER, __ATOMIC_SEQ_CST);
+}
+
+
+/*
+ * Call the destructors of the non-NULL values of the calling thread
+ */
+static void call_key_destructors()
+{
+	Key_slots *slots = lookup_key_slots(key_slots_owner(Thread::myself()));
+	if (!slots)
+		return;
+
+	for (unsigned i = 0; i < PTHREAD_DESTRUCTOR_ITERATIONS; i++) {
+
+		bool called = false;
+
+		for (pthread_key_t k = 0; k < PTHREAD_KEYS_MAX; k++) {
+
+			Key_slot *slot = slots->slot(k);
+			if (!slot || !slot->value || slot->generation != keys[k].generation)
+				continue;
+
+			void (*destructor)(void *) = keys[k].destructor;
+			if (!destructor)
+				continue;
+
+			void *value = (void *)slot->value;
+			slot->value = nullptr;
+
+			destructor(value);
+			called = true;
+		}
+
+		if (!called)
+			return;
+	}
+}
+
 extern "C" {
 
 	/* Thread */
@@ -160,11 +338,79 @@ extern "C" {
 
 	void pthread_exit(void *value_ptr)
 	{
-		pthread_cancel(pthread_self());
+		call_key_destructors();
+
+		/* cleanup threads which tried to self-destruct */
+		pthread_cleanup();
+
+		pthread_t const myself = pthread_self();
+
+		{
+			Lock_guard<Lock> lock_guard(pthread_cleanup_list_lock);
+
+			myself->_exit_status = value_ptr;
+			myself->_exited      = true;
+
+			if (myself->_joiner)
+				myself->_joiner->unlock();
+			else
+				pthread_cleanup_list.insert(new (env()->heap()) thread_cleanup(myself));
+		}
+
 		sleep_forever();
 	}
 
 
+	int pthread_join(pthread_t thread, void **value_ptr)
+	{
+		if (pthread_equal(pthread_self(), thread))
+			return EDEADLK;
+
+		Lock exited(Lock::LOCKED);
+
+		{
+			Lock_guard<Lock> lock_guard(pthread_cleanup_list_lock);
+
+			if (!pthread_registry().contains(thread))
+				return ESRCH;
+
+			if (thread->_joiner)
+				return EINVAL;
+
+			/* reap thread that exited before being joined */
+			if (thread->_exited) {
+
+				for (thread_cleanup *t = pthread_cleanup_list.first(); t; t = t->next())
+					if (t->thread == thread) {
+						pthread_cleanup_list.remove(t);
+						t->thread = nullptr;
+						destroy(env()->heap(), t);
+						break;
+					}
+
+				if (value_ptr)
+					*value_ptr = thread->_exit_status;
+
+				destroy(env()->heap(), thread);
+				return 0;
+			}
+
+			thread->_joiner = &exited;
+		}
+
+		exited.lock();
+
+		/* the exiting thread releases the lock after waking us up */
+		Lock_guard<Lock> lock_guard(pthread_cleanup_list_lock);
+
+		if (value_ptr)
+			*value_ptr = thread->_exit_status;
+
+		destroy(env()->heap(), thread);
+		return 0;
+	}
+
+
 	/* special non-POSIX function (for example used in libresolv) */
 	int _pthread_main_np(void)
 	{
@@ -729,36 +975,15 @@ extern "C" {
 
 	/* TLS */
 
-
-	struct Key_element : List<Key_element>::Element
-	{
-		const void *thread_base;
-		const void *value;
-
-		Key_element(const void *thread_base, const void *value)
-		: thread_base(thread_base),
-		  value(value) { }
-	};
-
-
-	static Lock key_list_lock;
-	List<Key_element> key_list[PTHREAD_KEYS_MAX];
-
 	int pthread_key_create(pthread_key_t *key, void (*destructor)(void*))
 	{
 		if (!key)
 			return EINVAL;
 
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
-
 		for (int k = 0; k < PTHREAD_KEYS_MAX; k++) {
-			/*
-			 * Find an empty key slot and insert an element for the current
-			 * thread to mark the key slot as used.
-			 */
-			if (!key_list[k].first()) {
-				Key_element *key_element = new (env()->heap()) Key_element(Thread::myself(), 0);
-				key_list[k].insert(key_element);
+			if (keys[k].state == Key::FREE &&
+			    cmpxchg(&keys[k].state, Key::FREE, Key::USED)) {
+				keys[k].destructor = destructor;
 				*key = k;
 				return 0;
 			}
@@ -770,15 +995,13 @@ extern "C" {
 
 	int pthread_key_delete(pthread_key_t key)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX || !key_list[key].first())
+		if (key < 0 || key >= PTHREAD_KEYS_MAX || keys[key].state != Key::USED)
 			return EINVAL;
 
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
-
-		while (Key_element * element = key_list[key].first()) {
-			key_list[key].remove(element);
-			destroy(env()->heap(), element);
-		}
+		/* invalidate the values of all threads before freeing the key */
+		keys[key].destructor = nullptr;
+		__atomic_add_fetch(&keys[key].generation, 1, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&keys[key].state, (int)Key::FREE, __ATOMIC_SEQ_CST);
 
 		return 0;
 	}
@@ -786,23 +1009,14 @@ extern "C" {
 
 	int pthread_setspecific(pthread_key_t key, const void *value)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX)
+		if (key < 0 || key >= PTHREAD_KEYS_MAX || keys[key].state != Key::USED)
 			return EINVAL;
 
-		void *myself = Thread::myself();
+		Key_slots &slots = claim_key_slots(key_slots_owner(Thread::myself()));
 
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
-
-		for (Key_element *key_element = key_list[key].first(); key_element;
-		     key_element = key_element->next())
-			if (key_element->thread_base == myself) {
-				key_element->value = value;
-				return 0;
-			}
-
-		/* key element does not exist yet - create a new one */
-		Key_element *key_element = new (env()->heap()) Key_element(Thread::myself(), value);
-		key_list[key].insert(key_element);
+		Key_slot &slot = slots.alloc_slot(key);
+		slot.value      = value;
+		slot.generation = keys[key].generation;
 		return 0;
 	}
 
@@ -812,16 +1026,15 @@ extern "C" {
 		if (key < 0 || key >= PTHREAD_KEYS_MAX)
 			return nullptr;
 
-		void *myself = Thread::myself();
-
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
+		Key_slots *slots = lookup_key_slots(key_slots_owner(Thread::myself()));
+		if (!slots)
+			return nullptr;
 
-		for (Key_element *key_element = key_list[key].first(); key_element;
-		     key_element = key_element->next())
-			if (key_element->thread_base == myself)
-				return (void*)(key_element->value);
+		Key_slot const *slot = slots->slot(key);
+		if (!slot || slot->generation != keys[key].generation)
+			return nullptr;
 
-		return 0;
+		return (void*)(slot->value);
 	}
 
 
@@ -18,6 +18,9 @@
 
 #include <pthread.h>
 
+/* libc includes */
+#include <libc/allocator.h>
+
 /*
  * Used by 'pthread_self()' to find out if the current thread is an alien
  * thread.
@@ -43,6 +46,15 @@ class Pthread_registry
 Pthread_registry &pthread_registry();
 
 
+/**
+ * Drop the thread-specific data of 'thread'
+ *
+ * The values are not passed to the key destructors, which are called by
+ * 'pthread_exit' already.
+ */
+void release_key_slots(Genode::Thread const &thread);
+
+
 extern "C" {
 
 	struct pthread_attr
@@ -63,6 +75,16 @@ extern "C" {
 		void *(*_start_routine) (void *);
 		void *_arg;
 
+		/*
+		 * Exit state, protected by the lock of the cleanup list
+		 *
+		 * A thread that exits while being joined leaves the destruction of
+		 * its object to the joining thread.
+		 */
+		void         *_exit_status = nullptr;
+		bool          _exited      = false;
+		Genode::Lock *_joiner      = nullptr;
+
 		enum { WEIGHT = Genode::Cpu_session::Weight::DEFAULT_WEIGHT };
 
 		pthread(pthread_attr_t attr, void *(*start_routine) (void *),
@@ -95,6 +117,8 @@ extern "C" {
 
 		virtual ~pthread()
 		{
+			release_key_slots(*this);
+			Libc::release_malloc_cache(*this);
 			pthread_registry().remove(this);
 		}
 
@@ -0,0 +1,154 @@
+/*
+ * \brief  Test for vectored I/O: readv, writev, preadv, pwritev
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+static void check(bool cond, char const *what)
+{
+	if (cond)
+		return;
+
+	fprintf(stderr, "Error: %s\n", what);
+	exit(1);
+}
+
+
+static void check_size(ssize_t res, ssize_t expected, char const *what)
+{
+	if (res == expected)
+		return;
+
+	fprintf(stderr, "Error: %s returned %zd, expected %zd (errno=%d)\n",
+	        what, res, expected, errno);
+	exit(1);
+}
+
+
+static void check_offset(int fd, off_t expected, char const *what)
+{
+	off_t const offset = lseek(fd, 0, SEEK_CUR);
+	if (offset == expected)
+		return;
+
+	fprintf(stderr, "Error: offset after %s is %lld, expected %lld\n",
+	        what, (long long)offset, (long long)expected);
+	exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int const fd = open("/tmp/iov", O_CREAT | O_RDWR | O_TRUNC, 0644);
+	check(fd >= 0, "open");
+
+	/*
+	 * 'writev' gathers all elements, including empty ones, in order and
+	 * advances the file offset
+	 */
+	{
+		char a[] = "abc", b[] = "defgh", c[] = "ij";
+		struct iovec iov[] = {
+			{ a, 3 }, { nullptr, 0 }, { b, 5 }, { c, 2 } };
+
+		check_size(writev(fd, iov, 4), 10, "writev");
+		check_offset(fd, 10, "writev");
+	}
+
+	/* 'readv' scatters the file content across the elements */
+	{
+		char a[4] = { }, b[6] = { };
+		struct iovec iov[] = { { a, 4 }, { b, 6 } };
+
+		check(lseek(fd, 0, SEEK_SET) == 0, "lseek");
+		check_size(readv(fd, iov, 2), 10, "readv");
+		check(!memcmp(a, "abcd", 4) && !memcmp(b, "efghij", 6), "readv data");
+		check_offset(fd, 10, "readv");
+	}
+
+	/*
+	 * Partial transfer: 'readv' near the end of the file fills the leading
+	 * elements only and leaves the remaining ones untouched
+	 */
+	{
+		char a[4], b[4];
+		memset(a, '.', sizeof(a));
+		memset(b, '.', sizeof(b));
+		struct iovec iov[] = { { a, 4 }, { b, 4 } };
+
+		check(lseek(fd, 4, SEEK_SET) == 4, "lseek");
+		check_size(readv(fd, iov, 2), 6, "partial readv");
+		check(!memcmp(a, "efgh", 4) && !memcmp(b, "ij..", 4),
+		      "partial readv data");
+		check_offset(fd, 10, "partial readv");
+
+		check_size(readv(fd, iov, 2), 0, "readv at end of file");
+	}
+
+	/* 'pwritev' writes at the given offset and leaves the file offset */
+	{
+		char a[] = "XY", b[] = "Z";
+		struct iovec iov[] = { { a, 2 }, { b, 1 } };
+
+		check(lseek(fd, 1, SEEK_SET) == 1, "lseek");
+		check_size(pwritev(fd, iov, 2, 6), 3, "pwritev");
+		check_offset(fd, 1, "pwritev");
+
+		/* writing beyond the end of the file extends it */
+		check_size(pwritev(fd, iov, 2, 9), 3, "pwritev beyond end");
+		check_offset(fd, 1, "pwritev beyond end");
+		check(lseek(fd, 0, SEEK_END) == 12, "file size after pwritev");
+	}
+
+	/* 'preadv' reads at the given offset and leaves the file offset */
+	{
+		char a[3] = { }, b[20] = { };
+		struct iovec iov[] = { { a, 3 }, { b, sizeof(b) } };
+
+		check(lseek(fd, 2, SEEK_SET) == 2, "lseek");
+		check_size(preadv(fd, iov, 2, 0), 12, "preadv");
+		check(!memcmp(a, "abc", 3) && !memcmp(b, "defXYZXYZ", 9),
+		      "preadv data");
+		check_offset(fd, 2, "preadv");
+
+		check_size(preadv(fd, iov, 2, 11), 1, "partial preadv");
+		check(a[0] == 'Z', "partial preadv data");
+		check_size(preadv(fd, iov, 2, 12), 0, "preadv at end of file");
+	}
+
+	/* invalid vectors */
+	{
+		char a[1];
+		struct iovec iov[] = { { a, 1 } };
+
+		errno = 0;
+		check_size(readv(fd, iov, 0), -1, "readv without elements");
+		check(errno == EINVAL, "readv without elements sets EINVAL");
+
+		errno = 0;
+		check_size(writev(-1, iov, 1), -1, "writev to invalid fd");
+		check(errno == EBADF, "writev to invalid fd sets EBADF");
+	}
+
+	close(fd);
+
+	printf("--- test finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_iov
+LIBS   = posix
+SRC_CC = main.cc
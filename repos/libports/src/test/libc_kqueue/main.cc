@@ -0,0 +1,213 @@
+/*
+ * \brief  Test for kqueue/kevent and poll
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+static int kq;
+static int pipefd[2];
+
+static struct timespec const no_wait = { 0, 0 };
+
+
+static void check(bool cond, char const *what)
+{
+	if (cond)
+		return;
+
+	fprintf(stderr, "Error: %s\n", what);
+	exit(1);
+}
+
+
+/**
+ * Apply one change to the kqueue
+ *
+ * \return 0 on success, or errno value
+ */
+static int change(int fd, short filter, unsigned short flags)
+{
+	struct kevent kev;
+	EV_SET(&kev, fd, filter, flags, 0, 0, nullptr);
+
+	return kevent(kq, &kev, 1, nullptr, 0, &no_wait) == -1 ? errno : 0;
+}
+
+
+/**
+ * Return number of pending events, check that they refer to 'fd'
+ */
+static int pending(int fd)
+{
+	struct kevent events[4];
+	int const n = kevent(kq, nullptr, 0, events, 4, &no_wait);
+
+	check(n >= 0, "kevent failed");
+
+	for (int i = 0; i < n; i++)
+		check((int)events[i].ident == fd, "event of unexpected descriptor");
+
+	return n;
+}
+
+
+static void fill(size_t bytes)
+{
+	char buf[16] = { };
+	check(write(pipefd[1], buf, bytes) == (ssize_t)bytes, "write to pipe");
+}
+
+
+static void drain(size_t bytes)
+{
+	char buf[16];
+	check(read(pipefd[0], buf, bytes) == (ssize_t)bytes, "read from pipe");
+}
+
+
+static void test_level_triggered()
+{
+	int const fd = pipefd[0];
+
+	check(change(fd, EVFILT_READ, EV_ADD) == 0, "add knote");
+	check(pending(fd) == 0, "empty pipe is not readable");
+
+	fill(1);
+	check(pending(fd) == 1, "readable pipe is reported");
+	check(pending(fd) == 1, "readable pipe is reported again");
+
+	drain(1);
+	check(pending(fd) == 0, "drained pipe is not reported");
+
+	check(change(fd, EVFILT_READ, EV_DELETE) == 0, "delete knote");
+	printf("level triggered: ok\n");
+}
+
+
+static void test_clear()
+{
+	int const fd = pipefd[0];
+
+	check(change(fd, EVFILT_READ, EV_ADD | EV_CLEAR) == 0, "add EV_CLEAR knote");
+	check(pending(fd) == 0, "empty pipe is not readable");
+
+	fill(1);
+	check(pending(fd) == 1, "EV_CLEAR: write is reported");
+	check(pending(fd) == 0, "EV_CLEAR: state is reset after report");
+
+	fill(1);
+	check(pending(fd) == 1, "EV_CLEAR: next write is reported");
+
+	drain(2);
+	check(change(fd, EVFILT_READ, EV_DELETE) == 0, "delete EV_CLEAR knote");
+	printf("EV_CLEAR: ok\n");
+}
+
+
+static void test_oneshot()
+{
+	int const fd = pipefd[0];
+
+	fill(1);
+	check(change(fd, EVFILT_READ, EV_ADD | EV_ONESHOT) == 0, "add EV_ONESHOT knote");
+	check(pending(fd) == 1, "EV_ONESHOT: event is reported");
+	check(pending(fd) == 0, "EV_ONESHOT: event is reported only once");
+	check(change(fd, EVFILT_READ, EV_DELETE) == ENOENT,
+	      "EV_ONESHOT: knote is removed after report");
+
+	drain(1);
+	printf("EV_ONESHOT: ok\n");
+}
+
+
+static void test_dispatch()
+{
+	int const fd = pipefd[0];
+
+	fill(1);
+	check(change(fd, EVFILT_READ, EV_ADD | EV_DISPATCH) == 0, "add EV_DISPATCH knote");
+	check(pending(fd) == 1, "EV_DISPATCH: event is reported");
+	check(pending(fd) == 0, "EV_DISPATCH: knote is disabled after report");
+
+	check(change(fd, EVFILT_READ, EV_ENABLE) == 0, "enable EV_DISPATCH knote");
+	check(pending(fd) == 1, "EV_DISPATCH: event is reported after EV_ENABLE");
+
+	check(change(fd, EVFILT_READ, EV_DELETE) == 0,
+	      "EV_DISPATCH: disabled knote stays registered");
+
+	drain(1);
+	printf("EV_DISPATCH: ok\n");
+}
+
+
+static void test_poll_duplicate_fds()
+{
+	fill(1);
+
+	struct pollfd fds[] = {
+		{ pipefd[0], POLLIN,  0 },
+		{ pipefd[1], POLLOUT, 0 },
+		{ pipefd[0], POLLIN,  0 },
+	};
+
+	check(poll(fds, 3, 0) == 3, "poll: all entries are ready");
+	check(fds[0].revents == POLLIN,  "poll: first entry of descriptor");
+	check(fds[1].revents == POLLOUT, "poll: other descriptor");
+	check(fds[2].revents == POLLIN,  "poll: second entry of descriptor");
+
+	drain(1);
+	printf("poll with duplicate descriptors: ok\n");
+}
+
+
+static void test_close()
+{
+	int fds[2];
+	check(pipe(fds) == 0, "pipe");
+
+	check(change(fds[0], EVFILT_READ, EV_ADD) == 0, "add knote");
+	check(close(fds[0]) == 0 && close(fds[1]) == 0, "close");
+	check(change(fds[0], EVFILT_READ, EV_DELETE) == ENOENT,
+	      "knote is removed on close");
+
+	printf("close: ok\n");
+}
+
+
+int main(int argc, char *argv[])
+{
+	check(pipe(pipefd) == 0, "pipe");
+
+	kq = kqueue();
+	check(kq >= 0, "kqueue");
+
+	test_level_triggered();
+	test_clear();
+	test_oneshot();
+	test_dispatch();
+	test_poll_duplicate_fds();
+	test_close();
+
+	close(kq);
+
+	printf("--- test finished ---\n");
+	return 0;
+}
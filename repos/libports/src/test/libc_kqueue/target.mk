@@ -0,0 +1,3 @@
+TARGET = test-libc_kqueue
+LIBS   = posix libc_pipe
+SRC_CC = main.cc
@@ -0,0 +1,105 @@
+/*
+ * \brief  Benchmark of concurrent malloc and free
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Each thread performs the same number of allocations and deallocations of
+ * small objects. With perfect scaling, the aggregated throughput grows
+ * linearly with the number of threads until all CPUs are busy.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+enum {
+	MAX_THREADS = 8,
+	OPS         = 400000,   /* allocations per thread       */
+	WORKING_SET = 64,       /* live objects per thread      */
+	MAX_SIZE    = 512,      /* maximum object size in bytes */
+};
+
+
+static unsigned long now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000UL + ts.tv_nsec/1000000UL;
+}
+
+
+static void *thread_func(void *arg)
+{
+	unsigned long seed = (unsigned long)arg*2654435761UL + 1;
+	void *objects[WORKING_SET] = { };
+
+	for (unsigned i = 0; i < OPS; i++) {
+
+		seed = seed*6364136223846793005UL + 1442695040888963407UL;
+
+		unsigned const slot = (seed >> 33) % WORKING_SET;
+		size_t   const size = (seed >> 45) % MAX_SIZE + 1;
+
+		free(objects[slot]);
+
+		objects[slot] = malloc(size);
+		if (!objects[slot]) {
+			printf("Error: malloc of %zu bytes failed\n", size);
+			exit(-1);
+		}
+
+		/* touch the object like a real user would do */
+		memset(objects[slot], (int)i, size < 32 ? size : 32);
+	}
+
+	for (unsigned i = 0; i < WORKING_SET; i++)
+		free(objects[i]);
+
+	return nullptr;
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- malloc benchmark ---\n");
+
+	unsigned long single_ms = 0;
+
+	for (unsigned num = 1; num <= MAX_THREADS; num *= 2) {
+
+		pthread_t threads[MAX_THREADS];
+
+		unsigned long const start_ms = now_ms();
+
+		for (unsigned i = 0; i < num; i++)
+			if (pthread_create(&threads[i], 0, thread_func, (void *)(unsigned long)i)) {
+				printf("Error: could not create thread %u\n", i);
+				return -1;
+			}
+
+		for (unsigned i = 0; i < num; i++)
+			pthread_join(threads[i], 0);
+
+		unsigned long const ms = now_ms() - start_ms + 1;
+
+		if (num == 1)
+			single_ms = ms;
+
+		printf("threads: %u  time: %lu ms  throughput: %lu Kops/s  "
+		       "speedup: %lu.%02lu\n", num, ms, num*OPS/ms,
+		       num*single_ms/ms, (100*num*single_ms/ms) % 100);
+	}
+
+	printf("--- malloc benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_malloc
+SRC_CC = main.cc
+LIBS   = posix pthread
@@ -0,0 +1,234 @@
+/*
+ * \brief  Thread-specific data benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A growing number of threads concurrently read and write thread-specific
+ * data of a few shared keys. The benchmark reports the cost of a pair of
+ * 'pthread_getspecific' and 'pthread_setspecific' calls and checks that each
+ * thread sees its own values only and that the key destructors are called on
+ * thread exit. Once the workers are joined, a new thread must not see any
+ * value of its predecessors.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <trace/timestamp.h>
+
+/* libc includes */
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+
+
+enum { MAX_THREADS = 8, NUM_KEYS = 8, ITERATIONS = 100000 };
+
+
+static pthread_key_t keys[NUM_KEYS];
+
+
+struct Worker;
+
+
+/*
+ * Thread-specific value, which refers to the owning worker
+ */
+struct Value { Worker *worker; };
+
+
+struct Worker
+{
+	pthread_t thread;
+	sem_t     start;
+	sem_t     finished;
+	Value     values[NUM_KEYS];
+	unsigned  destructed = 0;
+	unsigned  errors     = 0;
+
+	Genode::Trace::Timestamp duration = 0;
+};
+
+
+/*
+ * Called on thread exit for each key with a non-NULL value
+ */
+static void destruct_value(void *value)
+{
+	Worker &worker = *((Value *)value)->worker;
+
+	if (++worker.destructed == NUM_KEYS)
+		sem_post(&worker.finished);
+}
+
+
+static void *worker_entry(void *arg)
+{
+	Worker &worker = *(Worker *)arg;
+
+	sem_wait(&worker.start);
+
+	for (unsigned i = 0; i < NUM_KEYS; i++) {
+		worker.values[i].worker = &worker;
+		if (pthread_setspecific(keys[i], &worker.values[i]))
+			worker.errors++;
+	}
+
+	Genode::Trace::Timestamp const start = Genode::Trace::timestamp();
+
+	for (unsigned n = 0; n < ITERATIONS; n++) {
+		pthread_key_t const key = keys[n % NUM_KEYS];
+
+		Value *value = (Value *)pthread_getspecific(key);
+		if (value != &worker.values[n % NUM_KEYS])
+			worker.errors++;
+
+		pthread_setspecific(key, value);
+	}
+
+	worker.duration = Genode::Trace::timestamp() - start;
+
+	/* the key destructors post 'finished' on return */
+	return nullptr;
+}
+
+
+static bool run(unsigned num_threads)
+{
+	static Worker workers[MAX_THREADS];
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		Worker &worker = workers[i];
+		worker = Worker();
+		sem_init(&worker.start, 0, 0);
+		sem_init(&worker.finished, 0, 0);
+
+		if (pthread_create(&worker.thread, 0, worker_entry, &worker)) {
+			printf("error: pthread_create() failed\n");
+			return false;
+		}
+	}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		sem_post(&workers[i].start);
+
+	Genode::Trace::Timestamp max_duration = 0;
+	unsigned errors = 0;
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		sem_wait(&workers[i].finished);
+
+		if (pthread_join(workers[i].thread, nullptr)) {
+			printf("error: pthread_join() failed\n");
+			return false;
+		}
+
+		if (workers[i].duration > max_duration)
+			max_duration = workers[i].duration;
+		errors += workers[i].errors;
+
+		sem_destroy(&workers[i].start);
+		sem_destroy(&workers[i].finished);
+	}
+
+	printf("%u thread(s): %llu cycles per get/set pair\n", num_threads,
+	       (unsigned long long)max_duration / ITERATIONS);
+
+	if (errors) {
+		printf("error: %u thread(s) observed %u foreign values\n",
+		       num_threads, errors);
+		return false;
+	}
+	return true;
+}
+
+
+/*
+ * Set one key and look at all others
+ *
+ * Setting the key lets the thread reuse the recycled thread-specific data of
+ * a joined worker.
+ */
+static void *fresh_thread_entry(void *)
+{
+	static Value value;
+	pthread_setspecific(keys[1], &value);
+
+	bool stale = false;
+	for (unsigned i = 0; i < NUM_KEYS; i++)
+		if (i != 1 && pthread_getspecific(keys[i]))
+			stale = true;
+
+	/* prevent the call of the key destructor, which expects a worker */
+	pthread_setspecific(keys[1], nullptr);
+
+	return stale ? (void *)1 : nullptr;
+}
+
+
+static bool check_fresh_thread()
+{
+	for (unsigned i = 0; i < MAX_THREADS; i++) {
+
+		pthread_t thread;
+		void     *stale = nullptr;
+
+		if (pthread_create(&thread, 0, fresh_thread_entry, nullptr)
+		 || pthread_join(thread, &stale)) {
+			printf("error: could not run fresh thread\n");
+			return false;
+		}
+
+		if (stale) {
+			printf("error: fresh thread sees values of a former thread\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(int, char **)
+{
+	printf("--- thread-specific data benchmark ---\n");
+
+	for (unsigned i = 0; i < NUM_KEYS; i++) {
+		if (pthread_key_create(&keys[i], destruct_value)) {
+			printf("error: pthread_key_create() failed\n");
+			return -1;
+		}
+	}
+
+	/* the main thread has values, too */
+	static Value main_value;
+	pthread_setspecific(keys[0], &main_value);
+
+	for (unsigned num_threads = 1; num_threads <= MAX_THREADS; num_threads *= 2)
+		if (!run(num_threads))
+			return -1;
+
+	if (!check_fresh_thread())
+		return -1;
+
+	if (pthread_getspecific(keys[0]) != &main_value) {
+		printf("error: main-thread value got lost\n");
+		return -1;
+	}
+
+	/* deleted keys must not reveal stale values when reused */
+	pthread_key_delete(keys[0]);
+	pthread_key_t key;
+	pthread_key_create(&key, nullptr);
+	if (pthread_getspecific(key)) {
+		printf("error: reused key has a stale value\n");
+		return -1;
+	}
+
+	printf("--- thread-specific data benchmark finished ---\n");
+	return 0;
+}
@@ -31,4 +31,36 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/*
+ * The following functions operate on a row of 'num' pixels. They yield
+ * the same results as the corresponding operations of 'Pixel_rgb565' and
+ * 'Pixel_rgb888' applied to each pixel, yet use vector instructions where
+ * available.
+ */
+
+/**
+ * Mix source pixels into destination pixels at the ratios given as alpha
+ * values
+ *
+ * Destination pixels with a corresponding alpha value of zero are left
+ * untouched.
+ */
+extern "C" void blend_rgb565(void const *src, unsigned char const *alpha,
+                             void *dst, int num);
+extern "C" void blend_rgb888(void const *src, unsigned char const *alpha,
+                             void *dst, int num);
+
+/**
+ * Copy source pixels except for those with a value of zero
+ */
+extern "C" void copy_masked_rgb565(void const *src, void *dst, int num);
+extern "C" void copy_masked_rgb888(void const *src, void *dst, int num);
+
+/**
+ * Convert pixels between the RGB565 and RGB888 formats
+ */
+extern "C" void convert_rgb565_to_rgb888(void const *src, void *dst, int num);
+extern "C" void convert_rgb888_to_rgb565(void const *src, void *dst, int num);
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
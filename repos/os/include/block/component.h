@@ -76,6 +76,7 @@ class Block::Session_component : public Block::Session_component_base,
 		bool                              _ack_queue_full;
 		Packet_descriptor                 _p_to_handle;
 		unsigned                          _p_in_fly;
+		unsigned                   const  _poll_iterations;
 
 		/**
 		 * Acknowledge a packet already handled
@@ -150,9 +151,9 @@ class Block::Session_component : public Block::Session_component_base,
 		}
 
 		/**
-		 * Called whenever a signal from the packet-stream interface triggered
+		 * Hand over available packets to the driver
 		 */
-		void _signal()
+		void _handle_packets()
 		{
 			/*
 			 * as long as more packets are available, and we're able to ack
@@ -166,6 +167,38 @@ class Block::Session_component : public Block::Session_component_base,
 				_handle_packet(tx_sink()->get_packet());
 		}
 
+		/**
+		 * Called whenever a signal from the packet-stream interface triggered
+		 */
+		void _signal()
+		{
+			_handle_packets();
+
+			if (!_poll_iterations)
+				return;
+
+			/*
+			 * Poll the submit queue for a bounded number of iterations
+			 * before falling back to signal-driven operation, so that the
+			 * client does not need to signal each burst of packets. The
+			 * bound is absolute, so steady traffic cannot starve the other
+			 * handlers of the entrypoint.
+			 */
+			tx_sink()->suppress_packet_avail();
+
+			for (unsigned i = 0; i < _poll_iterations; i++) {
+
+				if (_req_queue_full || _ack_queue_full)
+					break;
+
+				if (tx_sink()->packet_avail())
+					_handle_packets();
+			}
+
+			if (tx_sink()->resume_packet_avail())
+				_handle_packets();
+		}
+
 	public:
 
 		/**
@@ -174,18 +207,22 @@ class Block::Session_component : public Block::Session_component_base,
 		 * \param driver_factory  factory to create and destroy driver objects
 		 * \param ep              entrypoint handling this session component
 		 * \param buf_size        size of packet-stream payload buffer
+		 * \param poll_iterations maximum number of polls of the submit
+		 *                        queue before waiting for the next signal
 		 */
 		Session_component(Driver_factory     &driver_factory,
 		                  Genode::Entrypoint &ep,
 		                  Genode::Region_map &rm,
-		                  size_t              buf_size)
+		                  size_t              buf_size,
+		                  unsigned            poll_iterations = 0)
 		: Session_component_base(driver_factory, buf_size),
 		  Driver_session(rm, _rq_ds, ep.rpc_ep()),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
 		  _sink_ack(ep, *this, &Session_component::_signal),
 		  _sink_submit(ep, *this, &Session_component::_signal),
 		  _req_queue_full(false),
-		  _p_in_fly(0)
+		  _p_in_fly(0),
+		  _poll_iterations(poll_iterations)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
@@ -221,7 +258,7 @@ class Block::Session_component : public Block::Session_component_base,
 			}
 
 			/* resume packet processing */
-			_signal();
+			_handle_packets();
 		}
 
 
@@ -252,6 +289,7 @@ class Block::Root : public Genode::Root_component<Block::Session_component,
 		Driver_factory     &_driver_factory;
 		Genode::Entrypoint &_ep;
 		Genode::Region_map &_rm;
+		unsigned const      _poll_iterations;
 
 	protected:
 
@@ -284,7 +322,8 @@ class Block::Root : public Genode::Root_component<Block::Session_component,
 			}
 
 			return new (md_alloc()) Session_component(_driver_factory,
-			                                          _ep, _rm, tx_buf_size);
+			                                          _ep, _rm, tx_buf_size,
+			                                          _poll_iterations);
 		}
 
 	public:
@@ -296,14 +335,18 @@ class Block::Root : public Genode::Root_component<Block::Session_component,
 		 * \param md_alloc        allocator to allocate session components
 		 * \param rm              region map
 		 * \param driver_factory  factory to create and destroy driver backend
+		 * \param poll_iterations maximum number of polls of the submit
+		 *                        queue before waiting for the next signal
 		 */
 		Root(Genode::Entrypoint &ep,
 		     Allocator          &md_alloc,
 		     Genode::Region_map &rm,
-		     Driver_factory     &driver_factory)
+		     Driver_factory     &driver_factory,
+		     unsigned            poll_iterations = 0)
 		:
 			Root_component(ep, md_alloc),
-			_driver_factory(driver_factory), _ep(ep), _rm(rm)
+			_driver_factory(driver_factory), _ep(ep), _rm(rm),
+			_poll_iterations(poll_iterations)
 		{ }
 };
 
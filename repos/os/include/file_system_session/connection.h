@@ -44,16 +44,19 @@ struct File_system::Connection_base : Genode::Connection<Session>, Session_clien
 	                                          char     const *label,
 	                                          char     const *root,
 	                                          bool            writeable,
-	                                          size_t          tx_buf_size)
+	                                          size_t          tx_buf_size,
+	                                          unsigned        tx_queue_size)
 	{
 		return session(parent,
 		               "ram_quota=%ld, "
 		               "tx_buf_size=%ld, "
+		               "tx_queue_size=%u, "
 		               "label=\"%s\", "
 		               "root=\"%s\", "
 		               "writeable=%d",
-		               8*1024*sizeof(long) + tx_buf_size,
-		               tx_buf_size,
+		               8*1024*sizeof(long) + tx_buf_size
+		               + Session::queue_quota(tx_queue_size),
+		               tx_buf_size, tx_queue_size,
 		               label, root, writeable);
 	}
 
@@ -66,16 +69,20 @@ struct File_system::Connection_base : Genode::Connection<Session>, Session_clien
 	 * \param root             root directory of session
 	 * \param writeable        session is writable
 	 * \param tx_buf_size      size of transmission buffer in bytes
+	 * \param tx_queue_size    number of packets the server shall keep
+	 *                         in flight for the session
 	 */
 	Connection_base(Genode::Env             &env,
 	                Genode::Range_allocator &tx_block_alloc,
-	                char const              *label       = "",
-	                char const              *root        = "/",
-	                bool                     writeable   = true,
-	                size_t                   tx_buf_size = DEFAULT_TX_BUF_SIZE)
+	                char const              *label         = "",
+	                char const              *root          = "/",
+	                bool                     writeable     = true,
+	                size_t                   tx_buf_size   = DEFAULT_TX_BUF_SIZE,
+	                unsigned                 tx_queue_size = Session::TX_QUEUE_SIZE)
 	:
 		Genode::Connection<Session>(env, _session(env.parent(), label, root,
-		                                          writeable, tx_buf_size)),
+		                                          writeable, tx_buf_size,
+		                                          tx_queue_size)),
 		Session_client(cap(), tx_block_alloc, env.rm())
 	{ }
 
@@ -93,7 +100,8 @@ struct File_system::Connection_base : Genode::Connection<Session>, Session_clien
 	                bool                     writeable   = true) __attribute__((deprecated))
 	:
 		Genode::Connection<Session>(_session(*Genode::env_deprecated()->parent(), label,
-		                                     root, writeable, tx_buf_size)),
+		                                     root, writeable, tx_buf_size,
+		                                     Session::TX_QUEUE_SIZE)),
 		Session_client(cap(), tx_block_alloc, *Genode::env_deprecated()->rm_session())
 	{ }
 };
@@ -233,7 +233,32 @@ struct File_system::Directory_entry
 
 struct File_system::Session : public Genode::Session
 {
-	enum { TX_QUEUE_SIZE = 16 };
+	/*
+	 * The packet-descriptor queues shared with the server have a fixed size
+	 * of 'TX_QUEUE_SIZE' entries. Beyond that, a server may keep up to
+	 * 'tx_queue_size' packets of a session in flight and complete them out
+	 * of order. This depth is requested by the client as session argument.
+	 * Servers cap the request at 'MAX_TX_QUEUE_SIZE'.
+	 */
+	enum { TX_QUEUE_SIZE = 16, MAX_TX_QUEUE_SIZE = 256 };
+
+	/*
+	 * Server-side meta data per in-flight packet and per session for
+	 * allocating the in-flight packets from the session heap
+	 */
+	enum { PENDING_PACKET_QUOTA = sizeof(Packet_descriptor) + 2*sizeof(long),
+	       PENDING_ALLOC_QUOTA  = 2*4096 };
+
+	/**
+	 * Return session quota needed to keep 'queue_depth' packets in flight
+	 *
+	 * The quota is donated by the client on top of the transmission
+	 * buffer and charged by the server.
+	 */
+	static Genode::size_t queue_quota(unsigned queue_depth)
+	{
+		return queue_depth*PENDING_PACKET_QUOTA + PENDING_ALLOC_QUOTA;
+	}
 
 	typedef Genode::Packet_stream_policy<File_system::Packet_descriptor,
 	                                     TX_QUEUE_SIZE, TX_QUEUE_SIZE,
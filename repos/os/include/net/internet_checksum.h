@@ -0,0 +1,121 @@
+/*
+ * \brief  Computation of the Internet checksum (RFC 1071)
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NET__INTERNET_CHECKSUM_H_
+#define _NET__INTERNET_CHECKSUM_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+/* OS includes */
+#include <net/ipv4.h>
+#include <net/port.h>
+
+namespace Net {
+
+	class Internet_checksum_diff;
+
+	/**
+	 * Compute Internet checksum over 'size' bytes at 'data'
+	 *
+	 * \param seed  one's complement sum of further 16-bit words in host
+	 *              byte order that are covered by the checksum, e.g., of a
+	 *              pseudo header
+	 *
+	 * \return  checksum in host byte order
+	 *
+	 * The implementation is selected at build time and uses the widest
+	 * loads the target architecture supports, so the costs for large
+	 * payloads are dominated by memory bandwidth.
+	 */
+	Genode::uint16_t internet_checksum(void const       *data,
+	                                   Genode::size_t    size,
+	                                   Genode::uint32_t  seed = 0);
+
+	/**
+	 * Return checksum seed for the IPv4 pseudo header (RFC 793, RFC 768)
+	 */
+	inline Genode::uint32_t ipv4_pseudo_header_sum(Ipv4_address const &src,
+	                                               Ipv4_address const &dst,
+	                                               Genode::uint8_t     prot,
+	                                               Genode::size_t      size)
+	{
+		Genode::uint32_t sum = prot + (Genode::uint32_t)size;
+		for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i += 2) {
+			sum += (Genode::uint32_t)(src.addr[i] << 8 | src.addr[i + 1]);
+			sum += (Genode::uint32_t)(dst.addr[i] << 8 | dst.addr[i + 1]);
+		}
+		return sum;
+	}
+}
+
+
+/**
+ * Accumulated change of 16-bit words covered by an Internet checksum
+ *
+ * When header fields of a packet are rewritten, e.g., by network-address
+ * translation, the checksums that cover these fields can be adapted to the
+ * change incrementally (RFC 1624, equation 3) instead of being recomputed
+ * over the whole packet. All words are given in host byte order.
+ */
+class Net::Internet_checksum_diff
+{
+	private:
+
+		Genode::uint32_t _value = 0;
+
+		static Genode::uint16_t _word(Genode::uint8_t const *bytes) {
+			return (Genode::uint16_t)(bytes[0] << 8 | bytes[1]); }
+
+	public:
+
+		/**
+		 * Account for the change of a 16-bit word from 'old_word' to 'new_word'
+		 */
+		void add_up_diff(Genode::uint16_t new_word, Genode::uint16_t old_word)
+		{
+			_value += (Genode::uint16_t)~old_word;
+			_value += new_word;
+		}
+
+		void add_up_diff(Ipv4_address const &new_ip, Ipv4_address const &old_ip)
+		{
+			add_up_diff(_word(&new_ip.addr[0]), _word(&old_ip.addr[0]));
+			add_up_diff(_word(&new_ip.addr[2]), _word(&old_ip.addr[2]));
+		}
+
+		void add_up_diff(Port new_port, Port old_port) {
+			add_up_diff(new_port.value, old_port.value); }
+
+		void add_up_diff(Internet_checksum_diff const &icd)
+		{
+			_value += icd._value & 0xffff;
+			_value += icd._value >> 16;
+		}
+
+		/**
+		 * Return 'checksum' adapted to the accumulated change
+		 */
+		Genode::uint16_t apply_to(Genode::uint16_t checksum) const
+		{
+			Genode::uint32_t sum = (Genode::uint16_t)~checksum;
+			sum += _value & 0xffff;
+			sum += _value >> 16;
+			while (sum >> 16) {
+				sum = (sum & 0xffff) + (sum >> 16); }
+
+			return (Genode::uint16_t)~sum;
+		}
+};
+
+#endif /* _NET__INTERNET_CHECKSUM_H_ */
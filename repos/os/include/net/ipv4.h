@@ -33,6 +33,8 @@ namespace Net
 	class Ipv4_address_prefix;
 
 	class Ipv4_packet;
+
+	class Internet_checksum_diff;
 }
 
 
@@ -196,6 +198,14 @@ class Net::Ipv4_packet
 
 		void checksum(Genode::uint16_t checksum) { _header_checksum = host_to_big_endian(checksum); }
 
+		/**
+		 * Adapt header checksum to changed header fields (RFC 1624)
+		 *
+		 * This is an alternative to 'calculate_checksum' if only a few
+		 * header fields got rewritten.
+		 */
+		void update_checksum(Internet_checksum_diff const &icd);
+
 		void dst(Ipv4_address ip) { ip.copy(&_dst_addr); }
 		void src(Ipv4_address ip) { ip.copy(&_src_addr); }
 
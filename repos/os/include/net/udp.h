@@ -21,6 +21,7 @@
 #include <util/endian.h>
 #include <net/ethernet.h>
 #include <net/ipv4.h>
+#include <net/internet_checksum.h>
 
 namespace Net { class Udp_packet; }
 
@@ -117,43 +118,27 @@ class Net::Udp_packet
 		{
 			/* have to reset the checksum field for calculation */
 			_checksum = 0;
+			_checksum = host_to_big_endian(internet_checksum(this, length(),
+				ipv4_pseudo_header_sum(src, dst, IP_ID, length())));
+		}
+
+		/**
+		 * Adapt checksum to changed header fields or pseudo-header fields
+		 * (RFC 1624)
+		 *
+		 * In contrast to the full calculation, the costs do not depend on
+		 * the size of the payload.
+		 */
+		void update_checksum(Internet_checksum_diff const &icd)
+		{
+			/* a zero checksum denotes that no checksum was computed */
+			if (!_checksum) {
+				return; }
+
+			Genode::uint16_t const sum = icd.apply_to(checksum());
 
-			/*
-			 * sum up pseudo header
-			 */
-			Genode::uint32_t sum = 0;
-			for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i=i+2) {
-				Genode::uint16_t s = src.addr[i] << 8 | src.addr[i + 1];
-				Genode::uint16_t d = dst.addr[i] << 8 | dst.addr[i + 1];
-				sum += s + d;
-			}
-			Genode::uint8_t prot[] = { 0, IP_ID };
-			sum += host_to_big_endian(*(Genode::uint16_t*)&prot) + length();
-
-			/*
-			 * sum up udp packet itself
-			 */
-			unsigned max = (length() & 1) ? (length() - 1) : length();
-			Genode::uint16_t *udp = (Genode::uint16_t*) this;
-			for (unsigned i = 0; i < max; i=i+2)
-				sum += host_to_big_endian(*udp++);
-
-			/* if udp length is odd, append a zero byte */
-			if (length() & 1) {
-				Genode::uint8_t last[] =
-					{ *((Genode::uint8_t*)this + (length()-1)), 0 };
-				sum += host_to_big_endian(*(Genode::uint16_t*)&last);
-			}
-
-			/*
-			 * keep only the last 16 bits of the 32 bit calculated sum
-			 * and add the carries
-			 */
-			while (sum >> 16)
-				sum = (sum & 0xffff) + (sum >> 16);
-
-			/* one's complement of sum */
-			_checksum = host_to_big_endian((Genode::uint16_t) ~sum);
+			/* a computed zero checksum is transmitted as all ones */
+			_checksum = host_to_big_endian(sum ? sum : (Genode::uint16_t)0xffff);
 		}
 
 
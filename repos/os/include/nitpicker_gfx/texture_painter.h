@@ -75,9 +75,8 @@ struct Texture_painter
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
 		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		PT const *s;
+		PT       *d;
 
 		switch (mode) {
 
@@ -98,9 +97,7 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+				PT::mix_row(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
@@ -113,8 +110,7 @@ struct Texture_painter
 		case MASKED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					if (s->pixel) *d = *s;
+				PT::copy_masked_row(dst, src, clipped.w());
 			break;
 		}
 
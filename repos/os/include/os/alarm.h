@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__ALARM_H_
 
 #include <base/lock.h>
+#include <base/stdint.h>
 
 namespace Genode {
 	class Alarm_scheduler;
@@ -32,18 +33,22 @@ class Genode::Alarm
 
 		friend class Alarm_scheduler;
 
-		Lock             _dispatch_lock;  /* taken during handle method   */
-		Time             _deadline;       /* next deadline                */
-		Time             _period;         /* duration between alarms      */
-		int              _active;         /* set to one when active       */
-		Alarm           *_next;           /* next alarm in alarm list     */
-		Alarm_scheduler *_scheduler;      /* currently assigned scheduler */
+		Lock              _dispatch_lock;  /* taken during handle method   */
+		Time              _deadline;       /* next deadline                */
+		Time              _period;         /* duration between alarms      */
+		int               _active;         /* set to one when active       */
+		Alarm            *_next;           /* next alarm in slot list      */
+		Alarm           **_prev_next;      /* pointer referring to alarm   */
+		Genode::uint64_t  _key;            /* deadline on scheduler scale  */
+		unsigned          _level;          /* timing-wheel level           */
+		unsigned          _slot;           /* slot within level            */
+		Alarm_scheduler  *_scheduler;      /* currently assigned scheduler */
 
 		void _assign(Time period, Time deadline, Alarm_scheduler *scheduler) {
 			_period = period, _deadline = deadline, _scheduler = scheduler; }
 
 		void _reset() {
-			_assign(0, 0, 0), _active = 0, _next = 0; }
+			_assign(0, 0, 0), _active = 0, _next = 0, _prev_next = 0; }
 
 	protected:
 
@@ -64,13 +69,39 @@ class Genode::Alarm
 };
 
 
+/**
+ * Scheduler of alarms based on a hierarchical timing wheel
+ *
+ * Each level of the wheel consists of 'SLOTS' slots. An alarm is stored at
+ * the level of the most significant digit (of 'SLOT_BITS' bits) in which its
+ * deadline differs from the reference time of the wheel, in the slot that
+ * corresponds to the value of this digit. Hence, all alarms of a lower level
+ * are due before those of a higher level, and the earliest alarms reside in
+ * the first occupied slot of the lowest occupied level. This slot is
+ * redistributed to the lower levels once the reference time reaches the
+ * slot. Scheduling and discarding an alarm are O(1) operations, and each
+ * alarm is moved at most once per level.
+ */
 class Genode::Alarm_scheduler
 {
 	private:
 
-		Lock         _lock;   /* protect alarm list                     */
-		Alarm       *_head;   /* head of alarm list                     */
-		Alarm::Time  _now;    /* recent time (updated by handle method) */
+		enum {
+			SLOT_BITS = 6,
+			SLOTS     = 1 << SLOT_BITS,
+			LEVELS    = (64 + SLOT_BITS - 1) / SLOT_BITS,
+
+			/* pseudo level of alarms due before the reference time */
+			OVERDUE   = LEVELS,
+		};
+
+		Lock              _lock;         /* protect alarm wheel                */
+		Alarm::Time       _now;          /* recent time (updated by handle)    */
+		Genode::uint64_t  _time;         /* '_now' as monotonic 64-bit value   */
+		Genode::uint64_t  _wheel_time;   /* reference time, never after '_time' */
+		Alarm            *_overdue;      /* alarms due before '_wheel_time'    */
+		Genode::uint64_t  _occupied[LEVELS];
+		Alarm            *_slots[LEVELS][SLOTS];
 
 		/**
 		 * Enqueue alarm into alarm queue
@@ -84,6 +115,28 @@ class Genode::Alarm_scheduler
 		 */
 		void _unsynchronized_dequeue(Alarm *alarm);
 
+		/**
+		 * Insert alarm into the slot that corresponds to its key
+		 */
+		void _insert(Alarm &alarm);
+
+		/**
+		 * Remove alarm from its slot
+		 */
+		void _remove(Alarm &alarm);
+
+		/**
+		 * Determine lowest occupied level
+		 *
+		 * \return  level or 'LEVELS' if the wheel is empty
+		 */
+		unsigned _first_level() const;
+
+		/**
+		 * Return key of the begin of 'slot' at 'level'
+		 */
+		Genode::uint64_t _slot_key(unsigned level, unsigned slot) const;
+
 		/**
 		 * Dequeue next pending alarm from alarm list
 		 *
@@ -99,7 +152,7 @@ class Genode::Alarm_scheduler
 
 	public:
 
-		Alarm_scheduler() : _head(0), _now(0) { }
+		Alarm_scheduler();
 		~Alarm_scheduler();
 
 		/**
@@ -136,6 +189,11 @@ class Genode::Alarm_scheduler
 		 *
 		 * \param deadline  out parameter for storing the next deadline
 		 * \return          true if an alarm is scheduled
+		 *
+		 * If the next alarm does not reside at the lowest level of the
+		 * timing wheel yet, the returned deadline is the begin of its slot,
+		 * which is a lower bound of the actual deadline. Calling 'handle' at
+		 * this time moves the alarm closer to the lowest level.
 		 */
 		bool next_deadline(Alarm::Time *deadline);
 
@@ -144,8 +202,11 @@ class Genode::Alarm_scheduler
 		 *
 		 * \param alarm  alarm object
 		 * \return true if alarm is head element of timeout queue
+		 *
+		 * The result is also true for other alarms that share the slot of
+		 * the head element.
 		 */
-		bool head_timeout(const Alarm * alarm) { return _head == alarm; }
+		bool head_timeout(const Alarm * alarm);
 };
 
 #endif /* _INCLUDE__OS__ALARM_H_ */
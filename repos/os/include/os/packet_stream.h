@@ -61,6 +61,13 @@
  * acknowledge buffers using the methods 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * Under high load, a sink (or a source regarding the acknowledgement queue)
+ * may prefer to poll the queue for a while instead of being woken up by a
+ * signal for each burst of packets. It can announce this via
+ * 'suppress_packet_avail' (or 'suppress_ack_avail'), and should re-enable
+ * the signals via 'resume_packet_avail' (or 'resume_ack_avail') before
+ * going to sleep.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
  */
@@ -81,6 +88,7 @@
 #include <dataspace/client.h>
 #include <util/string.h>
 #include <util/construct_at.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode {
 
@@ -150,15 +158,92 @@ class Genode::Packet_descriptor
  * Ring buffer shared between source and sink, containing packet descriptors
  *
  * This class is private to the packet-stream interface.
+ *
+ * The queue is a single-producer/single-consumer ring. The head index is
+ * written by the producer only, the tail index by the consumer only. Each
+ * index is read by the respective other party, which synchronizes with the
+ * writer via a memory barrier between the access of the queue slots and the
+ * update of the index. Both indices reside in distinct cache lines to avoid
+ * false sharing between source and sink.
+ *
+ * The consumer controls when the producer has to notify it about newly
+ * queued elements. By default, a notification is due whenever the queue
+ * turns from empty to non-empty. Alternatively, the consumer may announce
+ * that it polls the queue and does not want to be notified at all, or that
+ * it wants to be notified not before the element at a given queue index got
+ * published (similar to the event index of virtio rings). The notification
+ * state is part of the shared consumer cache line and written by the
+ * consumer only.
  */
 template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
 class Genode::Packet_descriptor_queue
 {
 	private:
 
-		unsigned          _head;
-		unsigned          _tail;
-		PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
+		enum { CACHE_LINE_SIZE = 64 };
+
+		enum Notify_mode { NOTIFY_ON_NON_EMPTY, NOTIFY_AT_INDEX, NOTIFY_NEVER };
+
+		unsigned volatile _head __attribute__((aligned(CACHE_LINE_SIZE)));
+		unsigned volatile _tail __attribute__((aligned(CACHE_LINE_SIZE)));
+		unsigned volatile _notify_mode;
+		unsigned volatile _notify_idx;
+
+		PACKET_DESCRIPTOR _queue[QUEUE_SIZE]
+			__attribute__((aligned(CACHE_LINE_SIZE)));
+
+		static unsigned _next(unsigned idx, unsigned n = 1) {
+			return (idx + n)%QUEUE_SIZE; }
+
+		/**
+		 * Return number of queued elements for the given index pair
+		 */
+		static unsigned _used(unsigned head, unsigned tail) {
+			return (head >= tail) ? head - tail : QUEUE_SIZE - tail + head; }
+
+		/**
+		 * Order prior stores before subsequent loads
+		 *
+		 * The notification handshake relies on both parties seeing each
+		 * other's stores: the consumer updates the notification mode and
+		 * then inspects the queue, the producer updates the head and then
+		 * inspects the notification mode. A compiler barrier does not
+		 * prevent the CPU from reordering a store with a later load, which
+		 * would let both parties miss each other.
+		 */
+		static void _full_fence() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+		void _notify(Notify_mode mode, unsigned idx)
+		{
+			_notify_idx  = idx;
+			_notify_mode = mode;
+			_full_fence();
+		}
+
+		/**
+		 * Read index written by the other party
+		 *
+		 * The barrier orders the subsequent accesses of queue slots after
+		 * the read of the index (acquire semantics).
+		 */
+		static unsigned _acquire(unsigned volatile const &idx)
+		{
+			unsigned const value = idx;
+			memory_barrier();
+			return value;
+		}
+
+		/**
+		 * Publish index to the other party
+		 *
+		 * The barrier orders all prior accesses of queue slots before the
+		 * update of the index (release semantics).
+		 */
+		static void _release(unsigned volatile &idx, unsigned value)
+		{
+			memory_barrier();
+			idx = value;
+		}
 
 	public:
 
@@ -177,10 +262,12 @@ class Genode::Packet_descriptor_queue
 		Packet_descriptor_queue(Role role)
 		{
 			if (role == PRODUCER) {
-				_head = 0;
 				Genode::memset(_queue, 0, sizeof(_queue));
-			} else
-				_tail = 0;
+				_release(_head, 0);
+			} else {
+				_notify(NOTIFY_ON_NON_EMPTY, 0);
+				_release(_tail, 0);
+			}
 		}
 
 		/**
@@ -189,13 +276,29 @@ class Genode::Packet_descriptor_queue
 		 * \return true on success, or
 		 *         false if queue is full
 		 */
-		bool add(PACKET_DESCRIPTOR packet)
+		bool add(PACKET_DESCRIPTOR packet) { return add(&packet, 1) == 1; }
+
+		/**
+		 * Place up to 'num' packet descriptors into queue
+		 *
+		 * All added descriptors become visible to the consumer at once by a
+		 * single update of the head index.
+		 *
+		 * \return number of added packet descriptors
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned num)
 		{
-			if (full()) return false;
+			unsigned const head = _head;
+			unsigned const free = QUEUE_SIZE - 1 - _used(head, _acquire(_tail));
+			unsigned const cnt  = num < free ? num : free;
+
+			for (unsigned i = 0; i < cnt; i++)
+				_queue[_next(head, i)] = packets[i];
+
+			if (cnt)
+				_release(_head, _next(head, cnt));
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
-			return true;
+			return cnt;
 		}
 
 		/**
@@ -205,46 +308,118 @@ class Genode::Packet_descriptor_queue
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			PACKET_DESCRIPTOR packet;
+			get(&packet, 1);
 			return packet;
 		}
 
+		/**
+		 * Take up to 'max' packet descriptors from queue
+		 *
+		 * The slots of all taken descriptors are handed back to the producer
+		 * at once by a single update of the tail index.
+		 *
+		 * \return number of taken packet descriptors
+		 */
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned max)
+		{
+			unsigned const tail = _tail;
+			unsigned const used = _used(_acquire(_head), tail);
+			unsigned const cnt  = max < used ? max : used;
+
+			for (unsigned i = 0; i < cnt; i++)
+				packets[i] = _queue[_next(tail, i)];
+
+			if (cnt)
+				_release(_tail, _next(tail, cnt));
+
+			return cnt;
+		}
+
 		/**
 		 * Return current packet descriptor
 		 */
 		PACKET_DESCRIPTOR peek() const
 		{
-			return _queue[_tail%QUEUE_SIZE];
+			unsigned const tail = _tail;
+			_acquire(_head);
+			return _queue[tail];
 		}
 
+		/**
+		 * Return number of elements stored in the queue
+		 */
+		unsigned used() const { return _used(_head, _tail); }
+
 		/**
 		 * Return true if packet-descriptor queue is empty
 		 */
-		bool empty() { return _tail == _head; }
+		bool empty() const { return used() == 0; }
 
 		/**
 		 * Return true if packet-descriptor queue is full
 		 */
-		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
+		bool full() const { return used() == QUEUE_SIZE - 1; }
 
 		/**
 		 * Return true if a single element is stored in the queue
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
-
+		bool single_element() const { return used() == 1; }
 
 		/**
 		 * Return true if a single slot is left to be put into the queue
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		bool single_slot_free() const { return slots_free() == 1; }
 
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free() const { return QUEUE_SIZE - 1 - used(); }
+
+		/**
+		 * Return true if the consumer must be notified about the 'cnt'
+		 * elements just added by the producer
+		 *
+		 * The notification state is controlled by the other party.
+		 * Hence, unknown modes fall back to the default behaviour.
+		 */
+		bool notification_required(unsigned cnt) const
+		{
+			_full_fence();
+
+			unsigned const head = _head;
+
+			switch (_notify_mode) {
+			case NOTIFY_NEVER:
+				return false;
+			case NOTIFY_AT_INDEX:
+				/* notify if the event index lies within the added elements */
+				return _used(head, _notify_idx%QUEUE_SIZE) - 1 < cnt;
+			default:
+				return used() == cnt;
+			}
+		}
+
+		/**
+		 * Consumer: request notification whenever the queue becomes non-empty
+		 */
+		void notify_on_non_empty() { _notify(NOTIFY_ON_NON_EMPTY, 0); }
+
+		/**
+		 * Consumer: request notification not before 'n' elements are queued
+		 */
+		void notify_after(unsigned n)
+		{
+			if (n < 1)              n = 1;
+			if (n > QUEUE_SIZE - 1) n = QUEUE_SIZE - 1;
+
+			_notify(NOTIFY_AT_INDEX, _next(_tail, n - 1));
+		}
+
+		/**
+		 * Consumer: suppress notifications while polling the queue
+		 */
+		void notify_never() { _notify(NOTIFY_NEVER, 0); }
 };
 
 
@@ -266,9 +441,16 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready;
 
+		/*
+		 * The lock serializes transmitting threads of the same side only,
+		 * which is required because the queue supports a single producer.
+		 * It is never contended by the receiving side.
+		 */
 		Genode::Lock _tx_queue_lock;
 		TX_QUEUE    *_tx_queue;
 
+		typedef typename TX_QUEUE::Packet_descriptor Packet_descriptor;
+
 	public:
 
 		/**
@@ -303,17 +485,24 @@ class Genode::Packet_descriptor_transmitter
 				_rx_ready.submit();
 		}
 
-		bool ready_for_tx()
-		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
-			return !_tx_queue->full();
-		}
+		bool ready_for_tx() { return !_tx_queue->full(); }
+
+		void tx(Packet_descriptor packet) { tx(&packet, 1); }
 
-		void tx(typename TX_QUEUE::Packet_descriptor packet)
+		/**
+		 * Transmit 'num' packet descriptors
+		 *
+		 * The packets are published in as few batches as the free queue
+		 * space permits. The receiver is signalled at most once per batch,
+		 * namely if the batch turned the queue from empty to non-empty.
+		 * The method blocks until all packets are placed into the queue.
+		 */
+		void tx(Packet_descriptor const *packets, unsigned num)
 		{
 			Genode::Lock::Guard lock_guard(_tx_queue_lock);
 
-			do {
+			while (num) {
+
 				/* block for signal if tx queue is full */
 				if (_tx_queue->full())
 					_tx_ready.wait_for_signal();
@@ -323,11 +512,16 @@ class Genode::Packet_descriptor_transmitter
 				 * current queue situation. Therefore, we need to double check
 				 * if the queue insertion succeeds and retry if needed.
 				 */
+				unsigned const cnt = _tx_queue->add(packets, num);
+				if (!cnt)
+					continue;
 
-			} while (_tx_queue->add(packet) == false);
+				if (_tx_queue->notification_required(cnt))
+					_rx_ready.submit();
 
-			if (_tx_queue->single_element())
-				_rx_ready.submit();
+				packets += cnt;
+				num     -= cnt;
+			}
 		}
 
 		/**
@@ -355,8 +549,28 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter        _tx_ready;
 
-		Genode::Lock mutable  _rx_queue_lock;
-		RX_QUEUE             *_rx_queue;
+		/*
+		 * The lock serializes receiving threads of the same side only,
+		 * which is required because the queue supports a single consumer.
+		 */
+		Genode::Lock  _rx_queue_lock;
+		RX_QUEUE     *_rx_queue;
+
+		typedef typename RX_QUEUE::Packet_descriptor Packet_descriptor;
+
+		/**
+		 * Take up to 'max' packets from the queue and signal the transmitter
+		 * if the queue was full before
+		 */
+		unsigned _rx(Packet_descriptor *packets, unsigned max)
+		{
+			unsigned const cnt = _rx_queue->get(packets, max);
+
+			if (cnt && _rx_queue->slots_free() == cnt)
+				_tx_ready.submit();
+
+			return cnt;
+		}
 
 	public:
 
@@ -392,29 +606,53 @@ class Genode::Packet_descriptor_receiver
 				_tx_ready.submit();
 		}
 
-		bool ready_for_rx()
-		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
-			return !_rx_queue->empty();
-		}
+		bool ready_for_rx() { return !_rx_queue->empty(); }
 
-		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
+		void rx(Packet_descriptor *out_packet)
 		{
 			Genode::Lock::Guard lock_guard(_rx_queue_lock);
 
 			while (_rx_queue->empty())
 				_rx_ready.wait_for_signal();
 
-			*out_packet = _rx_queue->get();
-
-			if (_rx_queue->single_slot_free())
-				_tx_ready.submit();
+			_rx(out_packet, 1);
 		}
 
-		typename RX_QUEUE::Packet_descriptor rx_peek() const
+		/**
+		 * Receive up to 'max' packet descriptors without blocking
+		 *
+		 * \return number of received packet descriptors
+		 */
+		unsigned rx(Packet_descriptor *packets, unsigned max)
 		{
 			Genode::Lock::Guard lock_guard(_rx_queue_lock);
-			return _rx_queue->peek();
+			return _rx(packets, max);
+		}
+
+		Packet_descriptor rx_peek() const { return _rx_queue->peek(); }
+
+		/**
+		 * Suppress ready-to-receive signals while polling the queue
+		 */
+		void suppress_rx_ready() { _rx_queue->notify_never(); }
+
+		/**
+		 * Defer the next ready-to-receive signal until 'n' packets are queued
+		 */
+		void defer_rx_ready(unsigned n) { _rx_queue->notify_after(n); }
+
+		/**
+		 * Re-enable ready-to-receive signals
+		 *
+		 * \return true if packets got queued while signals were suppressed
+		 *
+		 * The caller must handle pending packets if true is returned because
+		 * the transmitter may have skipped the signal for them.
+		 */
+		bool resume_rx_ready()
+		{
+			_rx_queue->notify_on_non_empty();
+			return !_rx_queue->empty();
 		}
 };
 
@@ -689,6 +927,19 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * In contrast to calling 'submit_packet' for each packet, the whole
+		 * batch is published to the sink with a single queue-index update
+		 * and at most one 'packet_avail' signal. The method blocks if the
+		 * submit queue cannot take all packets at once.
+		 */
+		void submit_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_submit_transmitter.tx(packets, num);
+		}
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -704,6 +955,39 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' acknowledged packets
+		 *
+		 * This method does not block.
+		 *
+		 * \return number of packets stored at 'packets'
+		 */
+		unsigned get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.rx(packets, max);
+		}
+
+		/**
+		 * Ask the sink not to deliver 'ack_avail' signals
+		 *
+		 * This is useful while the source polls the acknowledgement queue.
+		 */
+		void suppress_ack_avail() { _ack_receiver.suppress_rx_ready(); }
+
+		/**
+		 * Ask the sink to deliver the next 'ack_avail' signal not before
+		 * 'n' acknowledgements are queued
+		 */
+		void defer_ack_avail(unsigned n) { _ack_receiver.defer_rx_ready(n); }
+
+		/**
+		 * Re-enable 'ack_avail' signals
+		 *
+		 * \return true if acknowledgements are pending, which must be
+		 *         handled by the caller
+		 */
+		bool resume_ack_avail() { return _ack_receiver.resume_rx_ready(); }
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -822,6 +1106,39 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' packets from source
+		 *
+		 * This method does not block.
+		 *
+		 * \return number of packets stored at 'packets'
+		 */
+		unsigned get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _submit_receiver.rx(packets, max);
+		}
+
+		/**
+		 * Ask the source not to deliver 'packet_avail' signals
+		 *
+		 * This is useful while the sink polls the submit queue.
+		 */
+		void suppress_packet_avail() { _submit_receiver.suppress_rx_ready(); }
+
+		/**
+		 * Ask the source to deliver the next 'packet_avail' signal not
+		 * before 'n' packets are queued
+		 */
+		void defer_packet_avail(unsigned n) { _submit_receiver.defer_rx_ready(n); }
+
+		/**
+		 * Re-enable 'packet_avail' signals
+		 *
+		 * \return true if packets are pending, which must be handled by the
+		 *         caller
+		 */
+		bool resume_packet_avail() { return _submit_receiver.resume_rx_ready(); }
+
 		/**
 		 * Return but do not dequeue next packet
 		 *
@@ -866,6 +1183,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets at once
+		 *
+		 * The batch is published with a single queue-index update and at
+		 * most one 'ack_avail' signal. This method blocks if the
+		 * acknowledgement queue cannot take all packets at once.
+		 */
+		void acknowledge_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_ack_transmitter.tx(packets, num);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB565_H_
 
 #include <os/pixel_rgba.h>
+#include <blit/blit.h>
 
 namespace Genode {
 
@@ -56,6 +57,18 @@ namespace Genode {
 		res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+	template <>
+	inline void Pixel_rgb565::mix_row(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                                  unsigned char const *alpha, int num) {
+		blend_rgb565(src, alpha, dst, num); }
+
+
+	template <>
+	inline void Pixel_rgb565::copy_masked_row(Pixel_rgb565 *dst,
+	                                          Pixel_rgb565 const *src, int num) {
+		copy_masked_rgb565(src, dst, num); }
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB565_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB888_H_
 
 #include <os/pixel_rgba.h>
+#include <blit/blit.h>
 
 namespace Genode {
 
@@ -40,6 +41,18 @@ namespace Genode {
 		res.pixel = blend(p1, 255 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+	template <>
+	inline void Pixel_rgb888::mix_row(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                                  unsigned char const *alpha, int num) {
+		blend_rgb888(src, alpha, dst, num); }
+
+
+	template <>
+	inline void Pixel_rgb888::copy_masked_row(Pixel_rgb888 *dst,
+	                                          Pixel_rgb888 const *src, int num) {
+		copy_masked_rgb888(src, dst, num); }
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB888_H_ */
@@ -121,6 +121,53 @@ class Genode::Pixel_rgba
 		 */
 		int alpha();
 
+		/**
+		 * Mix row of 'num' pixels of 'src' into 'dst' at the ratios
+		 * specified by 'alpha'
+		 *
+		 * Destination pixels with an alpha value of zero are left
+		 * untouched. Pixel formats may provide a vectorized version.
+		 */
+		static inline void mix_row(Pixel_rgba *dst, Pixel_rgba const *src,
+		                           unsigned char const *alpha, int num);
+
+		/**
+		 * Copy row of 'num' pixels except for pixels with a value of zero
+		 */
+		static inline void copy_masked_row(Pixel_rgba *dst,
+		                                   Pixel_rgba const *src, int num);
+
 } __attribute__((packed));
 
+
+template <typename ST, Genode::Surface_base::Pixel_format FORMAT,
+          int R_MASK, int R_SHIFT,
+          int G_MASK, int G_SHIFT,
+          int B_MASK, int B_SHIFT,
+          int A_MASK, int A_SHIFT>
+void Genode::Pixel_rgba<ST, FORMAT, R_MASK, R_SHIFT, G_MASK, G_SHIFT,
+                        B_MASK, B_SHIFT, A_MASK, A_SHIFT>::
+mix_row(Pixel_rgba *dst, Pixel_rgba const *src, unsigned char const *alpha,
+        int num)
+{
+	for (int i = 0; i < num; i++)
+		if (alpha[i])
+			dst[i] = mix(dst[i], src[i], alpha[i]);
+}
+
+
+template <typename ST, Genode::Surface_base::Pixel_format FORMAT,
+          int R_MASK, int R_SHIFT,
+          int G_MASK, int G_SHIFT,
+          int B_MASK, int B_SHIFT,
+          int A_MASK, int A_SHIFT>
+void Genode::Pixel_rgba<ST, FORMAT, R_MASK, R_SHIFT, G_MASK, G_SHIFT,
+                        B_MASK, B_SHIFT, A_MASK, A_SHIFT>::
+copy_masked_row(Pixel_rgba *dst, Pixel_rgba const *src, int num)
+{
+	for (int i = 0; i < num; i++)
+		if (src[i].pixel)
+			dst[i] = src[i];
+}
+
 #endif /* _INCLUDE__OS__PIXEL_RGBA_H_ */
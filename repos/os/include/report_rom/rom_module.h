@@ -16,6 +16,8 @@
 
 /* Genode includes */
 #include <util/reconstructible.h>
+#include <util/string.h>
+#include <base/allocator.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
 
@@ -24,6 +26,7 @@ namespace Rom {
 	using Genode::Constructible;
 	using Genode::Attached_ram_dataspace;
 
+	class Snapshot;
 	class Module;
 	class Readable_module;
 	class Registry;
@@ -50,6 +53,82 @@ struct Rom::Reader : Reader_list::Element
 };
 
 
+/**
+ * Version of the content of a ROM module
+ *
+ * ROM sessions that share the content with other readers hand out the
+ * snapshot's dataspace directly and keep a reference to the snapshot as long
+ * as the client may use it. Such a snapshot is immutable. Hence, a content
+ * change allocates a new snapshot unless the current one is referenced by
+ * the module only and is large enough to hold the new content. The snapshot
+ * is freed once it is neither the current version of its module nor
+ * referenced by any ROM session.
+ */
+class Rom::Snapshot : Genode::Noncopyable
+{
+	private:
+
+		friend class Module;
+
+		/*
+		 * The dataspace contains the content followed by a terminating zero.
+		 */
+		Attached_ram_dataspace _ds;
+
+		size_t        _size    = 0;
+		unsigned long _version = 0;
+
+		unsigned _ref_cnt = 0;
+
+		Snapshot(Genode::Ram_session &ram, Genode::Region_map &rm,
+		         char const *src, size_t len, unsigned long version)
+		:
+			_ds(ram, rm, len + 1)
+		{
+			_assign(src, len, version);
+		}
+
+		/**
+		 * Replace content, must not be called while referenced by sessions
+		 */
+		void _assign(char const *src, size_t len, unsigned long version)
+		{
+			Genode::memcpy(_ds.local_addr<char>(), src, len);
+			_ds.local_addr<char>()[len] = 0;
+
+			_size    = len;
+			_version = version;
+		}
+
+		/**
+		 * Return maximum content size, excluding the terminating zero
+		 */
+		size_t _capacity() const { return _ds.size() - 1; }
+
+		bool _equals(char const *src, size_t len) const
+		{
+			return len == _size
+			    && Genode::memcmp(_ds.local_addr<char const>(), src, len) == 0;
+		}
+
+	public:
+
+		Genode::Ram_dataspace_capability cap() const { return _ds.cap(); }
+
+		/**
+		 * Return size of the content, excluding the terminating zero
+		 */
+		size_t size() const { return _size; }
+
+		/**
+		 * Return version number, which is unique within the module
+		 */
+		unsigned long version() const { return _version; }
+
+		char const *content() const { return _ds.local_addr<char const>(); }
+};
+
+
 struct Rom::Readable_module
 {
 	/**
@@ -68,6 +147,25 @@ struct Rom::Readable_module
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Return version of the content as readable by 'reader'
+	 *
+	 * \return  version number, or 0 if the module has no content or the
+	 *          reader is not permitted to read it
+	 */
+	virtual unsigned long version(Reader const &reader) const = 0;
+
+	/**
+	 * Obtain reference to the current snapshot of the content
+	 *
+	 * \return  snapshot, or nullptr if 'version' would return 0
+	 *
+	 * The reference must be dropped via 'release_snapshot'.
+	 */
+	virtual Snapshot *acquire_snapshot(Reader const &reader) = 0;
+
+	virtual void release_snapshot(Snapshot &) = 0;
 };
 
 
@@ -82,7 +180,8 @@ struct Rom::Readable_module
  * either kind of service pay that refer to the Rom::Module. In the worst case,
  * however, if there are many client for a single report, the paid-for RAM
  * quota will never be used. For now, we simply allocate the backing store from
- * the server's quota.
+ * the server's quota. This includes the snapshots still referenced by ROM
+ * sessions after the content changed.
  *
  * The Rom::Module gets destroyed when no client refers to it anymore.
  */
@@ -119,6 +218,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 		Genode::Ram_session &_ram;
 		Genode::Region_map  &_rm;
+		Genode::Allocator   &_md_alloc;
 
 		Read_policy  const &_read_policy;
 		Write_policy const &_write_policy;
@@ -132,18 +232,35 @@ struct Rom::Module : Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Current version of the content
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * The content is not stored at the heap to allow for the immediate
+		 * release of the underlying backing store when the snapshot is no
+		 * longer referenced.
 		 */
-		Constructible<Attached_ram_dataspace> _ds;
+		Snapshot *_current = nullptr;
+
+		unsigned long _last_version = 0;
+
+		void _release(Snapshot &snapshot)
+		{
+			if (--snapshot._ref_cnt == 0)
+				Genode::destroy(_md_alloc, &snapshot);
+		}
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Make 'snapshot' the current version, drop the previous one
 		 */
-		size_t _size = 0;
+		void _publish(Snapshot *snapshot)
+		{
+			if (snapshot)
+				snapshot->_ref_cnt++;
+
+			if (_current)
+				_release(*_current);
+
+			_current = snapshot;
+		}
 
 
 		/********************************
@@ -159,6 +276,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 *                      backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
+		 * \param md_alloc      allocator for the meta data of snapshots
 		 * \param name          module name
 		 * \param read_policy   policy hook function that is evaluated each
 		 *                      time when the module content is obtained
@@ -167,11 +285,12 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		Module(Genode::Ram_session &ram,
 		       Genode::Region_map  &rm,
+		       Genode::Allocator   &md_alloc,
 		       Name          const &name,
 		       Read_policy   const &read_policy,
 		       Write_policy  const &write_policy)
 		:
-			_name(name), _ram(ram), _rm(rm),
+			_name(name), _ram(ram), _rm(rm), _md_alloc(md_alloc),
 			_read_policy(read_policy), _write_policy(write_policy)
 		{ }
 
@@ -204,8 +323,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_publish(nullptr);
 				_last_writer = nullptr;
 			}
 		}
@@ -228,6 +346,8 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 	public:
 
+		~Module() { _publish(nullptr); }
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -238,26 +358,30 @@ struct Rom::Module : Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
-
-			_last_writer = &writer;
+			/*
+			 * Readers of an unchanged report already have the current
+			 * content. As the read policy depends on the writer, a report of
+			 * another writer is propagated even if the content is the same.
+			 */
+			if (_current && _last_writer == &writer && _current->_equals(src, src_len))
+				return;
 
 			/*
-			 * Realloc backing store if needed
+			 * The snapshot appends a terminating zero to each report. This
+			 * way, we do not need to trust report clients to append a zero
+			 * termination to textual reports.
 			 *
-			 * Take a terminating zero into account, which we append to each
-			 * report. This way, we do not need to trust report clients to
-			 * append a zero termination to textual reports.
+			 * Reuse the backing store of the current snapshot if no ROM
+			 * session refers to it.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			if (_current && _current->_ref_cnt == 1
+			 && _current->_capacity() >= src_len)
+				_current->_assign(src, src_len, ++_last_version);
+			else
+				_publish(new (_md_alloc)
+				         Snapshot(_ram, _rm, src, src_len, ++_last_version));
 
-			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
-
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			_last_writer = &writer;
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -274,20 +398,49 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!version(reader))
+				return 0;
+
+			if (dst_len < _current->size())
+				throw Buffer_too_small();
+
+			Genode::memcpy(dst, _current->content(), _current->size());
+			return _current->size();
+		}
+
+		virtual size_t size() const override {
+			return _current ? _current->size() : 0; }
+
+		/**
+		 * Readable_module interface
+		 */
+		unsigned long version(Reader const &reader) const override
+		{
+			if (!_current || !_current->size() || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
 				return 0;
 
-			if (dst_len < _size)
-				throw Buffer_too_small();
+			return _current->version();
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		Snapshot *acquire_snapshot(Reader const &reader) override
+		{
+			if (!version(reader))
+				return nullptr;
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			_current->_ref_cnt++;
+			return _current;
 		}
 
-		virtual size_t size() const override { return _size; }
+		/**
+		 * Readable_module interface
+		 */
+		void release_snapshot(Snapshot &snapshot) override { _release(snapshot); }
 
 		Name name() const { return _name; }
 };
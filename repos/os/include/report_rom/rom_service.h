@@ -52,10 +52,57 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Root::Invalid_args(); }
 		}
 
+		/*
+		 * The RAM dataspace of a snapshot cannot be handed out read-only.
+		 * Each client of a shared snapshot is able to modify the content as
+		 * seen by the other clients. Hence, the content is shared only if
+		 * the readers of the module are trusted. Otherwise, the session
+		 * hands out a private copy.
+		 */
+		bool const _share_snapshot;
+
+		/**
+		 * Snapshot handed out to the client if shared
+		 */
+		Snapshot *_snapshot = nullptr;
+
+		/**
+		 * Private copy of the content if not shared
+		 */
 		Constructible<Genode::Attached_ram_dataspace> _ds;
 
 		size_t _content_size = 0;
 
+		/**
+		 * Version of the content handed out to the client, 0 if none
+		 */
+		unsigned long _version = 0;
+
+		void _release_snapshot()
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
+		void _copy(Snapshot const &snapshot)
+		{
+			char * const dst = _ds->local_addr<char>();
+
+			Genode::memcpy(dst, snapshot.content(), snapshot.size());
+
+			/* clear difference between old and new content */
+			if (_content_size > snapshot.size())
+				Genode::memset(dst + snapshot.size(), 0,
+				               _content_size - snapshot.size());
+
+			dst[snapshot.size()] = 0;
+
+			_content_size = snapshot.size();
+			_version      = snapshot.version();
+		}
+
 		/**
 		 * Keep state of valid content to notify the client only once when
 		 * the ROM module becomes invalid.
@@ -72,12 +119,20 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param share_snapshot  hand out the dataspace of the module's
+		 *                        content instead of a private copy
+		 */
 		Session_component(Genode::Ram_session &ram, Genode::Region_map &rm,
 		                  Registry_for_reader &registry,
-		                  Genode::Session_label const &label)
+		                  Genode::Session_label const &label,
+		                  bool share_snapshot = false)
 		:
 			_ram(ram), _rm(rm),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_share_snapshot(share_snapshot)
 		{ }
 
 		/**
@@ -91,11 +146,13 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		:
 			_ram(*Genode::env_deprecated()->ram_session()),
 			_rm(*Genode::env_deprecated()->rm_session()),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_share_snapshot(false)
 		{ }
 
 		~Session_component()
 		{
+			_release_snapshot();
 			_registry.release(*this, _module);
 		}
 
@@ -105,39 +162,74 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
-				/* replace dataspace by new one */
-				/* XXX we could keep the old dataspace if the size fits */
-				_ds.construct(_ram, _rm, _module.size());
+			Snapshot * const snapshot = _module.acquire_snapshot(*this);
+
+			_release_snapshot();
+
+			_valid = (snapshot != nullptr);
+
+			/* module has no content readable by the client */
+			if (!snapshot) {
+				_ds.destruct();
+				_content_size = 0;
+				_version      = 0;
+				return Rom_dataspace_capability();
+			}
+
+			Dataspace_capability ds_cap;
 
-				/* fill dataspace content with report contained in module */
-				_content_size =
-					_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+			if (_share_snapshot) {
+				_snapshot = snapshot;
+				_version  = snapshot->version();
+				ds_cap    = static_cap_cast<Dataspace>(snapshot->cap());
+			} else {
 
-				_valid = _content_size > 0;
+				/* keep the private dataspace if the content fits */
+				if (!_ds.constructed() || _ds->size() < snapshot->size() + 1) {
+					_ds.construct(_ram, _rm, snapshot->size() + 1);
+					_content_size = 0;
+				}
 
-				/* cast RAM into ROM dataspace capability */
-				Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_ds->cap());
-				return static_cap_cast<Rom_dataspace>(ds_cap);
+				_copy(*snapshot);
+				_module.release_snapshot(*snapshot);
+
+				ds_cap = static_cap_cast<Dataspace>(_ds->cap());
+			}
+
+			/* cast RAM into ROM dataspace capability */
+			return static_cap_cast<Rom_dataspace>(ds_cap);
 		}
 
 		bool update() override
 		{
-			if (!_ds.constructed() || _module.size() > _ds->size())
+			/* client already has the readable content */
+			if (_version && _module.version(*this) == _version)
+				return true;
+
+			/* a shared snapshot is never modified */
+			if (!_ds.constructed())
 				return false;
 
-			size_t const new_content_size =
-				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+			Snapshot * const snapshot = _module.acquire_snapshot(*this);
 
-			/* clear difference between old and new content */
-			if (new_content_size < _content_size)
-				Genode::memset(_ds->local_addr<char>() + new_content_size, 0,
-				               _content_size - new_content_size);
+			/* clear private copy if the module has no readable content */
+			if (!snapshot) {
+				Genode::memset(_ds->local_addr<char>(), 0, _content_size);
+				_content_size = 0;
+				_version      = 0;
+				_valid        = false;
+				return true;
+			}
 
-			_content_size = new_content_size;
+			bool const fits = snapshot->size() + 1 <= _ds->size();
 
-			_valid = _content_size > 0;
+			if (fits) {
+				_copy(*snapshot);
+				_valid = true;
+			}
 
-			return true;
+			_module.release_snapshot(*snapshot);
+			return fits;
 		}
 
 		void sigh(Genode::Signal_context_capability sigh) override
@@ -182,6 +274,8 @@ class Rom::Root : public Genode::Root_component<Session_component>
 		Genode::Env         &_env;
 		Registry_for_reader &_registry;
 
+		bool const _share_snapshots;
+
 	protected:
 
 		Session_component *_create_session(const char *args) override
@@ -189,17 +283,26 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_env.ram(), _env.rm(), _registry, label_from_args(args));
+				Session_component(_env.ram(), _env.rm(), _registry,
+				                  label_from_args(args), _share_snapshots);
 		}
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param share_snapshots  hand out the same dataspace to all readers
+		 *                         of a module, which must trust each other
+		 *                         not to modify the content
+		 */
 		Root(Genode::Env          &env,
 		     Genode::Allocator    &md_alloc,
-		     Registry_for_reader  &registry)
+		     Registry_for_reader  &registry,
+		     bool                  share_snapshots = false)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _registry(registry)
+			_env(env), _registry(registry), _share_snapshots(share_snapshots)
 		{ }
 };
 
@@ -0,0 +1,72 @@
+/*
+ * \brief  Free-running counter for interpolating the timer clock page
+ * \author agent
+ * \date   2026-10-18
+ *
+ * On x86, the time-stamp counter is used. In contrast to
+ * 'Trace::timestamp', the counter is read without serializing the
+ * instruction stream because the result is needed with microsecond
+ * precision only.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SPEC__X86__TIMER_SESSION__CLOCK_COUNTER_H_
+#define _INCLUDE__SPEC__X86__TIMER_SESSION__CLOCK_COUNTER_H_
+
+#include <base/stdint.h>
+
+namespace Timer {
+
+	/**
+	 * Read free-running counter
+	 *
+	 * \return  false if no counter is accessible
+	 */
+	inline bool read_clock_counter(Genode::uint64_t &value)
+	{
+		Genode::uint32_t lo, hi;
+		asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+		value = (Genode::uint64_t)hi << 32 | lo;
+		return true;
+	}
+
+	/**
+	 * Return true if the counter runs at a constant rate on all CPUs
+	 *
+	 * Only an invariant time-stamp counter is unaffected by frequency
+	 * changes and sleep states. Otherwise, interpolating the clock page
+	 * would yield wrong results.
+	 */
+	inline bool clock_counter_invariant()
+	{
+		unsigned long cpuid = 0x80000000, edx = 0;
+#ifdef __x86_64__
+		asm volatile ("cpuid" : "+a" (cpuid) : : "rbx", "rcx", "rdx");
+#else
+		asm volatile ("push %%ebx  \n"
+		              "cpuid       \n"
+		              "pop  %%ebx" : "+a" (cpuid) : : "ecx", "edx");
+#endif
+		/* leaf for advanced power management not supported */
+		if (cpuid < 0x80000007)
+			return false;
+
+		cpuid = 0x80000007;
+#ifdef __x86_64__
+		asm volatile ("cpuid" : "+a" (cpuid), "=d" (edx) : : "rbx", "rcx");
+#else
+		asm volatile ("push %%ebx  \n"
+		              "cpuid       \n"
+		              "pop  %%ebx" : "+a" (cpuid), "=d" (edx) : : "ecx");
+#endif
+		return edx & 0x100;
+	}
+}
+
+#endif /* _INCLUDE__SPEC__X86__TIMER_SESSION__CLOCK_COUNTER_H_ */
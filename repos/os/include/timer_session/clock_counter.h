@@ -0,0 +1,38 @@
+/*
+ * \brief  Free-running counter for interpolating the timer clock page
+ * \author agent
+ * \date   2026-10-18
+ *
+ * This generic version is used on platforms that provide no counter that
+ * is accessible at user level. Time queries always resort to the timer
+ * session then.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TIMER_SESSION__CLOCK_COUNTER_H_
+#define _INCLUDE__TIMER_SESSION__CLOCK_COUNTER_H_
+
+#include <base/stdint.h>
+
+namespace Timer {
+
+	/**
+	 * Read free-running counter
+	 *
+	 * \return  false if no counter is accessible
+	 */
+	inline bool read_clock_counter(Genode::uint64_t &) { return false; }
+
+	/**
+	 * Return true if the counter runs at a constant rate on all CPUs
+	 */
+	inline bool clock_counter_invariant() { return false; }
+}
+
+#endif /* _INCLUDE__TIMER_SESSION__CLOCK_COUNTER_H_ */
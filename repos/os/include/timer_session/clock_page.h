@@ -0,0 +1,91 @@
+/*
+ * \brief  Clock page shared between timer driver and timer-session client
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TIMER_SESSION__CLOCK_PAGE_H_
+#define _INCLUDE__TIMER_SESSION__CLOCK_PAGE_H_
+
+#include <base/stdint.h>
+#include <cpu/memory_barrier.h>
+#include <timer_session/clock_counter.h>
+
+namespace Timer { struct Clock_page; }
+
+
+/**
+ * Reference point for interpolating the session time at the client
+ *
+ * The timer driver stores the session time together with the value of a
+ * free-running counter (see 'read_clock_counter') and the calibrated
+ * duration of a counter tick. The client extrapolates the current session
+ * time from this tuple without contacting the driver. The tuple is
+ * protected by a sequence counter, which is odd while the driver updates
+ * the page. Whenever the tuple is unusable, the client falls back to the
+ * 'elapsed_ms' RPC, which, in turn, refreshes the tuple.
+ */
+struct Timer::Clock_page
+{
+	typedef Genode::uint64_t uint64_t;
+
+	unsigned volatile sequence;
+
+	uint64_t volatile time_us;    /* session time at 'counter'           */
+	uint64_t volatile counter;    /* counter value at 'time_us'          */
+	uint64_t volatile scale;      /* microseconds per tick, 32.32 fixed  */
+	uint64_t volatile max_delta;  /* ticks for which 'scale' is reliable */
+
+	/**
+	 * Update reference point, called by the timer driver only
+	 *
+	 * A 'scale' of zero marks the counter as unusable.
+	 */
+	void update(uint64_t time, uint64_t count, uint64_t scale_32_32,
+	            uint64_t max_count_delta)
+	{
+		sequence++;
+		Genode::memory_barrier();
+
+		time_us   = time;
+		counter   = count;
+		scale     = scale_32_32;
+		max_delta = max_count_delta;
+
+		Genode::memory_barrier();
+		sequence++;
+	}
+
+	/**
+	 * Determine current session time in microseconds
+	 *
+	 * \return  false if the time cannot be determined locally
+	 */
+	bool curr_time_us(uint64_t &result) const
+	{
+		unsigned const seq = sequence;
+		Genode::memory_barrier();
+
+		uint64_t const t = time_us, c = counter, s = scale, m = max_delta;
+
+		Genode::memory_barrier();
+		if ((seq & 1) || seq != sequence || !s)
+			return false;
+
+		uint64_t now;
+		if (!read_clock_counter(now) || now - c > m)
+			return false;
+
+		result = t + (((now - c) * s) >> 32);
+		return true;
+	}
+};
+
+#endif /* _INCLUDE__TIMER_SESSION__CLOCK_PAGE_H_ */
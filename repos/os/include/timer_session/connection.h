@@ -15,7 +15,10 @@
 #define _INCLUDE__TIMER_SESSION__CONNECTION_H_
 
 #include <timer_session/client.h>
+#include <timer_session/clock_page.h>
 #include <base/connection.h>
+#include <base/attached_dataspace.h>
+#include <util/reconstructible.h>
 
 namespace Timer { class Connection; }
 
@@ -33,6 +36,11 @@ class Timer::Connection : public Genode::Connection<Session>, public Session_cli
 
 		Genode::Signal_context_capability _custom_sigh_cap;
 
+		Genode::Constructible<Genode::Attached_dataspace> _clock_page;
+
+		/* last result of 'elapsed_ms', which must never decrease */
+		unsigned long mutable _elapsed_ms = 0;
+
 	public:
 
 		/**
@@ -40,11 +48,13 @@ class Timer::Connection : public Genode::Connection<Session>, public Session_cli
 		 */
 		Connection(Genode::Env &env, char const *label = "")
 		:
-			Genode::Connection<Session>(env, session(env.parent(), "ram_quota=10K, label=\"%s\"", label)),
+			Genode::Connection<Session>(env, session(env.parent(), "ram_quota=16K, label=\"%s\"", label)),
 			Session_client(cap())
 		{
 			/* register default signal handler */
 			Session_client::sigh(_default_sigh_cap);
+
+			_clock_page.construct(env.rm(), Session_client::clock_page());
 		}
 
 		/**
@@ -56,7 +66,7 @@ class Timer::Connection : public Genode::Connection<Session>, public Session_cli
 		 */
 		Connection() __attribute__((deprecated))
 		:
-			Genode::Connection<Session>(session("ram_quota=10K")),
+			Genode::Connection<Session>(session("ram_quota=16K")),
 			Session_client(cap())
 		{
 			/* register default signal handler */
@@ -107,6 +117,28 @@ class Timer::Connection : public Genode::Connection<Session>, public Session_cli
 		{
 			usleep(1000*ms);
 		}
+
+		/*
+		 * Determine the elapsed time via the clock page if possible
+		 */
+		unsigned long elapsed_ms() const override
+		{
+			Genode::uint64_t us = 0;
+			unsigned long    ms = 0;
+
+			if (_clock_page.constructed() &&
+			    _clock_page->local_addr<Clock_page const>()->curr_time_us(us))
+				ms = us / 1000;
+			else
+				ms = Session_client::elapsed_ms();
+
+			/* compensate for deviations between interpolation and driver */
+			if (ms < _elapsed_ms)
+				ms = _elapsed_ms;
+
+			_elapsed_ms = ms;
+			return ms;
+		}
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__CONNECTION_H_ */
@@ -17,6 +17,7 @@
 #define _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_
 
 #include <base/signal.h>
+#include <dataspace/capability.h>
 #include <session/session.h>
 
 namespace Timer { struct Session; }
@@ -53,6 +54,14 @@ struct Timer::Session : Genode::Session
 	 */
 	virtual unsigned long elapsed_ms() const = 0;
 
+	/**
+	 * Return dataspace of the session's clock page
+	 *
+	 * The clock page allows the client to determine the elapsed time
+	 * without an RPC (see 'timer_session/clock_page.h').
+	 */
+	virtual Genode::Dataspace_capability clock_page() = 0;
+
 	/**
 	 * Client-side convenience method for sleeping the specified number
 	 * of milliseconds
@@ -74,9 +83,10 @@ struct Timer::Session : Genode::Session
 	GENODE_RPC(Rpc_trigger_periodic, void, trigger_periodic, unsigned);
 	GENODE_RPC(Rpc_sigh, void, sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_elapsed_ms, unsigned long, elapsed_ms);
+	GENODE_RPC(Rpc_clock_page, Genode::Dataspace_capability, clock_page);
 
 	GENODE_RPC_INTERFACE(Rpc_trigger_once, Rpc_trigger_periodic,
-	                     Rpc_sigh, Rpc_elapsed_ms);
+	                     Rpc_sigh, Rpc_elapsed_ms, Rpc_clock_page);
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_ */
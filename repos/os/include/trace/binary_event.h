@@ -0,0 +1,90 @@
+/*
+ * \brief  Binary encoding of trace events
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Trace-policy modules that encode events in binary form prefix each entry
+ * of the trace buffer with an 'Event_header', followed by an event-specific
+ * payload, e.g., the RPC name. In contrast to textual entries, binary events
+ * can be merged into a timeline of the whole system by a trace consumer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TRACE__BINARY_EVENT_H_
+#define _INCLUDE__TRACE__BINARY_EVENT_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Genode { namespace Trace { struct Event_header; } }
+
+
+struct Genode::Trace::Event_header
+{
+	/*
+	 * The magic value cannot start a printable textual entry
+	 */
+	enum { MAGIC = 0xe7 };
+
+	enum Type {
+		RPC_CALL = 1, RPC_RETURNED, RPC_DISPATCH, RPC_REPLY,
+		SIGNAL_SUBMIT, SIGNAL_RECEIVED
+	};
+
+	/*
+	 * A policy module has no notion of the CPU it is executed on. In this
+	 * case, the consumer takes the affinity of the traced thread.
+	 */
+	enum { CPU_UNKNOWN = 0xffff };
+
+	uint8_t  magic;
+	uint8_t  type;
+	uint16_t cpu;
+	uint32_t value;      /* event-specific value, e.g., signal number */
+	uint64_t timestamp;  /* value of the cycle counter */
+
+	/**
+	 * Encode header at 'dst'
+	 *
+	 * \return  size of the header
+	 */
+	static size_t write(char *dst, Type type, uint64_t timestamp,
+	                    uint32_t value = 0, uint16_t cpu = CPU_UNKNOWN)
+	{
+		Event_header &header = *(Event_header *)dst;
+		header.magic     = MAGIC;
+		header.type      = type;
+		header.cpu       = cpu;
+		header.value     = value;
+		header.timestamp = timestamp;
+		return sizeof(Event_header);
+	}
+
+	/**
+	 * Decode header of trace-buffer entry
+	 *
+	 * \return  false if the entry is no binary event
+	 *
+	 * The entries of a trace buffer are not aligned. Hence, the header is
+	 * copied instead of accessed in place.
+	 */
+	static bool read(char const *src, size_t len, Event_header &header)
+	{
+		if (len < sizeof(Event_header) || (uint8_t)src[0] != MAGIC)
+			return false;
+
+		char *dst = (char *)&header;
+		for (size_t i = 0; i < sizeof(Event_header); i++)
+			dst[i] = src[i];
+
+		return header.type >= RPC_CALL && header.type <= SIGNAL_RECEIVED;
+	}
+} __attribute__((packed));
+
+#endif /* _INCLUDE__TRACE__BINARY_EVENT_H_ */
@@ -48,6 +48,54 @@ struct Vfs::File_io_service
 	                           char const *buf, file_size buf_size,
 	                           file_size &out_count) = 0;
 
+	/**
+	 * Source buffer of a vectored write
+	 */
+	struct Write_chunk
+	{
+		char const *buf;
+		file_size   size;
+	};
+
+	/**
+	 * Write the content of multiple buffers in one operation
+	 *
+	 * The data is written at the seek offset of the handle as if the chunks
+	 * were a single contiguous buffer. As with 'write', the seek offset is
+	 * not advanced. File systems with a significant per-operation cost
+	 * override this method to transfer the chunks at once. The default
+	 * implementation writes one chunk after the other and stops at the
+	 * first short write.
+	 */
+	virtual Write_result writev(Vfs_handle *vfs_handle,
+	                            Write_chunk const *chunks, unsigned num_chunks,
+	                            file_size &out_count)
+	{
+		file_size const seek   = vfs_handle->seek();
+		Write_result    result = WRITE_OK;
+
+		out_count = 0;
+
+		for (unsigned i = 0; i < num_chunks; i++) {
+
+			file_size count = 0;
+			result = write(vfs_handle, chunks[i].buf, chunks[i].size, count);
+			if (result != WRITE_OK)
+				break;
+
+			out_count += count;
+			vfs_handle->advance_seek(count);
+
+			if (count < chunks[i].size)
+				break;
+		}
+
+		vfs_handle->seek(seek);
+
+		/* report partial progress as success, like a short write */
+		return out_count ? WRITE_OK : result;
+	}
+
 
 	/**********
 	 ** Read **
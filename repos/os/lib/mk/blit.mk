@@ -1,4 +1,4 @@
-SRC_CC   = blit.cc
+SRC_CC   = blit.cc blend.cc
 INC_DIR += $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc $(REP_DIR)/src/lib/blit
@@ -1,3 +1 @@
-SRC_CC = ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc mac_address.cc
-
-vpath %.cc $(REP_DIR)/src/lib/net
+include $(REP_DIR)/lib/mk/net.inc
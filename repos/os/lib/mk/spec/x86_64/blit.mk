@@ -1,6 +1,6 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc blend.cc
 REQUIRES = x86 64bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64 \
            $(REP_DIR)/src/lib/blit/spec/x86
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc $(REP_DIR)/src/lib/blit
@@ -0,0 +1,503 @@
+/*
+ * \brief  Export binary trace events as Chrome trace
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The component enables tracing for the threads selected by its config,
+ * periodically collects the binary events of their trace buffers, and
+ * appends them to a file in the JSON format of the Chrome trace viewer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <file_system/util.h>
+#include <file_system_session/connection.h>
+#include <os/session_policy.h>
+#include <rom_session/connection.h>
+#include <timer_session/connection.h>
+#include <trace/binary_event.h>
+#include <trace/timestamp.h>
+#include <trace_session/connection.h>
+
+namespace Trace_export {
+
+	using namespace Genode;
+
+	typedef Trace::Event_header Event_header;
+
+	struct Quoted;
+	struct Microseconds;
+	class  Json_file;
+	struct Policy_module;
+	struct Process;
+	struct Subject;
+	struct Main;
+}
+
+
+/**
+ * JSON string literal
+ */
+struct Trace_export::Quoted
+{
+	char const *str;
+	size_t      len;
+
+	Quoted(char const *str, size_t len = ~0UL) : str(str), len(len) { }
+
+	void print(Output &out) const
+	{
+		out.out_char('"');
+		for (size_t i = 0; i < len && str[i]; i++) {
+			char const c = str[i];
+			if (c == '"' || c == '\\')
+				out.out_char('\\');
+			out.out_char((c < 0x20 || c > 0x7e) ? '?' : c);
+		}
+		out.out_char('"');
+	}
+};
+
+
+/**
+ * Timestamp relative to the start of the export in microseconds
+ */
+struct Trace_export::Microseconds
+{
+	uint64_t ticks;
+	uint64_t ticks_per_us;
+
+	void print(Output &out) const
+	{
+		Genode::print(out, ticks/ticks_per_us, ".");
+
+		/* three fractional digits */
+		uint64_t const ns = (ticks % ticks_per_us)*1000/ticks_per_us;
+		out.out_char('0' + ns/100);
+		out.out_char('0' + ns/10%10);
+		out.out_char('0' + ns%10);
+	}
+};
+
+
+/**
+ * File that receives the events in the JSON array format
+ *
+ * The closing bracket of the array is never written, which the trace
+ * viewer tolerates. Hence, the file can be loaded at any time.
+ */
+class Trace_export::Json_file
+{
+	private:
+
+		enum { BUF_SIZE = 16*1024, MAX_EVENT_LEN = 512 };
+
+		File_system::Session     &_fs;
+		File_system::File_handle  _handle;
+		File_system::seek_off_t   _offset = 0;
+
+		char   _buf[BUF_SIZE];
+		size_t _len   = 0;
+		bool   _first = true;
+
+		static File_system::File_handle _open(File_system::Session &fs,
+		                                      char const *name)
+		{
+			using namespace File_system;
+
+			Dir_handle   dir_handle = ensure_dir(fs, "/");
+			Handle_guard dir_guard(fs, dir_handle);
+
+			File_handle handle;
+			try { handle = fs.file(dir_handle, name, WRITE_ONLY, true); }
+			catch (Node_already_exists) {
+				handle = fs.file(dir_handle, name, WRITE_ONLY, false); }
+
+			fs.truncate(handle, 0);
+			return handle;
+		}
+
+		void _append(char const *str, size_t len)
+		{
+			if (_len + len > BUF_SIZE)
+				flush();
+
+			memcpy(_buf + _len, str, len);
+			_len += len;
+		}
+
+	public:
+
+		Json_file(File_system::Session &fs, char const *name)
+		:
+			_fs(fs), _handle(_open(fs, name))
+		{
+			_append("[\n", 2);
+		}
+
+		~Json_file()
+		{
+			flush();
+			_fs.close(_handle);
+		}
+
+		/**
+		 * Append event, the arguments are printed as JSON object members
+		 */
+		template <typename... ARGS>
+		void event(ARGS &&... args)
+		{
+			String<MAX_EVENT_LEN> const line(_first ? "" : ",\n", "{",
+			                                 args..., "}");
+			_first = false;
+			_append(line.string(), line.length() - 1);
+		}
+
+		void flush()
+		{
+			if (!_len)
+				return;
+
+			size_t const written = File_system::write(_fs, _handle, _buf, _len,
+			                                          _offset);
+			if (written < _len)
+				warning("trace file truncated, ", _len - written, " bytes lost");
+
+			_offset += written;
+			_len     = 0;
+		}
+};
+
+
+/**
+ * Policy module loaded into the TRACE session
+ */
+struct Trace_export::Policy_module : List<Policy_module>::Element
+{
+	typedef String<64> Name;
+
+	Name             const name;
+	Trace::Policy_id const id;
+
+	static Trace::Policy_id _load(Env &env, Trace::Connection &trace,
+	                              Name const &name)
+	{
+		Rom_connection rom(env, name.string());
+		Rom_dataspace_capability const rom_ds = rom.dataspace();
+
+		size_t const size = Dataspace_client(rom_ds).size();
+
+		Trace::Policy_id const id = trace.alloc_policy(size);
+
+		void *dst = env.rm().attach(trace.policy(id));
+		void *src = env.rm().attach(rom_ds);
+		memcpy(dst, src, size);
+		env.rm().detach(dst);
+		env.rm().detach(src);
+
+		return id;
+	}
+
+	Policy_module(Env &env, Trace::Connection &trace, Name const &name)
+	: name(name), id(_load(env, trace, name)) { }
+};
+
+
+/**
+ * Component whose threads appear as one process in the trace viewer
+ */
+struct Trace_export::Process : List<Process>::Element
+{
+	Session_label const label;
+	unsigned      const pid;
+
+	Process(Session_label const &label, unsigned pid) : label(label), pid(pid) { }
+};
+
+
+/**
+ * Traced thread
+ */
+struct Trace_export::Subject : List<Subject>::Element
+{
+	Trace::Subject_id   const id;
+	unsigned            const pid;
+	Trace::Subject_info       info;
+	Trace::Buffer            &buffer;
+
+	/* timestamp of the most recent exported event */
+	uint64_t last_timestamp;
+
+	Subject(Trace::Subject_id id, unsigned pid, Trace::Subject_info const &info,
+	        Trace::Buffer &buffer, uint64_t start)
+	:
+		id(id), pid(pid), info(info), buffer(buffer), last_timestamp(start)
+	{ }
+};
+
+
+struct Trace_export::Main
+{
+	enum { MAX_SUBJECTS = 512, MAX_NAME_LEN = 64 };
+
+	enum {
+		BLOCK_SIZE  = 512,
+		TX_BUF_SIZE = BLOCK_SIZE*(File_system::Session::TX_QUEUE_SIZE*2 + 1)
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Trace::Connection _trace { _env, 4*1024*1024, 64*1024, 0 };
+
+	Allocator_avl _fs_alloc { &_heap };
+
+	File_system::Connection _fs { _env, _fs_alloc, "", "/", true, TX_BUF_SIZE };
+
+	typedef String<64> File_name;
+
+	Json_file _file { _fs, _config.xml().attribute_value("file",
+	                       File_name("trace.json")).string() };
+
+	Number_of_bytes const _buffer_size =
+		_config.xml().attribute_value("buffer_size", Number_of_bytes(64*1024));
+
+	/**
+	 * Determine frequency of the timestamps written by the policy modules
+	 */
+	uint64_t _ticks_per_us()
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		_timer.msleep(100);
+		return max((uint64_t)(Trace::timestamp() - start)/(100*1000), (uint64_t)1);
+	}
+
+	uint64_t const _ticks_per_us_value = _ticks_per_us();
+
+	/* events that precede the start of the export are dropped */
+	uint64_t const _start = Trace::timestamp();
+
+	List<Policy_module> _modules;
+	List<Process>       _processes;
+	List<Subject>       _subjects;
+
+	Trace::Subject_id _subject_ids[MAX_SUBJECTS];
+
+	bool const _verbose = _config.xml().attribute_value("verbose", false);
+
+	unsigned long _num_events = 0;
+
+	Microseconds _us(uint64_t timestamp) const {
+		return Microseconds { timestamp - _start, _ticks_per_us_value }; }
+
+	Trace::Policy_id _policy_module(Policy_module::Name const &name)
+	{
+		for (Policy_module *m = _modules.first(); m; m = m->next())
+			if (m->name == name)
+				return m->id;
+
+		Policy_module *m = new (_heap) Policy_module(_env, _trace, name);
+		_modules.insert(m);
+		return m->id;
+	}
+
+	unsigned _pid(Session_label const &label)
+	{
+		unsigned pid = 1;
+		for (Process *p = _processes.first(); p; p = p->next(), pid++)
+			if (p->label == label)
+				return p->pid;
+
+		_processes.insert(new (_heap) Process(label, pid));
+
+		_file.event("\"name\":\"process_name\",\"ph\":\"M\",\"pid\":", pid,
+		            ",\"args\":{\"name\":", Quoted(label.string()), "}");
+		return pid;
+	}
+
+	Subject *_lookup(Trace::Subject_id id)
+	{
+		for (Subject *s = _subjects.first(); s; s = s->next())
+			if (s->id == id)
+				return s;
+		return nullptr;
+	}
+
+	void _export_event(Subject const &subject, Event_header const &header,
+	                   char const *payload, size_t payload_len)
+	{
+		/*
+		 * The CPU is reported by the policy module if known. Otherwise, we
+		 * take the affinity of the thread, which does not migrate between
+		 * CPUs on most kernels.
+		 */
+		unsigned const cpu = header.cpu != Event_header::CPU_UNKNOWN
+		                   ? header.cpu : subject.info.affinity().xpos();
+
+		char const *phase = "i";
+		char const *name  = nullptr;
+		char const *cat   = "rpc";
+
+		switch (header.type) {
+		case Event_header::RPC_CALL:        phase = "B"; break;
+		case Event_header::RPC_RETURNED:    phase = "E"; break;
+		case Event_header::RPC_DISPATCH:    phase = "B"; cat = "dispatch"; break;
+		case Event_header::RPC_REPLY:       phase = "E"; cat = "dispatch"; break;
+		case Event_header::SIGNAL_SUBMIT:   name  = "signal_submit";   cat = "signal"; break;
+		case Event_header::SIGNAL_RECEIVED: name  = "signal_received"; cat = "signal"; break;
+		}
+
+		Quoted const quoted_name = name ? Quoted(name)
+		                                : Quoted(payload, min(payload_len,
+		                                                      (size_t)MAX_NAME_LEN));
+
+		_file.event("\"name\":", quoted_name, ",\"cat\":\"", cat, "\","
+		            "\"ph\":\"", phase, "\",\"ts\":", _us(header.timestamp), ","
+		            "\"pid\":", subject.pid, ",\"tid\":", subject.id.id, ","
+		            "\"s\":\"t\",\"args\":{\"cpu\":", cpu, ",\"value\":",
+		            header.value, "}");
+
+		_num_events++;
+	}
+
+	/**
+	 * Export the events of the subject not exported yet
+	 *
+	 * The buffer is written concurrently and wraps without notice to us.
+	 * Events that are already exported or got overwritten by the wrapping
+	 * buffer are identified by their timestamps. Entries that are not
+	 * decodable as binary events are skipped.
+	 */
+	void _export_events(Subject &subject)
+	{
+		uint64_t newest = subject.last_timestamp;
+
+		Trace::Buffer const &buffer = subject.buffer;
+		for (Trace::Buffer::Entry e = buffer.first(); !e.last(); e = buffer.next(e)) {
+
+			Event_header header;
+			if (!Event_header::read(e.data(), e.length(), header))
+				continue;
+
+			if (header.timestamp <= subject.last_timestamp)
+				continue;
+
+			_export_event(subject, header, e.data() + sizeof(header),
+			              e.length() - sizeof(header));
+
+			newest = max(newest, (uint64_t)header.timestamp);
+		}
+
+		subject.last_timestamp = newest;
+	}
+
+	void _follow(Trace::Subject_id id, Trace::Subject_info const &info)
+	{
+		Session_label const label(info.session_label());
+
+		Policy_module::Name module;
+		try {
+			Session_policy policy(label, _config.xml());
+
+			if (policy.has_attribute("thread")
+			 && policy.attribute_value("thread", Trace::Thread_name()) != info.thread_name())
+				return;
+
+			module = policy.attribute_value("module", Policy_module::Name("timeline"));
+
+		} catch (Session_policy::No_policy_defined) { return; }
+
+		try {
+			_trace.trace(id, _policy_module(module), _buffer_size);
+		}
+		catch (Trace::Already_traced)   { return; }
+		catch (Trace::Source_is_dead)   { return; }
+		catch (Trace::Out_of_metadata)  {
+			warning("TRACE session out of quota, cannot follow ", label, " ",
+			        info.thread_name());
+			return;
+		}
+
+		Trace::Buffer &buffer =
+			*(Trace::Buffer *)_env.rm().attach(_trace.buffer(id));
+
+		Subject *subject = new (_heap)
+			Subject(id, _pid(label), info, buffer, _start);
+		_subjects.insert(subject);
+
+		_file.event("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":", subject->pid,
+		            ",\"tid\":", id.id, ",\"args\":{\"name\":",
+		            Quoted(info.thread_name().string()), "}");
+	}
+
+	void _unfollow(Subject &subject)
+	{
+		_env.rm().detach(&subject.buffer);
+		_trace.free(subject.id);
+		_subjects.remove(&subject);
+		destroy(_heap, &subject);
+	}
+
+	void _handle_period()
+	{
+		unsigned const num = _trace.subjects(_subject_ids, MAX_SUBJECTS);
+
+		for (unsigned i = 0; i < num; i++) {
+
+			Trace::Subject_id   const id   = _subject_ids[i];
+			Trace::Subject_info const info = _trace.subject_info(id);
+
+			Subject *subject = _lookup(id);
+
+			if (!subject) {
+				if (info.state() == Trace::Subject_info::UNTRACED)
+					_follow(id, info);
+				continue;
+			}
+
+			subject->info = info;
+			_export_events(*subject);
+
+			if (info.state() == Trace::Subject_info::DEAD)
+				_unfollow(*subject);
+		}
+
+		_file.flush();
+
+		if (_verbose)
+			log("exported ", _num_events, " events");
+	}
+
+	Signal_handler<Main> _period_handler {
+		_env.ep(), *this, &Main::_handle_period };
+
+	Main(Env &env) : _env(env)
+	{
+		unsigned long const period_ms =
+			_config.xml().attribute_value("period_ms", 1000UL);
+
+		log("exporting trace events, ", _ticks_per_us_value, " ticks per us");
+
+		_timer.sigh(_period_handler);
+		_timer.trigger_periodic(1000*period_ms);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Trace_export::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = trace_export
+SRC_CC = main.cc
+LIBS   = base
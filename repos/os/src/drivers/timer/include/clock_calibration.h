@@ -0,0 +1,87 @@
+/*
+ * \brief  Calibration of the counter used for the clock pages
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CLOCK_CALIBRATION_H_
+#define _CLOCK_CALIBRATION_H_
+
+/* Genode includes */
+#include <os/timeout.h>
+#include <timer_session/clock_counter.h>
+
+namespace Timer { class Clock_calibration; }
+
+
+/**
+ * Relation between the time source and the counter of the clock pages
+ *
+ * The relation is measured between the construction of the driver and the
+ * latest sample. It is refined with each sample until the measurement
+ * period would overflow the fixed-point calculation. If the counter does
+ * not run at a constant rate, no calibration is reported and clients keep
+ * using the 'elapsed_ms' RPC.
+ */
+class Timer::Clock_calibration
+{
+	private:
+
+		typedef Genode::uint64_t uint64_t;
+
+		enum {
+			MIN_PERIOD_US = 100 * 1000,
+			MAX_PERIOD_US = 1UL << 31,
+
+			/* period for which the client may extrapolate the time */
+			MAX_DELTA_US  = 1000 * 1000,
+		};
+
+		uint64_t       _start_us      = 0;
+		uint64_t       _start_counter = 0;
+		bool     const _counter       = clock_counter_invariant()
+		                             && read_clock_counter(_start_counter);
+		uint64_t       _scale         = 0;
+
+	public:
+
+		Clock_calibration(Genode::Timeout_scheduler &timeout_scheduler)
+		: _start_us(timeout_scheduler.curr_time().value) { }
+
+		struct Sample
+		{
+			uint64_t counter;
+			uint64_t scale;      /* microseconds per tick, 32.32 fixed point */
+			uint64_t max_delta;  /* ticks the client may extrapolate */
+		};
+
+		/**
+		 * Take sample of the counter at the time source's 'now_us'
+		 */
+		Sample sample(uint64_t now_us)
+		{
+			Sample result { 0, 0, 0 };
+			if (!_counter || !read_clock_counter(result.counter))
+				return result;
+
+			uint64_t const period_us = now_us - _start_us;
+			uint64_t const ticks     = result.counter - _start_counter;
+			if (period_us >= MIN_PERIOD_US && period_us < MAX_PERIOD_US && ticks)
+				_scale = (period_us << 32) / ticks;
+
+			if (_scale) {
+				result.scale     = _scale;
+				result.max_delta = ((uint64_t)MAX_DELTA_US << 32) / _scale;
+			}
+			return result;
+		}
+};
+
+#endif /* _CLOCK_CALIBRATION_H_ */
@@ -29,8 +29,10 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 {
 	private:
 
+		Genode::Env                    &_env;
 		Time_source                     _time_source;
 		Genode::Alarm_timeout_scheduler _timeout_scheduler;
+		Clock_calibration               _calibration { _timeout_scheduler };
 
 
 		/********************
@@ -43,11 +45,12 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 			size_t const ram_quota =
 				Arg_string::find_arg(args, "ram_quota").ulong_value(0);
 
-			if (ram_quota < sizeof(Session_component)) {
+			if (ram_quota < sizeof(Session_component) +
+			                Session_component::CLOCK_PAGE_SIZE) {
 				throw Root::Quota_exceeded(); }
 
 			return new (md_alloc())
-				Session_component(_timeout_scheduler);
+				Session_component(_timeout_scheduler, _calibration, _env);
 		}
 
 	public:
@@ -55,7 +58,7 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 		Root_component(Genode::Env &env, Genode::Allocator &md_alloc)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_time_source(env), _timeout_scheduler(_time_source)
+			_env(env), _time_source(env), _timeout_scheduler(_time_source)
 		{ }
 };
 
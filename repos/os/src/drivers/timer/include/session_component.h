@@ -20,9 +20,14 @@
 /* Genode includes */
 #include <util/list.h>
 #include <timer_session/timer_session.h>
+#include <timer_session/clock_page.h>
+#include <base/attached_ram_dataspace.h>
 #include <base/rpc_server.h>
 #include <os/timeout.h>
 
+/* local includes */
+#include <clock_calibration.h>
+
 namespace Timer { class Session_component; }
 
 
@@ -32,27 +37,57 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 {
 	private:
 
-		Genode::Timeout                    _timeout;
-		Genode::Timeout_scheduler         &_timeout_scheduler;
-		Genode::Signal_context_capability  _sigh;
+		Genode::Timeout                        _timeout;
+		Genode::Timeout_scheduler             &_timeout_scheduler;
+		Genode::Signal_context_capability      _sigh;
+		Clock_calibration                     &_calibration;
+		Genode::Attached_ram_dataspace mutable _clock_page;
 
 		unsigned long const _init_time_us = _timeout_scheduler.curr_time().value;
 
 		void handle_timeout(Microseconds) {
 			Genode::Signal_transmitter(_sigh).submit(); }
 
+		/**
+		 * Update clock page and return session time in microseconds
+		 */
+		unsigned long _update_clock_page() const
+		{
+			unsigned long const now_us = _timeout_scheduler.curr_time().value;
+			Clock_calibration::Sample const sample = _calibration.sample(now_us);
+
+			_clock_page.local_addr<Clock_page>()->update(
+				now_us - _init_time_us, sample.counter, sample.scale,
+				sample.max_delta);
+
+			return now_us - _init_time_us;
+		}
+
 	public:
 
-		Session_component(Genode::Timeout_scheduler &timeout_scheduler)
-		: _timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler) { }
+		enum { CLOCK_PAGE_SIZE = 4096 };
+
+		Session_component(Genode::Timeout_scheduler &timeout_scheduler,
+		                  Clock_calibration         &calibration,
+		                  Genode::Env               &env)
+		:
+			_timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler),
+			_calibration(calibration),
+			_clock_page(env.ram(), env.rm(), CLOCK_PAGE_SIZE)
+		{
+			_update_clock_page();
+		}
 
 
 		/********************
 		 ** Timer::Session **
 		 ********************/
 
-		void trigger_once(unsigned us) override {
-			_timeout.schedule_one_shot(Microseconds(us), *this); }
+		void trigger_once(unsigned us) override
+		{
+			_update_clock_page();
+			_timeout.schedule_one_shot(Microseconds(us), *this);
+		}
 
 		void trigger_periodic(unsigned us) override {
 			_timeout.schedule_periodic(Microseconds(us), *this); }
@@ -64,8 +99,15 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 				_timeout.discard();
 		}
 
+		/*
+		 * This method is called only if the client cannot use the clock
+		 * page. Therefore, we take the opportunity to refresh the page.
+		 */
 		unsigned long elapsed_ms() const override {
-			return (_timeout_scheduler.curr_time().value - _init_time_us) / 1000; }
+			return _update_clock_page() / 1000; }
+
+		Genode::Dataspace_capability clock_page() override {
+			return _clock_page.cap(); }
 
 		void msleep(unsigned) override { /* never called at the server side */ }
 		void usleep(unsigned) override { /* never called at the server side */ }
@@ -15,6 +15,7 @@
 /* Linux includes */
 #include <linux_syscalls.h>
 #include <sys/time.h>
+#include <time.h>
 
 /* local includes */
 #include <time_source.h>
@@ -23,8 +24,8 @@ using namespace Genode;
 using Microseconds = Genode::Time_source::Microseconds;
 
 
-inline int lx_gettimeofday(struct timeval *tv, struct timeval *tz) {
-	return lx_syscall(SYS_gettimeofday, tv, tz); }
+inline int lx_clock_gettime(clockid_t clock, struct timespec *ts) {
+	return lx_syscall(SYS_clock_gettime, clock, ts); }
 
 
 Microseconds Timer::Time_source::max_timeout() const
@@ -34,11 +35,16 @@ Microseconds Timer::Time_source::max_timeout() const
 }
 
 
+/*
+ * The monotonic clock is used because the time must not jump with
+ * adjustments of the wall-clock time, which would disturb the
+ * interpolation at the clients of the clock pages.
+ */
 Microseconds Timer::Time_source::curr_time() const
 {
-	struct timeval tv;
-	lx_gettimeofday(&tv, 0);
-	return Microseconds(tv.tv_sec * 1000 * 1000 + tv.tv_usec);
+	struct timespec ts;
+	lx_clock_gettime(CLOCK_MONOTONIC, &ts);
+	return Microseconds(ts.tv_sec * 1000 * 1000 + ts.tv_nsec / 1000);
 }
 
 
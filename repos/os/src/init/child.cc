@@ -16,7 +16,7 @@
 
 
 Init::Child::Apply_config_result
-Init::Child::apply_config(Xml_node start_node)
+Init::Child::apply_config(Xml_node start_node, bool routes_changed)
 {
 	Child_policy &policy = *this;
 
@@ -33,6 +33,7 @@ Init::Child::apply_config(Xml_node start_node)
 	}
 
 	bool provided_services_changed = false;
+	bool start_node_changed        = false;
 
 	enum Config_update { CONFIG_APPEARED, CONFIG_VANISHED,
 	                     CONFIG_CHANGED,  CONFIG_UNCHANGED };
@@ -120,8 +121,14 @@ Init::Child::apply_config(Xml_node start_node)
 		 */
 		_binary_name = _binary_from_xml(start_node, _unique_name);
 
+		/* compile new routing policy */
+		if (_route_differs(_start_node->xml(), start_node))
+			_update_route_model(start_node);
+
 		/* import new start node */
 		_start_node.construct(_alloc, start_node);
+
+		start_node_changed = true;
 	}
 
 	/*
@@ -137,8 +144,13 @@ Init::Child::apply_config(Xml_node start_node)
 	case CONFIG_VANISHED: _config_rom_service->abandon();        break;
 	}
 
-	/* validate that the routes of all existing sessions remain intact */
-	{
+	/*
+	 * Validate that the routes of all existing sessions remain intact
+	 *
+	 * The routes can only change if the routing policy or the available
+	 * services changed.
+	 */
+	if (start_node_changed || routes_changed) {
 		bool routing_changed = false;
 		_child.for_each_session([&] (Session_state const &session) {
 			if (!_route_valid(session))
@@ -417,104 +429,89 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 	 && label.last_element() == Session_requester::rom_name())
 		return Route { _session_requester.service() };
 
-	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+	Route_model::Service_rules const &rules =
+		_effective_route_model().rules(service_name);
 
-		for (; ; service_node = service_node.next()) {
+	for (unsigned i = 0; i < rules.num(); i++) {
 
-			bool service_wildcard = service_node.has_type("any-service");
+		Route_model::Rule const &rule = rules.rule(i);
 
-			if (!service_node_matches(service_node, label, name(), service_name))
-				continue;
+		if (!rule.matches(name(), label))
+			continue;
 
-			Xml_node target = service_node.sub_node();
-			for (; ; target = target.next()) {
+		if (rule.denies)
+			break;
 
-				/*
-				 * Determine session label to be provided to the server
-				 *
-				 * By default, the client's identity (accompanied with the a
-				 * client-provided label) is presented as session label to the
-				 * server. However, the target node can explicitly override the
-				 * client's identity by a custom label via the 'label'
-				 * attribute.
-				 */
-				typedef String<Session_label::capacity()> Label;
-				Label const target_label =
-					target.attribute_value("label", Label(label.string()));
+		bool const service_wildcard = rule.any_service;
 
-				if (target.has_type("parent")) {
+		for (Route_model::Target const *target = rule.first_target();
+		     target; target = target->next()) {
 
-					Parent_service *service = nullptr;
+			Session_label const target_label(target->server_label(label).string());
 
-					if ((service = find_service(_parent_services, service_name)))
-						return Route { *service, target_label };
+			if (target->type == Route_model::Target::PARENT) {
 
-					if (service && service->abandoned())
-						throw Parent::Service_denied();
+				Parent_service *service = nullptr;
 
-					if (!service_wildcard) {
-						warning(name(), ": service lookup for "
-						        "\"", service_name, "\" at parent failed");
-						throw Parent::Service_denied();
-					}
+				if ((service = find_service(_parent_services, service_name)))
+					return Route { *service, target_label };
+
+				if (service && service->abandoned())
+					throw Parent::Service_denied();
+
+				if (!service_wildcard) {
+					warning(name(), ": service lookup for "
+					        "\"", service_name, "\" at parent failed");
+					throw Parent::Service_denied();
 				}
+			}
 
-				if (target.has_type("child")) {
+			if (target->type == Route_model::Target::CHILD) {
 
-					typedef Name_registry::Name Name;
-					Name server_name = target.attribute_value("name", Name());
-					server_name = _name_registry.deref_alias(server_name);
+				Name_registry::Name const server_name =
+					_name_registry.deref_alias(target->name);
 
-					Routed_service *service = nullptr;
+				Routed_service *service = nullptr;
 
-					_child_services.for_each([&] (Routed_service &s) {
-						if (s.name()       == Service::Name(service_name)
-						 && s.child_name() == server_name)
-							service = &s; });
+				_child_services.for_each([&] (Routed_service &s) {
+					if (s.name()       == Service::Name(service_name)
+					 && s.child_name() == server_name)
+						service = &s; });
 
-					if (service && service->abandoned())
-						throw Parent::Service_denied();
+				if (service && service->abandoned())
+					throw Parent::Service_denied();
 
-					if (service)
-						return Route { *service, target_label };
+				if (service)
+					return Route { *service, target_label };
 
-					if (!service_wildcard) {
-						warning(name(), ": lookup to child "
-						        "server \"", server_name, "\" failed");
-						throw Parent::Service_denied();
-					}
+				if (!service_wildcard) {
+					warning(name(), ": lookup to child "
+					        "server \"", server_name, "\" failed");
+					throw Parent::Service_denied();
 				}
+			}
 
-				if (target.has_type("any-child")) {
+			if (target->type == Route_model::Target::ANY_CHILD) {
 
-					if (is_ambiguous(_child_services, service_name)) {
-						error(name(), ": ambiguous routes to "
-						      "service \"", service_name, "\"");
-						throw Parent::Service_denied();
-					}
+				if (is_ambiguous(_child_services, service_name)) {
+					error(name(), ": ambiguous routes to "
+					      "service \"", service_name, "\"");
+					throw Parent::Service_denied();
+				}
 
-					Routed_service *service = nullptr;
+				Routed_service *service = nullptr;
 
-					if ((service = find_service(_child_services, service_name)))
-						return Route { *service, target_label };
+				if ((service = find_service(_child_services, service_name)))
+					return Route { *service, target_label };
 
-					if (!service_wildcard) {
-						warning(name(), ": lookup for service "
-						        "\"", service_name, "\" failed");
-						throw Parent::Service_denied();
-					}
+				if (!service_wildcard) {
+					warning(name(), ": lookup for service "
+					        "\"", service_name, "\" failed");
+					throw Parent::Service_denied();
 				}
-
-				if (target.last())
-					break;
 			}
 		}
-	} catch (Xml_node::Nonexistent_sub_node) { }
+	}
 
 	warning(name(), ": no route to service \"", service_name, "\"");
 	throw Parent::Service_denied();
@@ -651,6 +648,8 @@ Init::Child::Child(Env                      &env,
 		.for_each_sub_node("service",
 		                   [&] (Xml_node node) { _add_service(node); });
 
+	_update_route_model(start_node);
+
 	/*
 	 * Construct inline config ROM service if "config" node is present.
 	 */
@@ -661,6 +660,9 @@ Init::Child::Child(Env                      &env,
 
 Init::Child::~Child()
 {
+	if (_route_model)
+		destroy(_alloc, _route_model);
+
 	_child_services.for_each([&] (Routed_service &service) {
 		if (service.has_id_space(_session_requester.id_space()))
 			destroy(_alloc, &service); });
@@ -28,6 +28,7 @@
 #include <name_registry.h>
 #include <service.h>
 #include <utils.h>
+#include <route_model.h>
 
 namespace Init { class Child; }
 
@@ -47,7 +48,7 @@ class Init::Child : Child_policy, Child_service::Wakeup
 		 */
 		struct Id { unsigned value; };
 
-		struct Default_route_accessor { virtual Xml_node default_route() = 0; };
+		struct Default_route_accessor { virtual Route_model const &default_route() = 0; };
 
 		struct Ram_limit_accessor { virtual Ram_quota ram_limit() = 0; };
 
@@ -82,6 +83,52 @@ class Init::Child : Child_policy, Child_service::Wakeup
 
 		Default_route_accessor &_default_route_accessor;
 
+		/*
+		 * Routing policy of the '<route>' node, if present
+		 */
+		Route_model *_route_model = nullptr;
+
+		static bool _route_differs(Xml_node old_start, Xml_node new_start)
+		{
+			char const * const tag = "route";
+			if (old_start.has_sub_node(tag) != new_start.has_sub_node(tag))
+				return true;
+
+			if (!new_start.has_sub_node(tag))
+				return false;
+
+			Xml_node const old_route = old_start.sub_node(tag);
+			Xml_node const new_route = new_start.sub_node(tag);
+
+			return old_route.size() != new_route.size()
+			    || Genode::memcmp(old_route.addr(), new_route.addr(), new_route.size());
+		}
+
+		/**
+		 * Replace routing policy by the one of 'start_node'
+		 *
+		 * The new model is built before the old one is dropped. So the
+		 * old policy stays in effect if the new one cannot be built.
+		 *
+		 * \throw Allocator::Out_of_memory
+		 */
+		void _update_route_model(Xml_node start_node)
+		{
+			Route_model *model = start_node.has_sub_node("route")
+			                   ? new (_alloc) Route_model(_alloc, start_node.sub_node("route"))
+			                   : nullptr;
+			if (_route_model)
+				destroy(_alloc, _route_model);
+
+			_route_model = model;
+		}
+
+		Route_model const &_effective_route_model()
+		{
+			return _route_model ? *_route_model
+			                    : _default_route_accessor.default_route();
+		}
+
 		Ram_limit_accessor &_ram_limit_accessor;
 
 		Name_registry &_name_registry;
@@ -389,6 +436,12 @@ class Init::Child : Child_policy, Child_service::Wakeup
 
 		Ram_quota ram_quota() const { return _resources.assigned_ram_quota; }
 
+		/**
+		 * Return memory allocated from init's heap for the routing policy
+		 */
+		size_t route_model_size() const {
+			return _route_model ? sizeof(Route_model) + _route_model->consumed() : 0; }
+
 		void initiate_env_ram_session()
 		{
 			if (_state == STATE_INITIAL) {
@@ -431,10 +484,17 @@ class Init::Child : Child_policy, Child_service::Wakeup
 		/**
 		 * Apply new configuration to child
 		 *
+		 * \param routes_changed  true if session routes may have changed
+		 *                        independent of the start node, i.e., by a
+		 *                        change of the default route, the aliases,
+		 *                        or the available services. Otherwise, the
+		 *                        routes of the existing sessions are
+		 *                        re-validated only if the start node changed.
+		 *
 		 * \throw Allocator::Out_of_memory  unable to allocate buffer for new
 		 *                                  config
 		 */
-		Apply_config_result apply_config(Xml_node start_node);
+		Apply_config_result apply_config(Xml_node start_node, bool routes_changed);
 
 		void apply_ram_upgrade();
 		void apply_ram_downgrade();
@@ -42,8 +42,16 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Constructible<Buffered_xml> _default_route;
 
+	Reconstructible<Route_model> _default_route_model { _heap, Xml_node("<empty/>") };
+
 	unsigned _child_cnt = 0;
 
+	/*
+	 * Children started since the last config update may provide services
+	 * that affect the routes of existing sessions
+	 */
+	bool _children_started = false;
+
 	static Ram_quota _preserved_ram_from_config(Xml_node config)
 	{
 		Number_of_bytes preserve { 40*sizeof(long)*1024 };
@@ -89,21 +97,23 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	/**
 	 * Default_route_accessor interface
 	 */
-	Xml_node default_route() override
-	{
-		return _default_route.constructed() ? _default_route->xml()
-		                                    : Xml_node("<empty/>");
-	}
+	Route_model const &default_route() override { return *_default_route_model; }
 
 	State_reporter _state_reporter { _env, *this };
 
 	Signal_handler<Main> _resource_avail_handler {
 		_env.ep(), *this, &Main::_handle_resource_avail };
 
-	void _update_aliases_from_config();
-	void _update_parent_services_from_config();
-	void _abandon_obsolete_children();
-	void _update_children_config();
+	/*
+	 * The following methods return true if the update may have changed the
+	 * routes of existing sessions
+	 */
+	bool _update_default_route_from_config();
+	bool _update_aliases_from_config();
+	bool _update_parent_services_from_config();
+	bool _abandon_obsolete_children();
+
+	void _update_children_config(bool routes_changed);
 	void _destroy_abandoned_parent_services();
 	void _handle_config();
 
@@ -124,12 +134,32 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 };
 
 
-void Init::Main::_update_parent_services_from_config()
+bool Init::Main::_update_default_route_from_config()
+{
+	if (!_config.xml().has_sub_node("default-route"))
+		return false;
+
+	Xml_node const node = _config.xml().sub_node("default-route");
+
+	if (_default_route.constructed()
+	 && node.size() == _default_route->xml().size()
+	 && !Genode::memcmp(node.addr(), _default_route->xml().addr(), node.size()))
+		return false;
+
+	_default_route.construct(_heap, node);
+	_default_route_model.construct(_heap, _default_route->xml());
+	return true;
+}
+
+
+bool Init::Main::_update_parent_services_from_config()
 {
 	Xml_node const node = _config.xml().has_sub_node("parent-provides")
 	                    ? _config.xml().sub_node("parent-provides")
 	                    : Xml_node("<empty/>");
 
+	bool changed = false;
+
 	/* remove services that are no longer present in config */
 	_parent_services.for_each([&] (Parent_service &service) {
 
@@ -140,8 +170,10 @@ void Init::Main::_update_parent_services_from_config()
 			if (name == service.attribute_value("name", Service::Name())) {
 				obsolete = false; }});
 
-		if (obsolete)
+		if (obsolete && !service.abandoned()) {
 			service.abandon();
+			changed = true;
+		}
 	});
 
 	if (_verbose->enabled())
@@ -159,10 +191,13 @@ void Init::Main::_update_parent_services_from_config()
 
 		if (!registered) {
 			new (_heap) Init::Parent_service(_parent_services, _env, name);
+			changed = true;
 			if (_verbose->enabled())
 				log("  service \"", name, "\"");
 		}
 	});
+
+	return changed;
 }
 
 
@@ -174,8 +209,26 @@ void Init::Main::_destroy_abandoned_parent_services()
 }
 
 
-void Init::Main::_update_aliases_from_config()
+bool Init::Main::_update_aliases_from_config()
 {
+	/* check whether the aliases differ from the known ones */
+	unsigned num_aliases = 0, num_known = 0;
+	bool     changed     = false;
+	_config.xml().for_each_sub_node("alias", [&] (Xml_node alias_node) {
+		num_aliases++;
+
+		Alias::Name  const name  = alias_node.attribute_value("name",  Alias::Name());
+		Alias::Child const child = alias_node.attribute_value("child", Alias::Child());
+
+		if (_children.deref_alias(name) != child)
+			changed = true;
+	});
+	for (Alias const *a = _children.any_alias(); a; a = a->next())
+		num_known++;
+
+	if (!changed && num_aliases == num_known)
+		return false;
+
 	/* remove all known aliases */
 	while (_children.any_alias()) {
 		Init::Alias *alias = _children.any_alias();
@@ -193,11 +246,15 @@ void Init::Main::_update_aliases_from_config()
 		catch (Alias::Child_is_missing) {
 			warning("missing 'child' attribute in '<alias>' entry"); }
 	});
+
+	return true;
 }
 
 
-void Init::Main::_abandon_obsolete_children()
+bool Init::Main::_abandon_obsolete_children()
 {
+	bool abandoned = false;
+
 	_children.for_each_child([&] (Child &child) {
 
 		Child_policy::Name const name = child.name();
@@ -207,13 +264,17 @@ void Init::Main::_abandon_obsolete_children()
 			if (node.attribute_value("name", Child_policy::Name()) == name)
 				obsolete = false; });
 
-		if (obsolete)
+		if (obsolete) {
 			child.abandon();
+			abandoned = true;
+		}
 	});
+
+	return abandoned;
 }
 
 
-void Init::Main::_update_children_config()
+void Init::Main::_update_children_config(bool routes_changed)
 {
 	for (;;) {
 
@@ -232,7 +293,7 @@ void Init::Main::_update_children_config()
 
 			_children.for_each_child([&] (Child &child) {
 				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
+					switch (child.apply_config(node, routes_changed)) {
 					case Child::NO_SIDE_EFFECTS: break;
 					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
 					};
@@ -242,6 +303,9 @@ void Init::Main::_update_children_config()
 
 		if (!side_effects)
 			break;
+
+		/* side effects may affect the routes of any child */
+		routes_changed = true;
 	}
 }
 
@@ -253,18 +317,24 @@ void Init::Main::_handle_config()
 	_verbose.construct(_config.xml());
 	_state_reporter.apply_config(_config.xml());
 
-	/* determine default route for resolving service requests */
-	try {
-		_default_route.construct(_heap, _config.xml().sub_node("default-route")); }
-	catch (...) { }
-
 	Prio_levels     const prio_levels    = prio_levels_from_xml(_config.xml());
 	Affinity::Space const affinity_space = affinity_space_from_xml(_config.xml());
 
-	_update_aliases_from_config();
-	_update_parent_services_from_config();
-	_abandon_obsolete_children();
-	_update_children_config();
+	/*
+	 * The routes of existing sessions are re-validated only for children
+	 * with a changed start node, unless the update affects the routing of
+	 * all children.
+	 */
+	bool routes_changed = _children_started;
+
+	routes_changed |= _update_default_route_from_config();
+	routes_changed |= _update_aliases_from_config();
+	routes_changed |= _update_parent_services_from_config();
+	routes_changed |= _abandon_obsolete_children();
+
+	_children_started = false;
+
+	_update_children_config(routes_changed);
 
 	/* kill abandoned children */
 	_children.for_each_child([&] (Child &child) {
@@ -309,10 +379,15 @@ void Init::Main::_handle_config()
 					             *this, prio_levels, affinity_space,
 					            _parent_services, _child_services);
 				_children.insert(&child);
+				_children_started = true;
 
-				/* account for the start XML node buffered in the child */
+				/*
+				 * Account for the start XML node buffered in the child and
+				 * the child's routing policy
+				 */
 				size_t const metadata_overhead = start_node.size()
-				                               + sizeof(Init::Child);
+				                               + sizeof(Init::Child)
+				                               + child.route_model_size();
 				/* track used memory and RAM limit */
 				used_ram = Ram_quota { used_ram.value
 				                     + child.ram_quota().value
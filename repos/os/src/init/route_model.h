@@ -0,0 +1,411 @@
+/*
+ * \brief  Compiled representation of a session-routing policy
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__ROUTE_MODEL_H_
+#define _SRC__INIT__ROUTE_MODEL_H_
+
+/* Genode includes */
+#include <base/child.h>
+#include <base/log.h>
+#include <util/avl_string.h>
+#include <util/noncopyable.h>
+
+/* local includes */
+#include <types.h>
+#include <utils.h>
+
+namespace Init { class Route_model; }
+
+
+/**
+ * Session-routing policy as given by a '<route>' or '<default-route>' node
+ *
+ * The model is created once per configuration and evaluated for each session
+ * request. Rules are grouped by service name. Each group holds the rules
+ * for its service together with the '<any-service>' rules, in the order of
+ * the configuration. A session request therefore visits only the rules that
+ * may apply to the requested service, and no XML is parsed.
+ */
+class Init::Route_model : Noncopyable
+{
+	public:
+
+		typedef String<Session_label::capacity()> Label;
+
+		struct Target : List<Target>::Element
+		{
+			enum Type { PARENT, CHILD, ANY_CHILD };
+
+			Type               const type;
+			Child_policy::Name const name;           /* server of CHILD target */
+			bool               const label_present;  /* label is overridden    */
+			Label              const label;
+
+			static Type _type(Xml_node node)
+			{
+				if (node.has_type("child"))     return CHILD;
+				if (node.has_type("any-child")) return ANY_CHILD;
+				return PARENT;
+			}
+
+			Target(Xml_node node)
+			:
+				type(_type(node)),
+				name(node.attribute_value("name", Child_policy::Name())),
+				label_present(node.has_attribute("label")),
+				label(node.attribute_value("label", Label()))
+			{ }
+
+			/**
+			 * Return session label to be provided to the server
+			 *
+			 * By default, the client's identity (accompanied with the a
+			 * client-provided label) is presented as session label to the
+			 * server. However, the target node can explicitly override the
+			 * client's identity by a custom label via the 'label'
+			 * attribute.
+			 */
+			Label server_label(Session_label const &label) const {
+				return label_present ? this->label : Label(label.string()); }
+		};
+
+		class Rule : Noncopyable
+		{
+			private:
+
+				friend class Route_model;
+
+				List<Target> _targets;
+				Rule        *_next = nullptr;   /* next rule in config order */
+
+				Target *_last_target() const
+				{
+					Target *last = _targets.first();
+					for (; last && last->next(); last = last->next());
+					return last;
+				}
+
+			public:
+
+				bool          const any_service;
+				Service::Name const service;
+
+				/*
+				 * A service node without name is malformed and denies
+				 * each session request that reaches it
+				 */
+				bool          const nameless;
+
+				/*
+				 * A matching service node without any sub node denies the
+				 * session instead of deferring to the subsequent rules
+				 */
+				bool          const denies;
+
+				/*
+				 * Label conditions, the scoped conditions refer to the
+				 * label with the child name stripped
+				 */
+				bool  const unscoped_present;
+				Label const unscoped;
+				bool  const label_present;
+				Label const label;
+				bool  const prefix_present;
+				Label const prefix;
+				bool  const suffix_present;
+				Label const suffix;
+
+				Rule(Allocator &alloc, Xml_node node)
+				:
+					any_service(node.has_type("any-service")),
+					service(node.attribute_value("name", Service::Name())),
+					nameless(!any_service && !node.has_attribute("name")),
+					denies(nameless || node.num_sub_nodes() == 0),
+					unscoped_present(node.has_attribute("unscoped_label")),
+					unscoped(node.attribute_value("unscoped_label", Label())),
+					label_present (node.has_attribute("label")),
+					label         (node.attribute_value("label",        Label())),
+					prefix_present(node.has_attribute("label_prefix")),
+					prefix        (node.attribute_value("label_prefix", Label())),
+					suffix_present(node.has_attribute("label_suffix")),
+					suffix        (node.attribute_value("label_suffix", Label()))
+				{
+					if (unscoped_present && (label_present || prefix_present || suffix_present))
+						warning("service node contains both scoped and unscoped label attributes");
+
+					node.for_each_sub_node([&] (Xml_node target) {
+						if (target.has_type("parent") || target.has_type("child")
+						 || target.has_type("any-child"))
+							_targets.insert(new (alloc) Target(target), _last_target()); });
+				}
+
+				void destroy_targets(Allocator &alloc)
+				{
+					while (Target *target = _targets.first()) {
+						_targets.remove(target);
+						destroy(alloc, target);
+					}
+				}
+
+				/**
+				 * Return true if the rule applies to a session request
+				 *
+				 * \param child_name  name of the originator of the request
+				 * \param label       session label as provided by the child
+				 *
+				 * The conditions are evaluated like the ones of a
+				 * 'Session_policy'. An 'unscoped_label' takes precedence
+				 * over the scoped label attributes.
+				 */
+				bool matches(Child_policy::Name const &child_name,
+				             Session_label      const &session_label) const
+				{
+					if (nameless)
+						return true;
+
+					if (unscoped_present)
+						return session_label == unscoped;
+
+					if (!label_present && !prefix_present && !suffix_present)
+						return true;
+
+					char const * const scoped = skip_label_prefix(
+						child_name.string(), session_label.string());
+
+					if (!scoped)
+						return false;
+
+					Label  const scoped_label(scoped);
+					size_t const len = scoped_label.length() - 1;
+
+					if (label_present && scoped_label != label)
+						return false;
+
+					if (prefix_present
+					 && strcmp(scoped, prefix.string(), prefix.length() - 1))
+						return false;
+
+					if (suffix_present) {
+						size_t const suffix_len = suffix.length() - 1;
+						if (len < suffix_len
+						 || strcmp(scoped_label.string() + len - suffix_len,
+						           suffix.string()))
+							return false;
+					}
+					return true;
+				}
+
+				Target const *first_target() const { return _targets.first(); }
+		};
+
+		/**
+		 * Rules that may apply to a service, in the order of the config
+		 */
+		class Service_rules : public Avl_string<Service::Name::capacity()>
+		{
+			private:
+
+				friend class Route_model;
+
+				Rule const **_rules = nullptr;
+				unsigned     _num   = 0;
+
+			public:
+
+				Service_rules(Service::Name const &name)
+				: Avl_string<Service::Name::capacity()>(name.string()) { }
+
+				unsigned num() const { return _num; }
+
+				Rule const &rule(unsigned i) const { return *_rules[i]; }
+		};
+
+	private:
+
+		/**
+		 * Allocator wrapper that tracks the memory taken by the model
+		 *
+		 * The model is allocated from init's heap on behalf of a child.
+		 * Hence, its size must be accounted like the child's other
+		 * meta data.
+		 */
+		class Counting_allocator : public Allocator
+		{
+			private:
+
+				Allocator &_alloc;
+				size_t     _consumed = 0;
+
+			public:
+
+				Counting_allocator(Allocator &alloc) : _alloc(alloc) { }
+
+				using Allocator::alloc;
+
+				bool alloc(size_t size, void **out_addr) override
+				{
+					if (!_alloc.alloc(size, out_addr))
+						return false;
+
+					_consumed += size + _alloc.overhead(size);
+					return true;
+				}
+
+				void free(void *addr, size_t size) override
+				{
+					_alloc.free(addr, size);
+					_consumed -= size + _alloc.overhead(size);
+				}
+
+				bool   need_size_for_free()  const override { return true; }
+				size_t overhead(size_t size) const override { return _alloc.overhead(size); }
+				size_t consumed()            const override { return _consumed; }
+		};
+
+		Counting_allocator   _alloc;
+		Rule                *_first = nullptr;
+		Avl_tree<Avl_string_base> _services;
+		Service_rules        _any_service { Service::Name() };
+
+		/* buckets of '_services', for iterating over all of them */
+		Service_rules      **_buckets     = nullptr;
+		unsigned             _num_buckets = 0;
+		unsigned             _num_rules   = 0;
+
+		template <typename FN>
+		void _for_each_rule(FN const &fn)
+		{
+			for (Rule *rule = _first; rule; rule = rule->_next)
+				fn(*rule);
+		}
+
+		template <typename FN>
+		void _for_each_bucket(FN const &fn)
+		{
+			fn(_any_service);
+			for (unsigned i = 0; i < _num_buckets; i++)
+				fn(*_buckets[i]);
+		}
+
+		Service_rules *_lookup(Service::Name const &name) const
+		{
+			Avl_string_base *node = _services.first();
+			return node ? static_cast<Service_rules *>(node->find_by_name(name.string()))
+			            : nullptr;
+		}
+
+		static bool _applies(Rule const &rule, Service_rules const &bucket) {
+			return rule.any_service || rule.nameless
+			    || rule.service == Service::Name(bucket.name()); }
+
+		void _destroy()
+		{
+			_for_each_bucket([&] (Service_rules &bucket) {
+				if (bucket._rules)
+					_alloc.free(bucket._rules, bucket._num*sizeof(Rule const *)); });
+
+			for (unsigned i = 0; i < _num_buckets; i++)
+				destroy(_alloc, _buckets[i]);
+
+			if (_buckets)
+				_alloc.free(_buckets, _num_rules*sizeof(Service_rules *));
+
+			while (Rule *rule = _first) {
+				_first = rule->_next;
+				rule->destroy_targets(_alloc);
+				destroy(_alloc, rule);
+			}
+		}
+
+		void _build(Xml_node route)
+		{
+			/* create rules in config order */
+			Rule **tail = &_first;
+			route.for_each_sub_node([&] (Xml_node node) {
+				if (!node.has_type("any-service") && !node.has_type("service"))
+					return;
+
+				if (node.has_type("service") && !node.has_attribute("name"))
+					warning("route contains service node without name, "
+					        "session requests reaching it are denied");
+
+				*tail = new (_alloc) Rule(_alloc, node);
+				tail  = &(*tail)->_next;
+				_num_rules++;
+			});
+
+			if (!_num_rules)
+				return;
+
+			/* create one bucket per distinct service name */
+			_buckets = (Service_rules **)_alloc.alloc(_num_rules*sizeof(Service_rules *));
+			_for_each_rule([&] (Rule const &rule) {
+				if (rule.any_service || rule.nameless || _lookup(rule.service))
+					return;
+
+				Service_rules *bucket = new (_alloc) Service_rules(rule.service);
+				_services.insert(bucket);
+				_buckets[_num_buckets++] = bucket;
+			});
+
+			/* populate buckets */
+			_for_each_bucket([&] (Service_rules &bucket) {
+				_for_each_rule([&] (Rule const &rule) {
+					bucket._num += _applies(rule, bucket); });
+
+				if (!bucket._num)
+					return;
+
+				bucket._rules = (Rule const **)_alloc.alloc(bucket._num*sizeof(Rule const *));
+
+				unsigned i = 0;
+				_for_each_rule([&] (Rule const &rule) {
+					if (_applies(rule, bucket))
+						bucket._rules[i++] = &rule; });
+			});
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param route  '<route>' or '<default-route>' node
+		 *
+		 * \throw Allocator::Out_of_memory
+		 */
+		Route_model(Allocator &alloc, Xml_node route) : _alloc(alloc)
+		{
+			try { _build(route); }
+			catch (...) { _destroy(); throw; }
+		}
+
+		~Route_model() { _destroy(); }
+
+		/**
+		 * Return amount of memory allocated for the model, including the
+		 * allocator's meta data
+		 */
+		size_t consumed() const { return _alloc.consumed(); }
+
+		/**
+		 * Return rules to evaluate for a session request for 'service'
+		 */
+		Service_rules const &rules(Service::Name const &service) const
+		{
+			Service_rules const *bucket = _lookup(service);
+			return bucket ? *bucket : _any_service;
+		}
+};
+
+#endif /* _SRC__INIT__ROUTE_MODEL_H_ */
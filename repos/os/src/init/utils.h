@@ -49,60 +49,6 @@ namespace Init {
 	}
 
 
-	/**
-	 * Return true if service XML node matches service request
-	 *
-	 * \param args          session arguments, inspected for the session label
-	 * \param child_name    name of the originator of the session request
-	 * \param service_name  name of the requested service
-	 */
-	inline bool service_node_matches(Xml_node           const  service_node,
-	                                 Session_label      const &label,
-	                                 Child_policy::Name const &child_name,
-	                                 Service::Name      const &service_name)
-	{
-		bool const service_matches =
-			service_node.has_type("any-service") ||
-			(service_node.has_type("service") &&
-			 service_node.attribute("name").has_value(service_name.string()));
-
-		if (!service_matches)
-			return false;
-
-		bool const route_depends_on_child_provided_label =
-			service_node.has_attribute("label") ||
-			service_node.has_attribute("label_prefix") ||
-			service_node.has_attribute("label_suffix");
-
-		char const *unscoped_attr = "unscoped_label";
-		if (service_node.has_attribute(unscoped_attr)) {
-
-			/*
-			 * If an 'unscoped_label' attribute is provided, don't consider any
-			 * scoped label attribute.
-			 */
-			if (route_depends_on_child_provided_label)
-				warning("service node contains both scoped and unscoped label attributes");
-
-			typedef String<Session_label::capacity()> Label;
-			return label == service_node.attribute_value(unscoped_attr, Label());
-		}
-
-		if (!route_depends_on_child_provided_label)
-			return true;
-
-		char const * const scoped_label = skip_label_prefix(
-			child_name.string(), label.string());
-
-		if (!scoped_label)
-			return false;
-
-		Session_label const session_label(scoped_label);
-
-		return !Xml_node_label_score(service_node, session_label).conflict();
-	}
-
-
 	/**
 	 * Check if service name is ambiguous
 	 *
@@ -17,66 +17,105 @@
 using namespace Genode;
 
 
-void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+static inline uint64_t bit(unsigned idx) { return (uint64_t)1 << idx; }
+
+
+Alarm_scheduler::Alarm_scheduler()
+:
+	/*
+	 * Start the monotonic time far enough from zero to express deadlines in
+	 * the past, which are given relative to '_now' as signed 32-bit values
+	 */
+	_now(0), _time(bit(32)), _wheel_time(_time), _overdue(0)
 {
-	if (alarm->_active) {
-		error("trying to insert the same alarm twice!");
-		return;
+	for (unsigned level = 0; level < LEVELS; level++) {
+		_occupied[level] = 0;
+		for (unsigned slot = 0; slot < SLOTS; slot++)
+			_slots[level][slot] = 0;
 	}
+}
 
-	alarm->_active++;
 
-	/* if alarmlist is empty add first element */
-	if (!_head) {
-		alarm->_next = 0;
-		_head = alarm;
-		return;
-	}
+void Alarm_scheduler::_insert(Alarm &alarm)
+{
+	Alarm **head = &_overdue;
 
-	/* if deadline is smaller than any other deadline, put it on the head */
-	if ((int)alarm->_deadline - (int)_now < (int)_head->_deadline - (int)_now) {
-		alarm->_next = _head;
-		_head = alarm;
-		return;
-	}
+	alarm._level = OVERDUE;
+	alarm._slot  = 0;
 
-	/* find list element with a higher deadline */
-	Alarm *curr = _head;
-	while (curr->_next &&
-	       (int)curr->_next->_deadline - (int)_now < (int)alarm->_deadline - (int)_now)
-		curr = curr->_next;
+	if (alarm._key >= _wheel_time) {
 
-	/* if end of list is reached, append new element */
-	if (curr->_next == 0) {
-		curr->_next = alarm;
-		return;
+		/* select level by the most significant differing digit */
+		uint64_t const diff = alarm._key ^ _wheel_time;
+		alarm._level = diff ? (63 - __builtin_clzll(diff)) / SLOT_BITS : 0;
+		alarm._slot  = (alarm._key >> (alarm._level * SLOT_BITS)) & (SLOTS - 1);
+
+		head = &_slots[alarm._level][alarm._slot];
+		_occupied[alarm._level] |= bit(alarm._slot);
 	}
 
-	/* insert element in middle of list */
-	alarm->_next = curr->_next;
-	curr->_next  = alarm;
+	alarm._next      = *head;
+	alarm._prev_next = head;
+	if (*head)
+		(*head)->_prev_next = &alarm._next;
+
+	*head = &alarm;
 }
 
 
-void Alarm_scheduler::_unsynchronized_dequeue(Alarm *alarm)
+void Alarm_scheduler::_remove(Alarm &alarm)
 {
-	if (!_head) return;
+	*alarm._prev_next = alarm._next;
+	if (alarm._next)
+		alarm._next->_prev_next = alarm._prev_next;
 
-	if (_head == alarm) {
-		_head = alarm->_next;
-		alarm->_reset();
+	if (alarm._level != OVERDUE && !_slots[alarm._level][alarm._slot])
+		_occupied[alarm._level] &= ~bit(alarm._slot);
+
+	alarm._next      = 0;
+	alarm._prev_next = 0;
+}
+
+
+unsigned Alarm_scheduler::_first_level() const
+{
+	unsigned level = 0;
+	for (; level < LEVELS && !_occupied[level]; level++);
+	return level;
+}
+
+
+uint64_t Alarm_scheduler::_slot_key(unsigned level, unsigned slot) const
+{
+	unsigned const shift = level * SLOT_BITS;
+	uint64_t const upper = shift + SLOT_BITS < 64
+	                     ? _wheel_time & (~(uint64_t)0 << (shift + SLOT_BITS))
+	                     : 0;
+	return upper | ((uint64_t)slot << shift);
+}
+
+
+void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+{
+	if (alarm->_active) {
+		error("trying to insert the same alarm twice!");
 		return;
 	}
 
-	/* find predecessor in alarm queue */
-	Alarm *curr;
-	for (curr = _head; curr && (curr->_next != alarm); curr = curr->_next);
+	alarm->_active++;
+
+	/* deadlines are interpreted relative to '_now' as in former versions */
+	alarm->_key = _time + (int64_t)(int)(alarm->_deadline - _now);
+	_insert(*alarm);
+}
 
+
+void Alarm_scheduler::_unsynchronized_dequeue(Alarm *alarm)
+{
 	/* alarm is not enqueued */
-	if (!curr) return;
+	if (!alarm->_active || !alarm->_prev_next) return;
 
-	/* remove alarm from alarm queue */
-	curr->_next = alarm->_next;
+	_remove(*alarm);
 	alarm->_reset();
 }
 
@@ -85,12 +124,47 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 {
 	Lock::Guard lock_guard(_lock);
 
-	if (!_head || ((int)_head->_deadline - (int)_now >= 0))
-		return 0;
+	Alarm *pending_alarm = _overdue;
+
+	while (!pending_alarm) {
+
+		unsigned const level = _first_level();
+
+		/* adjust reference time of empty wheel */
+		if (level == LEVELS) {
+			_wheel_time = _time;
+			return 0;
+		}
+
+		unsigned const slot = __builtin_ctzll(_occupied[level]);
+		uint64_t const key  = _slot_key(level, slot);
+
+		if (level == 0) {
+			if (key >= _time)
+				return 0;
+
+			pending_alarm = _slots[0][slot];
+			break;
+		}
+
+		if (key > _time)
+			return 0;
+
+		/* advance reference time to the slot and redistribute its alarms */
+		_wheel_time = key;
 
-	/* remove alarm from head of the list */
-	Alarm *pending_alarm = _head;
-	_head = _head->_next;
+		Alarm *alarm = _slots[level][slot];
+		_slots[level][slot] = 0;
+		_occupied[level] &= ~bit(slot);
+
+		while (alarm) {
+			Alarm *next = alarm->_next;
+			_insert(*alarm);
+			alarm = next;
+		}
+	}
+
+	_remove(*pending_alarm);
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of 'on_alarm'
@@ -99,7 +173,6 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 	pending_alarm->_dispatch_lock.lock();
 
 	/* reset alarm object */
-	pending_alarm->_next = 0;
 	pending_alarm->_active--;
 
 	return pending_alarm;
@@ -109,7 +182,21 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 void Alarm_scheduler::handle(Alarm::Time curr_time)
 {
 	Alarm *curr;
-	_now = curr_time;
+
+	/*
+	 * Update the time under the lock because the 64-bit '_time' is not
+	 * accessed atomically on 32-bit platforms.
+	 */
+	{
+		Lock::Guard lock_guard(_lock);
+
+		/* ignore time going backwards to keep '_time' monotonic */
+		int const elapsed = curr_time - _now;
+		if (elapsed > 0)
+			_time += elapsed;
+
+		_now = curr_time;
+	}
 
 	while ((curr = _get_pending_alarm())) {
 
@@ -130,14 +217,15 @@ void Alarm_scheduler::handle(Alarm::Time curr_time)
 
 		if (reschedule) {
 
+			/* synchronize enqueue operation */
+			Lock::Guard lock_guard(_lock);
+
 			/* schedule next event */
 			if (curr->_deadline == 0)
 				curr->_deadline = _now;
 
 			curr->_deadline += triggered * curr->_period;
 
-			/* synchronize enqueue operation */
-			Lock::Guard lock_guard(_lock);
 			_unsynchronized_enqueue(curr);
 		}
 
@@ -215,28 +303,56 @@ bool Alarm_scheduler::next_deadline(Alarm::Time *deadline)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
-	if (!_head) return false;
+	if (_overdue) {
+		if (deadline)
+			*deadline = _overdue->_deadline;
+		return true;
+	}
 
-	if (deadline)
-		*deadline = _head->_deadline;
+	unsigned const level = _first_level();
+	if (level == LEVELS) return false;
 
+	if (deadline) {
+		unsigned const slot = __builtin_ctzll(_occupied[level]);
+		*deadline = _now + (Alarm::Time)(_slot_key(level, slot) - _time);
+	}
 	return true;
 }
 
 
-Alarm_scheduler::~Alarm_scheduler()
+bool Alarm_scheduler::head_timeout(const Alarm * alarm)
 {
-	Lock::Guard lock_guard(_lock);
+	Lock::Guard alarm_list_lock_guard(_lock);
 
-	while (_head) {
+	if (!alarm->_active || !alarm->_prev_next)
+		return false;
 
-		Alarm *next = _head->_next;
+	if (_overdue)
+		return alarm->_level == OVERDUE;
 
-		/* reset alarm object */
-		_head->_reset();
+	unsigned const level = _first_level();
+	return level < LEVELS && alarm->_level == level &&
+	       alarm->_slot == (unsigned)__builtin_ctzll(_occupied[level]);
+}
+
+
+Alarm_scheduler::~Alarm_scheduler()
+{
+	Lock::Guard lock_guard(_lock);
 
-		/* remove from list */
-		_head = next;
+	/* reset alarm objects */
+	while (Alarm *alarm = _overdue) {
+		_overdue = alarm->_next;
+		alarm->_reset();
+	}
+
+	for (unsigned level = 0; level < LEVELS; level++) {
+		for (unsigned slot = 0; slot < SLOTS; slot++) {
+			while (Alarm *alarm = _slots[level][slot]) {
+				_slots[level][slot] = alarm->_next;
+				alarm->_reset();
+			}
+		}
 	}
 }
 
@@ -0,0 +1,90 @@
+/*
+ * \brief  Row operations on RGB565 and RGB888 pixels
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The bulk of each row is processed by the platform-specific kernels of
+ * 'blend_helper.h'. The remaining pixels are handled by the scalar
+ * operations of the pixel types, which define the expected results.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <blit/blit.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <blend_helper.h>
+
+using Genode::Pixel_rgb565;
+using Genode::Pixel_rgb888;
+
+
+extern "C" void blend_rgb565(void const *s, unsigned char const *alpha,
+                             void *d, int num)
+{
+	Pixel_rgb565 const *src = (Pixel_rgb565 const *)s;
+	Pixel_rgb565       *dst = (Pixel_rgb565       *)d;
+
+	for (int i = blend_rgb565_chunks(s, alpha, d, num); i < num; i++)
+		if (alpha[i])
+			dst[i] = Pixel_rgb565::mix(dst[i], src[i], alpha[i]);
+}
+
+
+extern "C" void blend_rgb888(void const *s, unsigned char const *alpha,
+                             void *d, int num)
+{
+	Pixel_rgb888 const *src = (Pixel_rgb888 const *)s;
+	Pixel_rgb888       *dst = (Pixel_rgb888       *)d;
+
+	for (int i = blend_rgb888_chunks(s, alpha, d, num); i < num; i++)
+		if (alpha[i])
+			dst[i] = Pixel_rgb888::mix(dst[i], src[i], alpha[i]);
+}
+
+
+extern "C" void copy_masked_rgb565(void const *s, void *d, int num)
+{
+	Pixel_rgb565 const *src = (Pixel_rgb565 const *)s;
+	Pixel_rgb565       *dst = (Pixel_rgb565       *)d;
+
+	for (int i = copy_masked_rgb565_chunks(s, d, num); i < num; i++)
+		if (src[i].pixel)
+			dst[i] = src[i];
+}
+
+
+extern "C" void copy_masked_rgb888(void const *s, void *d, int num)
+{
+	Pixel_rgb888 const *src = (Pixel_rgb888 const *)s;
+	Pixel_rgb888       *dst = (Pixel_rgb888       *)d;
+
+	for (int i = copy_masked_rgb888_chunks(s, d, num); i < num; i++)
+		if (src[i].pixel)
+			dst[i] = src[i];
+}
+
+
+extern "C" void convert_rgb565_to_rgb888(void const *s, void *d, int num)
+{
+	Pixel_rgb565 const *src = (Pixel_rgb565 const *)s;
+	Pixel_rgb888       *dst = (Pixel_rgb888       *)d;
+
+	for (int i = convert_rgb565_to_rgb888_chunks(s, d, num); i < num; i++)
+		dst[i].rgba(src[i].r(), src[i].g(), src[i].b());
+}
+
+
+extern "C" void convert_rgb888_to_rgb565(void const *s, void *d, int num)
+{
+	Pixel_rgb888 const *src = (Pixel_rgb888 const *)s;
+	Pixel_rgb565       *dst = (Pixel_rgb565       *)d;
+
+	for (int i = convert_rgb888_to_rgb565_chunks(s, d, num); i < num; i++)
+		dst[i].rgba(src[i].r(), src[i].g(), src[i].b());
+}
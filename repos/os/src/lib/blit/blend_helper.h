@@ -0,0 +1,33 @@
+/*
+ * \brief  Generic pixel-row kernels
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Each kernel processes a prefix of the row and returns the number of
+ * processed pixels. Without vector instructions, the whole row is left to
+ * the scalar operations of the caller.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__BLEND_HELPER_H_
+#define _LIB__BLIT__BLEND_HELPER_H_
+
+static inline int blend_rgb565_chunks(void const *, unsigned char const *,
+                                      void *, int) { return 0; }
+
+static inline int blend_rgb888_chunks(void const *, unsigned char const *,
+                                      void *, int) { return 0; }
+
+static inline int copy_masked_rgb565_chunks(void const *, void *, int) { return 0; }
+static inline int copy_masked_rgb888_chunks(void const *, void *, int) { return 0; }
+
+static inline int convert_rgb565_to_rgb888_chunks(void const *, void *, int) { return 0; }
+static inline int convert_rgb888_to_rgb565_chunks(void const *, void *, int) { return 0; }
+
+#endif /* _LIB__BLIT__BLEND_HELPER_H_ */
@@ -0,0 +1,221 @@
+/*
+ * \brief  Pixel-row kernels using SSE2
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The kernels are written with the vector extensions of GCC. On x86_64,
+ * SSE2 is always available and is used by the compiler for these vectors.
+ * The arithmetic mirrors the scalar operations of 'Pixel_rgb565' and
+ * 'Pixel_rgb888' so that the results are bit-identical.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SPEC__X86_64__BLEND_HELPER_H_
+#define _LIB__BLIT__SPEC__X86_64__BLEND_HELPER_H_
+
+typedef unsigned char  V16u8 __attribute__((vector_size(16)));
+typedef unsigned short V8u16 __attribute__((vector_size(16)));
+typedef unsigned int   V4u32 __attribute__((vector_size(16)));
+typedef short          V8s16 __attribute__((vector_size(16)));
+typedef int            V4s32 __attribute__((vector_size(16)));
+
+
+template <typename V>
+static inline V load(void const *src)
+{
+	V v;
+	__builtin_memcpy(&v, src, sizeof(v));
+	return v;
+}
+
+
+template <typename V>
+static inline void store(void *dst, V v) { __builtin_memcpy(dst, &v, sizeof(v)); }
+
+
+/**
+ * Return alpha values of 8 pixels as 16-bit lanes
+ */
+static inline V8u16 alpha_8(unsigned char const *alpha)
+{
+	V16u8 bytes = { };
+	__builtin_memcpy(&bytes, alpha, 8);
+
+	V16u8 const zero = { };
+	V16u8 const mask = { 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23 };
+	return (V8u16)__builtin_shuffle(bytes, zero, mask);
+}
+
+
+/**
+ * Return alpha values of 4 pixels as 32-bit lanes
+ */
+static inline V4u32 alpha_4(unsigned char const *alpha)
+{
+	V16u8 bytes = { };
+	__builtin_memcpy(&bytes, alpha, 4);
+
+	V16u8 const zero = { };
+	V16u8 const mask = { 0, 16, 16, 16, 1, 16, 16, 16,
+	                     2, 16, 16, 16, 3, 16, 16, 16 };
+	return (V4u32)__builtin_shuffle(bytes, zero, mask);
+}
+
+
+/**
+ * Counterpart of 'Pixel_rgb565::blend' for 8 pixels
+ */
+static inline V8u16 blend_565(V8u16 p, V8u16 alpha)
+{
+	V8u16 const a_5 = alpha >> 3;
+
+	return (((p >> 11) * a_5 >> 5) << 11)
+	     | ((((p >> 6) & 0x1f) * alpha >> 2) & 0x7c0)
+	     | ((p & 0x1f) * a_5 >> 5);
+}
+
+
+/**
+ * Counterpart of 'Pixel_rgb888::blend' for 4 pixels
+ *
+ * The color channels are multiplied as 16-bit lanes. Hence, the alpha
+ * value of each pixel is expected in both halves of its 32-bit lane.
+ */
+static inline V4u32 blend_888(V4u32 p, V8u16 alpha)
+{
+	V8u16 const rb = (V8u16)(p & 0xff00ff) * alpha >> 8;
+	V8u16 const ga = (V8u16)((p >> 8) & 0xff00ff) * alpha;
+
+	return (V4u32)rb | ((V4u32)ga & 0xff00);
+}
+
+
+static inline int blend_rgb565_chunks(void const *s, unsigned char const *alpha,
+                                      void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	int i = 0;
+	for (; i + 8 <= num; i += 8, src += 16, dst += 16, alpha += 8) {
+
+		V8u16 const a = alpha_8(alpha);
+		V8u16 const p = load<V8u16>(dst);
+
+		/* see 'Pixel_rgb565::mix' for the rationale behind 264 */
+		V8u16 const mixed = blend_565(p, 264 - a) + blend_565(load<V8u16>(src), a);
+		V8u16 const keep  = (V8u16)(a == 0);
+
+		store(dst, (mixed & ~keep) | (p & keep));
+	}
+	return i;
+}
+
+
+static inline int blend_rgb888_chunks(void const *s, unsigned char const *alpha,
+                                      void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	int i = 0;
+	for (; i + 4 <= num; i += 4, src += 16, dst += 16, alpha += 4) {
+
+		V4u32 const a     = alpha_4(alpha);
+		V4u32 const a_inv = 255 - a;
+		V4u32 const p     = load<V4u32>(dst);
+
+		V4u32 const mixed = blend_888(p, (V8u16)(a_inv | a_inv << 16))
+		                  + blend_888(load<V4u32>(src), (V8u16)(a | a << 16));
+		V4u32 const keep  = (V4u32)(a == 0);
+
+		store(dst, (mixed & ~keep) | (p & keep));
+	}
+	return i;
+}
+
+
+static inline int copy_masked_rgb565_chunks(void const *s, void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	int i = 0;
+	for (; i + 8 <= num; i += 8, src += 16, dst += 16) {
+		V8u16 const p    = load<V8u16>(src);
+		V8u16 const keep = (V8u16)(p == 0);
+		store(dst, p | (load<V8u16>(dst) & keep));
+	}
+	return i;
+}
+
+
+static inline int copy_masked_rgb888_chunks(void const *s, void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	int i = 0;
+	for (; i + 4 <= num; i += 4, src += 16, dst += 16) {
+		V4u32 const p    = load<V4u32>(src);
+		V4u32 const keep = (V4u32)(p == 0);
+		store(dst, p | (load<V4u32>(dst) & keep));
+	}
+	return i;
+}
+
+
+static inline V4u32 rgb565_to_rgb888(V4u32 p)
+{
+	return ((p & 0xf800) << 8) | ((p & 0x7e0) << 5) | ((p & 0x1f) << 3);
+}
+
+
+static inline int convert_rgb565_to_rgb888_chunks(void const *s, void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	V8u16 const zero = { };
+	V8u16 const lo   = { 0, 8, 1, 8, 2, 8, 3, 8 };
+	V8u16 const hi   = { 4, 8, 5, 8, 6, 8, 7, 8 };
+
+	int i = 0;
+	for (; i + 8 <= num; i += 8, src += 16, dst += 32) {
+		V8u16 const p = load<V8u16>(src);
+		store(dst,      rgb565_to_rgb888((V4u32)__builtin_shuffle(p, zero, lo)));
+		store(dst + 16, rgb565_to_rgb888((V4u32)__builtin_shuffle(p, zero, hi)));
+	}
+	return i;
+}
+
+
+static inline V4u32 rgb888_to_rgb565(V4u32 p)
+{
+	return ((p >> 8) & 0xf800) | ((p >> 5) & 0x7e0) | ((p >> 3) & 0x1f);
+}
+
+
+static inline int convert_rgb888_to_rgb565_chunks(void const *s, void *d, int num)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	V8u16 const even = { 0, 2, 4, 6, 8, 10, 12, 14 };
+
+	int i = 0;
+	for (; i + 8 <= num; i += 8, src += 32, dst += 16) {
+		V8u16 const p0 = (V8u16)rgb888_to_rgb565(load<V4u32>(src));
+		V8u16 const p1 = (V8u16)rgb888_to_rgb565(load<V4u32>(src + 16));
+		store(dst, __builtin_shuffle(p0, p1, even));
+	}
+	return i;
+}
+
+#endif /* _LIB__BLIT__SPEC__X86_64__BLEND_HELPER_H_ */
@@ -0,0 +1,48 @@
+/*
+ * \brief  Completion of the Internet checksum (RFC 1071)
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FOLD_CHECKSUM_H_
+#define _FOLD_CHECKSUM_H_
+
+/* Genode includes */
+#include <util/endian.h>
+#include <base/stdint.h>
+
+/**
+ * Fold wide sum of native-order words and 'seed' into the final checksum
+ *
+ * \param sum   sum of the checked data loaded in native byte order
+ * \param seed  sum of additional 16-bit words in host byte order
+ *
+ * \return  checksum in host byte order
+ */
+static inline Genode::uint16_t fold_checksum(Genode::uint64_t sum,
+                                             Genode::uint32_t seed)
+{
+	using namespace Genode;
+
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16); }
+
+	uint32_t result = host_to_big_endian((uint16_t)sum);
+	result += seed & 0xffff;
+	result += seed >> 16;
+	while (result >> 16) {
+		result = (result & 0xffff) + (result >> 16); }
+
+	return (uint16_t)~result;
+}
+
+#endif /* _FOLD_CHECKSUM_H_ */
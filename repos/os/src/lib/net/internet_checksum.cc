@@ -0,0 +1,58 @@
+/*
+ * \brief  Computation of the Internet checksum (RFC 1071)
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Generic implementation that sums up native 32-bit words in a 64-bit
+ * accumulator. Because the one's complement sum is independent of the byte
+ * order (RFC 1071, section 2 (B)), the byte order is corrected only once
+ * for the folded result.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <net/internet_checksum.h>
+
+/* local includes */
+#include <fold_checksum.h>
+
+using namespace Genode;
+
+
+static inline uint32_t load_32(uint8_t const *bytes)
+{
+	uint32_t word;
+	__builtin_memcpy(&word, bytes, sizeof(word));
+	return word;
+}
+
+
+Genode::uint16_t Net::internet_checksum(void const *data, size_t size,
+                                        uint32_t seed)
+{
+	uint8_t const *bytes = (uint8_t const *)data;
+	uint64_t       sum   = 0;
+
+	for (; size >= 16; bytes += 16, size -= 16) {
+		sum += load_32(bytes);
+		sum += load_32(bytes + 4);
+		sum += load_32(bytes + 8);
+		sum += load_32(bytes + 12);
+	}
+	for (; size >= 4; bytes += 4, size -= 4) {
+		sum += load_32(bytes); }
+
+	/* remaining bytes padded with zero */
+	uint8_t tail[4] = { 0, 0, 0, 0 };
+	for (size_t i = 0; i < size; i++) {
+		tail[i] = bytes[i]; }
+
+	sum += load_32(tail);
+	return fold_checksum(sum, seed);
+}
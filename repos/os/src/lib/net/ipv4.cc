@@ -17,6 +17,7 @@
 #include <net/udp.h>
 #include <net/tcp.h>
 #include <net/ipv4.h>
+#include <net/internet_checksum.h>
 
 using namespace Genode;
 using namespace Net;
@@ -84,17 +85,19 @@ Ipv4_address Ipv4_packet::ip_from_string(const char *ip)
 
 Genode::uint16_t Ipv4_packet::calculate_checksum(Ipv4_packet const &packet)
 {
-	Genode::uint16_t const *data = packet.header<Genode::uint16_t>();
-	Genode::uint32_t const sum = host_to_big_endian(data[0])
-	                           + host_to_big_endian(data[1])
-	                           + host_to_big_endian(data[2])
-	                           + host_to_big_endian(data[3])
-	                           + host_to_big_endian(data[4])
-	                           + host_to_big_endian(data[6])
-	                           + host_to_big_endian(data[7])
-	                           + host_to_big_endian(data[8])
-	                           + host_to_big_endian(data[9]);
-	return ~((0xFFFF & sum) + (sum >> 16));
+	enum { SIZE = 20, CHECKSUM_OFFSET = 10, CHECKSUM_END = 12 };
+
+	/* sum up the header except for the checksum field */
+	Genode::uint8_t  const *header = packet.header<Genode::uint8_t>();
+	Genode::uint16_t const  front  = internet_checksum(header, CHECKSUM_OFFSET);
+	return internet_checksum(header + CHECKSUM_END, SIZE - CHECKSUM_END,
+	                         (Genode::uint16_t)~front);
+}
+
+
+void Ipv4_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	checksum(icd.apply_to(checksum()));
 }
 
 
@@ -0,0 +1,59 @@
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/binary_event.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Event_header Event_header;
+
+enum { MAX_NAME_LEN = 48, MAX_EVENT_SIZE = sizeof(Event_header) + MAX_NAME_LEN };
+
+static size_t event(char *dst, Event_header::Type type, uint32_t value = 0)
+{
+	return Event_header::write(dst, type, Trace::timestamp(), value);
+}
+
+static size_t rpc_event(char *dst, Event_header::Type type, char const *rpc_name)
+{
+	size_t const header_len = event(dst, type);
+	size_t const name_len   = min(strlen(rpc_name), (size_t)MAX_NAME_LEN);
+
+	memcpy(dst + header_len, (void*)rpc_name, name_len);
+	return header_len + name_len;
+}
+
+size_t max_event_size()
+{
+	return MAX_EVENT_SIZE;
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return rpc_event(dst, Event_header::RPC_CALL, rpc_name);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return rpc_event(dst, Event_header::RPC_RETURNED, rpc_name);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return rpc_event(dst, Event_header::RPC_DISPATCH, rpc_name);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return rpc_event(dst, Event_header::RPC_REPLY, rpc_name);
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	return event(dst, Event_header::SIGNAL_SUBMIT, num);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	return event(dst, Event_header::SIGNAL_RECEIVED, num);
+}
@@ -0,0 +1,5 @@
+TARGET = timeline_policy
+
+TARGET_POLICY = timeline
+
+include $(PRG_DIR)/../policy.inc
@@ -21,6 +21,9 @@
 #include <base/id_space.h>
 #include <file_system_session/connection.h>
 
+/* local includes */
+#include "post_signal_hook.h"
+
 
 namespace Vfs { class Fs_file_system; }
 
@@ -112,36 +115,6 @@ class Vfs::Fs_file_system : public File_system
 			~Fs_handle_guard() { _fs_session.close(_fs_handle); }
 		};
 
-		struct Post_signal_hook : Genode::Entrypoint::Post_signal_hook
-		{
-			Genode::Entrypoint  &_ep;
-			Io_response_handler &_io_handler;
-			Vfs_handle::Context *_context = nullptr;
-
-			Post_signal_hook(Genode::Entrypoint &ep,
-			                 Io_response_handler &io_handler)
-			: _ep(ep), _io_handler(io_handler) { }
-
-			void arm(Vfs_handle::Context *context)
-			{
-				_context = context;
-				_ep.schedule_post_signal_hook(this);
-			}
-
-			void function() override
-			{
-				/*
-				 * XXX The current implementation executes the post signal hook
-				 *     for the last armed context only. When changing this,
-				 *     beware that the called handle_io_response() may change
-				 *     this object in a signal handler.
-				 */
-
-				_io_handler.handle_io_response(_context);
-				_context = nullptr;
-			}
-		};
-
 		Post_signal_hook _post_signal_hook { _env.ep(), _io_handler };
 
 		file_size _read(Fs_vfs_handle &handle, void *buf,
@@ -194,14 +167,24 @@ class Vfs::Fs_file_system : public File_system
 			return read_num_bytes;
 		}
 
-		file_size _write(Fs_vfs_handle &handle,
-		                 const char *buf, file_size count, file_size seek_offset)
+		/**
+		 * Write chunks as one packet
+		 *
+		 * The chunks are gathered into the packet until the maximum packet
+		 * size is reached. The caller is expected to retry with the
+		 * remainder.
+		 */
+		file_size _write(Fs_vfs_handle &handle, Write_chunk const *chunks,
+		                 unsigned num_chunks, file_size seek_offset)
 		{
 			::File_system::Session::Tx::Source &source = *_fs.tx();
 			using ::File_system::Packet_descriptor;
 
 			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			count = min(max_packet_size, count);
+
+			file_size count = 0;
+			for (unsigned i = 0; i < num_chunks && count < max_packet_size; i++)
+				count += min(max_packet_size - count, chunks[i].size);
 
 			/* XXX check if alloc_packet() and submit_packet() will succeed! */
 
@@ -211,7 +194,13 @@ class Vfs::Fs_file_system : public File_system
 			                            count,
 			                            seek_offset);
 
-			memcpy(source.packet_content(packet_in), buf, count);
+			char *dst = source.packet_content(packet_in);
+			for (file_size left = count; left; chunks++) {
+				file_size const n = min(left, chunks->size);
+				memcpy(dst, chunks->buf, n);
+				dst  += n;
+				left -= n;
+			}
 
 			/* wait until packet was acknowledged */
 			handle.queued_write_state = Handle_state::Queued_state::QUEUED;
@@ -292,7 +281,9 @@ class Vfs::Fs_file_system : public File_system
 			_fs(env, _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    ::File_system::DEFAULT_TX_BUF_SIZE)
+			    ::File_system::DEFAULT_TX_BUF_SIZE,
+			    config.attribute_value("tx_queue_size",
+			                           (unsigned)::File_system::Session::TX_QUEUE_SIZE))
 		{
 			_fs.sigh_ack_avail(_ack_handler);
 		}
@@ -561,7 +552,8 @@ class Vfs::Fs_file_system : public File_system
 				    _fs.symlink(dir_handle, symlink_name.base() + 1, true);
 				Fs_handle_guard symlink_guard(*this, _fs, symlink_handle, _handle_space);
 
-				_write(symlink_guard, from, strlen(from) + 1, 0);
+				Write_chunk const chunk { from, strlen(from) + 1 };
+				_write(symlink_guard, &chunk, 1, 0);
 			}
 			catch (::File_system::Invalid_handle)      { return SYMLINK_ERR_NO_ENTRY; }
 			catch (::File_system::Node_already_exists) { return SYMLINK_ERR_EXISTS;   }
@@ -700,7 +692,20 @@ class Vfs::Fs_file_system : public File_system
 
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
-			out_count = _write(handle, buf, buf_size, handle.seek());
+			Write_chunk const chunk { buf, buf_size };
+			out_count = _write(handle, &chunk, 1, handle.seek());
+
+			return WRITE_OK;
+		}
+
+		Write_result writev(Vfs_handle *vfs_handle, Write_chunk const *chunks,
+		                    unsigned num_chunks, file_size &out_count) override
+		{
+			Lock::Guard guard(_lock);
+
+			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
+
+			out_count = _write(handle, chunks, num_chunks, handle.seek());
 
 			return WRITE_OK;
 		}
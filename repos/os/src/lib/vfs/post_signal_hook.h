@@ -0,0 +1,89 @@
+/*
+ * \brief  Deferred delivery of I/O responses to the VFS user
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__VFS__POST_SIGNAL_HOOK_H_
+#define _INCLUDE__VFS__POST_SIGNAL_HOOK_H_
+
+/* Genode includes */
+#include <base/entrypoint.h>
+#include <vfs/file_io_service.h>
+
+namespace Vfs { struct Post_signal_hook; }
+
+
+/**
+ * Hook that calls the I/O-response handler after the current signal
+ *
+ * All contexts armed during the handling of one signal are reported
+ * individually, so the VFS user can restrict its reaction to the affected
+ * handles. If more contexts are armed than can be recorded, the handler is
+ * additionally called with a nullptr context, which denotes an unspecific
+ * response.
+ */
+struct Vfs::Post_signal_hook : Genode::Entrypoint::Post_signal_hook
+{
+	enum { MAX_CONTEXTS = 16 };
+
+	Genode::Entrypoint  &_ep;
+	Io_response_handler &_io_handler;
+
+	Vfs_handle::Context *_contexts[MAX_CONTEXTS];
+	unsigned             _num_contexts = 0;
+	bool                 _overflow     = false;
+
+	Post_signal_hook(Genode::Entrypoint &ep,
+	                 Io_response_handler &io_handler)
+	: _ep(ep), _io_handler(io_handler) { }
+
+	void arm(Vfs_handle::Context *context)
+	{
+		bool armed = false;
+		for (unsigned i = 0; i < _num_contexts; i++)
+			armed |= (_contexts[i] == context);
+
+		if (!armed) {
+			if (_num_contexts < MAX_CONTEXTS)
+				_contexts[_num_contexts++] = context;
+			else
+				_overflow = true;
+		}
+
+		_ep.schedule_post_signal_hook(this);
+	}
+
+	void function() override
+	{
+		/*
+		 * Operate on a copy of the armed contexts because the called
+		 * handle_io_response() may change this object in a signal handler.
+		 */
+		Vfs_handle::Context *contexts[MAX_CONTEXTS];
+
+		unsigned const num_contexts = _num_contexts;
+		bool     const overflow     = _overflow;
+
+		for (unsigned i = 0; i < num_contexts; i++)
+			contexts[i] = _contexts[i];
+
+		_num_contexts = 0;
+		_overflow     = false;
+
+		for (unsigned i = 0; i < num_contexts; i++)
+			_io_handler.handle_io_response(contexts[i]);
+
+		if (overflow)
+			_io_handler.handle_io_response(nullptr);
+	}
+};
+
+#endif /* _INCLUDE__VFS__POST_SIGNAL_HOOK_H_ */
@@ -21,6 +21,8 @@
 #include <base/signal.h>
 #include <base/registry.h>
 
+#include "post_signal_hook.h"
+
 
 namespace Vfs { class Terminal_file_system; }
 
@@ -40,36 +42,6 @@ class Vfs::Terminal_file_system : public Single_file_system
 		typedef Genode::Registered<Vfs_handle>      Registered_handle;
 		typedef Genode::Registry<Registered_handle> Handle_registry;
 
-		struct Post_signal_hook : Genode::Entrypoint::Post_signal_hook
-		{
-			Genode::Entrypoint  &_ep;
-			Io_response_handler &_io_handler;
-			Vfs_handle::Context *_context = nullptr;
-
-			Post_signal_hook(Genode::Entrypoint &ep,
-			                 Io_response_handler &io_handler)
-			: _ep(ep), _io_handler(io_handler) { }
-
-			void arm(Vfs_handle::Context *context)
-			{
-				_context = context;
-				_ep.schedule_post_signal_hook(this);
-			}
-
-			void function() override
-			{
-				/*
-				 * XXX The current implementation executes the post signal hook
-				 *     for the last armed context only. When changing this,
-				 *     beware that the called handle_io_response() may change
-				 *     this object in a signal handler.
-				 */
-
-				_io_handler.handle_io_response(_context);
-				_context = nullptr;
-			}
-		};
-
 		Post_signal_hook _post_signal_hook { _env.ep(), _io_handler };
 
 		Handle_registry _handle_registry;
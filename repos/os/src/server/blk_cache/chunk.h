@@ -21,6 +21,7 @@
 #include <util/noncopyable.h>
 #include <base/allocator.h>
 #include <base/exception.h>
+#include <util/fifo.h>
 #include <util/list.h>
 #include <util/string.h>
 
@@ -100,10 +101,15 @@ namespace Cache {
 
 	/**
 	 * Chunk of bytes used as leaf in hierarchy of chunk indices
+	 *
+	 * A chunk becomes dirty when written after it was filled. The policy
+	 * gets notified about a chunk becoming dirty and becoming clean again
+	 * by synchronizing it with the backend device.
 	 */
 	template <unsigned CHUNK_SIZE, typename POLICY>
 	class Chunk : public Chunk_base,
-	              public POLICY::Element
+	              public POLICY::Element,
+	              public Genode::Fifo<Chunk<CHUNK_SIZE, POLICY> >::Element
 	{
 		private:
 
@@ -142,6 +148,11 @@ namespace Cache {
 			 */
 			size_t used_size() const { return _num_entries; }
 
+			/**
+			 * Return true if the chunk must be synchronized before freeing
+			 */
+			bool dirty() const { return _writes > 1; }
+
 			void write(char const *src, size_t len, offset_t seek_offset)
 			{
 				assert_valid_range(seek_offset, len, SIZE);
@@ -155,6 +166,9 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
+				if (_writes == 1)
+					POLICY::dirty(this);
+
 				_writes++;
 			}
 
@@ -180,6 +194,7 @@ namespace Cache {
 				if (_writes > 1) {
 					POLICY::sync(this, (char*)_data);
 					_writes = 1;
+					POLICY::clean(this);
 				}
 			}
 
@@ -17,6 +17,7 @@
 #include <os/packet_allocator.h>
 
 #include "chunk.h"
+#include "stream.h"
 
 /**
  * Cache driver used by the generic block driver framework
@@ -29,48 +30,47 @@ class Driver : public Block::Driver
 	private:
 
 		/**
-		 * This class encapsulates requests to the backend device in progress,
-		 * and the packets from the client side that triggered the request.
+		 * Packet from the client side that waits for a request to the
+		 * backend device
 		 */
-		struct Request : public Genode::List<Request>::Element
+		struct Client_request : public Genode::List<Client_request>::Element
 		{
-			Block::Packet_descriptor srv;
 			Block::Packet_descriptor cli;
 			char * const             buffer;
 
-			Request(Block::Packet_descriptor &s,
-			        Block::Packet_descriptor &c,
-			        char * const              b)
-				: srv(s), cli(c), buffer(b) {}
+			Client_request(Block::Packet_descriptor &c, char * const b)
+			: cli(c), buffer(b) { }
+		};
 
-			/*
-			 * \return true when the given response packet matches
-			 *         the request send to the backend device
-			 */
-			bool match(const Block::Packet_descriptor& reply) const
-			{
-				return reply.operation()    == srv.operation()  &&
-				       reply.block_number() == srv.block_number() &&
-				       reply.block_count()  == srv.block_count();
-			}
+		/**
+		 * Request to the backend device in progress
+		 *
+		 * The requests are indexed by their block numbers. They never
+		 * overlap because only chunks that are neither cached nor already
+		 * requested are requested from the device. A request issued for
+		 * reading ahead has no clients initially.
+		 */
+		struct Device_request : public Genode::Avl_node<Device_request>
+		{
+			Block::Packet_descriptor     const srv;
+			Genode::List<Client_request>       clients;
+
+			Device_request(Block::Packet_descriptor &s) : srv(s) { }
+
+			bool higher(Device_request *r) {
+				return r->srv.block_number() > srv.block_number(); }
 
 			/*
-			 * \param write  whether it's a write or read request
-			 * \param nr     block number requested
-			 * \param cnt    number of blocks requested
-			 * \return true when the given parameters match
-			 *         the request send to the backend device
+			 * \return request in this subtree that contains block 'nr'
 			 */
-			bool match(const bool write,
-			           const Block::sector_t nr,
-			           const Genode::size_t  cnt) const
+			Device_request *find(Block::sector_t nr)
 			{
-				Block::Packet_descriptor::Opcode op = write
-					? Block::Packet_descriptor::WRITE
-					: Block::Packet_descriptor::READ;
-				return op == srv.operation()    &&
-				       nr >= srv.block_number() &&
-				       nr+cnt <= srv.block_number()+srv.block_count();
+				if (nr >= srv.block_number() &&
+				    nr <  srv.block_number() + srv.block_count())
+					return this;
+
+				Device_request *r = child(nr > srv.block_number());
+				return r ? r->find(nr) : nullptr;
 			}
 		};
 
@@ -89,19 +89,29 @@ class Driver : public Block::Driver
 
 
 		/*
-		 * The given policy class is extended by a synchronization routine,
-		 * used by the cache chunk structure
+		 * The given policy class is extended by a synchronization routine
+		 * and the tracking of dirty chunks, used by the cache chunk structure
 		 */
 		struct Policy : POLICY {
-			static void sync(const typename POLICY::Element *e, char *src); };
+			static void sync(const typename POLICY::Element *e, char *src);
+			static void dirty(const typename POLICY::Element *e);
+			static void clean(const typename POLICY::Element *e); };
 
 	public:
 
 		enum {
-			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
+			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Device_request),
 			CACHE_BLK_SIZE = 4096
 		};
 
+		/*
+		 * Sequential streams read ahead up to MAX_WINDOW chunks, split into
+		 * device requests of at most MAX_READ_AHEAD chunks each
+		 */
+		enum { NUM_STREAMS = 4, MAX_WINDOW = 32, MAX_READ_AHEAD = 8 };
+
+		typedef Cache::Stream_detector<NUM_STREAMS, MAX_WINDOW> Streams;
+
 		/**
 		 * We use five levels of page-table like chunk structure,
 		 * thereby we've a maximum device size of 256^4*4096 (LBA48)
@@ -114,15 +124,25 @@ class Driver : public Block::Driver
 
 	private:
 
+		typedef Genode::Tslab<Device_request, SLAB_SZ> Device_request_slab;
+		typedef Genode::Tslab<Client_request, SLAB_SZ> Client_request_slab;
+
 		Genode::Env                      &_env;
-		Genode::Tslab<Request, SLAB_SZ>   _r_slab;    /* slab for requests  */
-		Genode::List<Request>             _r_list;    /* list of requests   */
+		Device_request_slab               _r_slab;    /* device requests    */
+		Client_request_slab               _c_slab;    /* client requests    */
+		Genode::Avl_tree<Device_request>  _r_tree;    /* pending requests   */
+		Streams                           _streams;   /* sequential streams */
 		Genode::Packet_allocator          _alloc;     /* packet allocator   */
 		Block::Connection                 _blk;       /* backend device     */
 		Block::Session::Operations        _ops;       /* allowed operations */
 		Genode::size_t                    _blk_sz;    /* block size         */
 		Block::sector_t                   _blk_cnt;   /* block count        */
 		Chunk_level_0                     _cache;     /* chunk hierarchy    */
+		Genode::Fifo<Chunk_level_4>       _dirty;     /* dirty chunks       */
+		Genode::size_t                    _num_dirty = 0;
+		Genode::size_t              const _dirty_low;  /* in chunks */
+		Genode::size_t              const _dirty_high; /* in chunks */
+		bool                              _writing_back = false;
 		Genode::Signal_handler<Driver>    _source_ack;
 		Genode::Signal_handler<Driver>    _source_submit;
 		Genode::Signal_handler<Driver>    _yield;
@@ -149,26 +169,53 @@ class Driver : public Block::Driver
 			       ? nr + _cache_blk_mod() - (nr % _cache_blk_mod())
 			       : nr; }
 
+		/*
+		 * Return number of the cache chunk containing the given block
+		 */
+		inline Block::sector_t _chunk(Block::sector_t nr) {
+			return nr / _cache_blk_mod(); }
+
+		/*
+		 * Return pending device request containing the given block
+		 */
+		Device_request *_pending(Block::sector_t nr)
+		{
+			Device_request *r = _r_tree.first();
+			return r ? r->find(nr) : nullptr;
+		}
+
+		/*
+		 * Return true if the given chunk is neither cached nor requested
+		 */
+		bool _missing(Block::sector_t chunk)
+		{
+			if (_pending(chunk * _cache_blk_mod()))
+				return false;
+
+			try {
+				_cache.stat(CACHE_BLK_SIZE, chunk * CACHE_BLK_SIZE);
+				return false;
+			} catch(Cache::Chunk_base::Range_incomplete) { }
+			return true;
+		}
+
 		/*
 		 * Handle response to a single request
 		 *
-		 * \param srv  packet received from the backend device
-		 * \param r    outstanding request
+		 * \param r  client request waiting for the response
 		 */
-		inline void _handle_reply(Block::Packet_descriptor &srv, Request *r)
+		inline void _handle_reply(Client_request &r)
 		{
 			try {
-			if (r->cli.operation() == Block::Packet_descriptor::READ)
-				read(r->cli.block_number(), r->cli.block_count(),
-				     r->buffer, r->cli);
+			if (r.cli.operation() == Block::Packet_descriptor::READ)
+				_read(r.cli.block_number(), r.cli.block_count(),
+				      r.buffer, r.cli);
 			else
-				write(r->cli.block_number(), r->cli.block_count(),
-				      r->buffer, r->cli);
+				_write(r.cli.block_number(), r.cli.block_count(),
+				       r.buffer, r.cli);
 			} catch(Block::Driver::Request_congestion) {
-				Genode::warning("cli (", r->cli.block_number(), " ",
-				                         r->cli.block_count(), ") "
-				                "srv (", r->srv.block_number(), " ",
-				                         r->srv.block_count(), ")");
+				Genode::warning("cli (", r.cli.block_number(), " ",
+				                         r.cli.block_count(), ")");
 			}
 		}
 
@@ -180,108 +227,226 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
-				/* when reading, write result into cache */
-				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _blk_sz,
-					             p.block_number() * _blk_sz);
-
-				/* loop through the list of requests, and ack all related */
-				for (Request *r = _r_list.first(), *r_to_handle = r; r;
-				     r_to_handle = r) {
-					r = r->next();
-					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
-						_r_list.remove(r_to_handle);
-						Genode::destroy(&_r_slab, r_to_handle);
-					}
+				/* acknowledgements of written chunks need no further care */
+				if (p.operation() != Block::Packet_descriptor::READ) {
+					_blk.tx()->release_packet(p);
+					continue;
 				}
 
+				/* write result into cache */
+				_cache.write(_blk.tx()->packet_content(p),
+				             p.block_count() * _blk_sz,
+				             p.block_number() * _blk_sz);
+
 				_blk.tx()->release_packet(p);
+
+				Device_request *r = _pending(p.block_number());
+				if (!r)
+					continue;
+
+				/* the clients may issue new requests, so detach 'r' first */
+				_r_tree.remove(r);
+
+				while (Client_request *c = r->clients.first()) {
+					r->clients.remove(c);
+					_handle_reply(*c);
+					Genode::destroy(&_c_slab, c);
+				}
+				Genode::destroy(&_r_slab, r);
 			}
+
+			_write_back_in_background();
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit() { _write_back_in_background(); }
 
 		/*
-		 * Setup a request to the backend device
+		 * Write back the oldest dirty chunks until at most 'limit' remain
 		 *
-		 * \param block_number block number offset
-		 * \param block_count  number of blocks
-		 * \param packet       original packet request received from the client
+		 * \return  false if the backend device is congested
 		 */
-		void _request(Block::sector_t           block_number,
-		              Genode::size_t            block_count,
-		              char * const              buffer,
-		              Block::Packet_descriptor &packet)
+		bool _write_back(Genode::size_t limit)
 		{
-			Block::Packet_descriptor p_to_dev;
+			while (_num_dirty > limit) {
+				Chunk_level_4 &chunk = *_dirty.head();
+				try {
+					chunk.sync(CACHE_BLK_SIZE, chunk.base_offset());
+				} catch(Write_failed) { return false; }
 
+				POLICY::stats().writebacks++;
+			}
+			return true;
+		}
+
+		/*
+		 * Write back dirty chunks driven by watermarks
+		 *
+		 * Once the number of dirty chunks exceeds the high watermark, they
+		 * are written back until the low watermark is reached. If the
+		 * device is congested, the write back continues as soon as the
+		 * device becomes ready.
+		 */
+		void _write_back_in_background()
+		{
+			if (_num_dirty > _dirty_high)
+				_writing_back = true;
+
+			if (_writing_back && _write_back(_dirty_low))
+				_writing_back = false;
+		}
+
+		/*
+		 * Allocate chunks, write back dirty chunks if they prevent eviction
+		 */
+		void _cache_alloc(Cache::size_t size, Cache::offset_t off)
+		{
 			try {
-				/* we've to look whether the request is already pending */
-				for (Request *r = _r_list.first(); r; r = r->next()) {
-					if (r->match(false, block_number, block_count)) {
-						_r_list.insert(new (&_r_slab) Request(r->srv, packet,
-						                                      buffer));
-						return;
-					}
-				}
+				_cache.alloc(size, off);
+			} catch(Request_congestion) {
+				_write_back(0);
+				_cache.alloc(size, off);
+			}
+		}
 
-				/* it doesn't pay, we've to send a request to the device */
-				if (!_blk.tx()->ready_to_submit()) {
-					Genode::warning("not ready_to_submit");
-					throw Request_congestion();
-				}
+		/*
+		 * Send a read request for a range of chunks to the backend device
+		 *
+		 * \param first  first chunk
+		 * \param end    chunk following the last chunk
+		 *
+		 * \return  new request, or nullptr if the device is congested
+		 */
+		Device_request *_submit_read(Block::sector_t first, Block::sector_t end)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				return nullptr;
 
-				/* read ahead CACHE_BLK_SIZE */
-				Block::sector_t nr = _cache_blk_round_off(block_number);
-				Genode::size_t cnt = _cache_blk_round_up(block_count +
-				                                         (block_number - nr));
+			Block::sector_t const nr  = first * _cache_blk_mod();
+			Genode::size_t  const cnt =
+				Genode::min(end * _cache_blk_mod(), _blk_cnt) - nr;
 
+			Block::Packet_descriptor p_to_dev;
+
+			try {
 				/* ensure all memory is available before sending the request */
-				_cache.alloc(cnt * _blk_sz, nr * _blk_sz);
+				_cache_alloc(cnt * _blk_sz, nr * _blk_sz);
 
-				/* construct and send the packet */
 				p_to_dev =
 					Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz*cnt),
 					                         Block::Packet_descriptor::READ,
 					                         nr, cnt);
-				_r_list.insert(new (&_r_slab) Request(p_to_dev, packet, buffer));
+
+				Device_request *r = new (&_r_slab) Device_request(p_to_dev);
+				_r_tree.insert(r);
 				_blk.tx()->submit_packet(p_to_dev);
+				return r;
+
 			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-				throw Request_congestion();
+			} catch(Request_congestion) {
+				/* cache could not be shrunk */
 			} catch(Genode::Allocator::Out_of_memory) {
 				/* clean up */
 				_blk.tx()->release_packet(p_to_dev);
+			}
+			return nullptr;
+		}
+
+		/*
+		 * Setup a request to the backend device
+		 *
+		 * \param block_number block number offset
+		 * \param block_count  number of blocks
+		 * \param packet       original packet request received from the client
+		 */
+		void _request(Block::sector_t           block_number,
+		              Genode::size_t            block_count,
+		              char * const              buffer,
+		              Block::Packet_descriptor &packet)
+		{
+			Client_request *c = nullptr;
+			try { c = new (&_c_slab) Client_request(packet, buffer); }
+			catch(Genode::Allocator::Out_of_memory) {
+				throw Request_congestion(); }
+
+			/*
+			 * If the first block is already requested, the client gets
+			 * reconsidered when the request completes
+			 */
+			Device_request *r = _pending(block_number);
+
+			if (!r) {
+				Block::sector_t const first = _chunk(block_number);
+				Block::sector_t const end   =
+					_chunk(_cache_blk_round_up(block_number + block_count));
+
+				/* stop at the first chunk that is already requested */
+				Block::sector_t last = first + 1;
+				while (last < end && !_pending(last * _cache_blk_mod()))
+					last++;
+
+				r = _submit_read(first, last);
+			}
+
+			if (!r) {
+				Genode::destroy(&_c_slab, c);
 				throw Request_congestion();
 			}
+
+			r->clients.insert(c);
 		}
 
 		/*
-		 * Synchronize dirty chunks with backend device
+		 * Read ahead of a sequential stream
+		 *
+		 * The chunks within the read-ahead window of the stream that are
+		 * neither cached nor requested are requested from the device. If
+		 * the device is congested, the read ahead is continued with the
+		 * next access of the stream.
 		 */
-		void _sync()
+		void _read_ahead(typename Streams::Stream &s)
 		{
-			Cache::offset_t off = 0;
-			Cache::size_t len   = _blk_sz * _blk_cnt;
+			if (!s.window)
+				return;
 
-			while (len > 0) {
-				try {
-					_cache.sync(len, off);
-					len = 0;
-				} catch(Write_failed &e) {
-					/**
-					 * Write to backend failed when backend device isn't ready
-					 * to proceed, so handle signals, until it's ready again
-					 */
-					off = e.off;
-					len = _blk_sz * _blk_cnt - off;
-					_env.ep().wait_and_dispatch_one_signal();
+			Block::sector_t const target =
+				Genode::min((Block::sector_t)(s.next + s.window),
+				            _chunk(_cache_blk_round_up(_blk_cnt)));
+
+			Block::sector_t chunk = Genode::max(s.ahead, s.next);
+			while (chunk < target) {
+
+				if (!_missing(chunk)) {
+					chunk++;
+					continue;
 				}
+
+				Block::sector_t end = chunk + 1;
+				while (end < target && end - chunk < MAX_READ_AHEAD &&
+				       _missing(end))
+					end++;
+
+				if (!_submit_read(chunk, end))
+					break;
+
+				chunk = end;
 			}
+			s.ahead = chunk;
+		}
+
+		/*
+		 * Synchronize dirty chunks with backend device
+		 */
+		void _sync()
+		{
+			/**
+			 * Write to backend fails when backend device isn't ready
+			 * to proceed, so handle signals, until it's ready again
+			 */
+			while (!_write_back(0))
+				_env.ep().wait_and_dispatch_one_signal();
 		}
 
 		/*
@@ -321,26 +486,72 @@ class Driver : public Block::Driver
 				Arg_string::find_arg(args.string(), "ram_quota").ulong_value(0);
 
 			/* flush the requested amount of RAM from cache */
-			POLICY::flush(requested_ram_quota);
+			_write_back(0);
+			try { POLICY::flush(requested_ram_quota); }
+			catch(Request_congestion) { }
 			_env.parent().yield_response();
 		}
 
+		/*
+		 * \return  true if the request was served from the cache
+		 */
+		bool _read(Block::sector_t           block_number,
+		           Genode::size_t            block_count,
+		           char*                     buffer,
+		           Block::Packet_descriptor &packet)
+		{
+			if (!_stat(block_number, block_count, buffer, packet))
+				return false;
+
+			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
+			ack_packet(packet);
+			return true;
+		}
+
+		void _write(Block::sector_t           block_number,
+		            Genode::size_t            block_count,
+		            const char *              buffer,
+		            Block::Packet_descriptor &packet)
+		{
+			_cache_alloc(block_count * _blk_sz, block_number * _blk_sz);
+
+			if ((block_number % _cache_blk_mod()) &&
+			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet))
+				return;
+
+			if (((block_number+block_count) % _cache_blk_mod())
+				&& !_stat(block_number+block_count-1, 1,
+				          const_cast<char* const>(buffer), packet))
+				return;
+
+			_cache.write(buffer, block_count * _blk_sz,
+			             block_number * _blk_sz);
+			ack_packet(packet);
+		}
+
 	public:
 
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param dirty_low   number of bytes of dirty chunks, down to which
+		 *                    the background write back proceeds
+		 * \param dirty_high  number of bytes of dirty chunks that triggers
+		 *                    the background write back
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap,
+		       Genode::size_t dirty_low, Genode::size_t dirty_high)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
+		  _c_slab(&heap),
 		  _alloc(&heap, CACHE_BLK_SIZE),
 		  _blk(_env, &_alloc, Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE),
 		  _blk_sz(0),
 		  _blk_cnt(0),
 		  _cache(heap, 0),
+		  _dirty_low(dirty_low / CACHE_BLK_SIZE),
+		  _dirty_high(Genode::max(dirty_high, dirty_low) / CACHE_BLK_SIZE),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
 		  _yield(env.ep(), *this, &Driver::_parent_yield)
@@ -372,6 +583,20 @@ class Driver : public Block::Driver
 		Block::Session_client* blk()    { return &_blk;   }
 		Genode::size_t         blk_sz() { return _blk_sz; }
 
+		Genode::size_t dirty_chunks() const { return _num_dirty; }
+
+		void dirty(Chunk_level_4 &chunk)
+		{
+			_dirty.enqueue(&chunk);
+			_num_dirty++;
+		}
+
+		void clean(Chunk_level_4 &chunk)
+		{
+			_dirty.remove(&chunk);
+			_num_dirty--;
+		}
+
 
 		/****************************
 		 ** Block-driver interface **
@@ -389,11 +614,15 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if (!_stat(block_number, block_count, buffer, packet))
-				return;
+			if (_read(block_number, block_count, buffer, packet))
+				POLICY::stats().hits++;
+			else
+				POLICY::stats().misses++;
 
-			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
-			ack_packet(packet);
+			Block::sector_t const end =
+				_cache_blk_round_up(block_number + block_count);
+
+			_read_ahead(_streams.access(_chunk(block_number), _chunk(end)));
 		}
 
 		void write(Block::sector_t           block_number,
@@ -404,20 +633,9 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::WRITE))
 				throw Io_error();
 
-			_cache.alloc(block_count * _blk_sz, block_number * _blk_sz);
+			_write(block_number, block_count, buffer, packet);
 
-			if ((block_number % _cache_blk_mod()) &&
-			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet))
-				return;
-
-			if (((block_number+block_count) % _cache_blk_mod())
-				&& !_stat(block_number+block_count-1, 1,
-				          const_cast<char* const>(buffer), packet))
-				return;
-
-			_cache.write(buffer, block_count * _blk_sz,
-			             block_number * _blk_sz);
-			ack_packet(packet);
+			_write_back_in_background();
 		}
 
 		void sync() { _sync(); }
@@ -18,13 +18,17 @@ typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
 static const Lru_policy::Element        *lru = 0;
 static Genode::List<Lru_policy::Element> lru_list;
+static Cache::Policy_stats               lru_stats;
 
 
 static void lru_access(const Lru_policy::Element *e)
 {
 	if (e == lru) return;
 
-	if (e->next()) lru_list.remove(e);
+	if (e->next())
+		lru_list.remove(e);
+	else
+		lru_stats.resident++;
 
 	lru_list.insert(e, lru);
 	lru = e;
@@ -39,24 +43,34 @@ void Lru_policy::write(const Lru_policy::Element *e) {
 	lru_access(e); }
 
 
+Cache::Policy_stats &Lru_policy::stats() { return lru_stats; }
+
+
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
-		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
+
+	/* dirty chunks are left to the write back of the driver */
+	for (Lru_policy::Element *e = lru_list.first(), *next = 0;
+		 e && ((size == 0) || (s < size)); e = next) {
+		next = e->next();
+
 		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
-		}
-	}
+		if (cb->dirty())
+			continue;
 
-	if (!lru_list.first()) lru = 0;
+		lru_list.remove(cb);
+
+		/* the most recently used element is the last one of the list */
+		if (cb == lru)
+			for (lru = lru_list.first(); lru && lru->next(); lru = lru->next());
+
+		cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+
+		lru_stats.evictions++;
+		lru_stats.resident--;
+		s += sizeof(Chunk);
+	}
 
 	if (s < size) throw Block::Driver::Request_congestion();
 }
@@ -14,12 +14,19 @@
 #include <util/list.h>
 
 #include "chunk.h"
+#include "policy_stats.h"
 
 struct Lru_policy
 {
 	class Element : public Genode::List<Element>::Element {};
 
+	static char const *name() { return "lru"; }
+
 	static void read(const Element  *e);
 	static void write(const Element *e);
 	static void flush(Cache::size_t size = 0);
+
+	static Cache::Policy_stats &stats();
+
+	static void report(Genode::Xml_generator &xml) { stats().report(xml); }
 };
@@ -12,20 +12,33 @@
  */
 
 #include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
 
 #include "lru.h"
+#include "two_q.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
-static Driver<Policy> * driver = nullptr;
+
+/**
+ * Driver of the current session, used by the chunks to reach the device
+ */
+template <typename POLICY>
+struct Active_driver { static Driver<POLICY> *driver; };
+
+template <typename POLICY>
+Driver<POLICY> *Active_driver<POLICY>::driver = nullptr;
 
 
 /**
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *src)
 {
+	Driver<POLICY> *driver = Active_driver<POLICY>::driver;
+
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
 
@@ -38,6 +51,8 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 			p(driver->blk()->dma_alloc_packet(Driver::CACHE_BLK_SIZE),
 		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
 		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
+		Genode::memcpy(driver->blk()->tx()->packet_content(p), src,
+		               Driver::CACHE_BLK_SIZE);
 		driver->blk()->tx()->submit_packet(p);
 	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 		throw Write_failed(off);
@@ -45,6 +60,30 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 }
 
 
+/**
+ * Track chunk that became dirty
+ */
+template <typename POLICY>
+void Driver<POLICY>::Policy::dirty(const typename POLICY::Element *e)
+{
+	if (Driver<POLICY> *driver = Active_driver<POLICY>::driver)
+		driver->dirty(*const_cast<Driver<POLICY>::Chunk_level_4*>(
+			static_cast<const Driver<POLICY>::Chunk_level_4*>(e)));
+}
+
+
+/**
+ * Track chunk that became clean
+ */
+template <typename POLICY>
+void Driver<POLICY>::Policy::clean(const typename POLICY::Element *e)
+{
+	if (Driver<POLICY> *driver = Active_driver<POLICY>::driver)
+		driver->clean(*const_cast<Driver<POLICY>::Chunk_level_4*>(
+			static_cast<const Driver<POLICY>::Chunk_level_4*>(e)));
+}
+
+
 struct Main
 {
 	template <typename T>
@@ -52,32 +91,102 @@ struct Main
 	{
 		Genode::Env  &env;
 		Genode::Heap &heap;
+		Main         &main;
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		Factory(Genode::Env &env, Genode::Heap &heap, Main &main)
+		: env(env), heap(heap), main(main) {}
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
-			return driver;
+			Active_driver<T>::driver = new (&heap)
+				::Driver<T>(env, heap, main.dirty_low, main.dirty_high);
+			return Active_driver<T>::driver;
 		}
 
-		void destroy(Block::Driver *driver) {
-			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver)); }
+		void destroy(Block::Driver *driver)
+		{
+			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver));
+			Active_driver<T>::driver = nullptr;
+		}
+
+		void report(Genode::Xml_generator &xml)
+		{
+			xml.attribute("policy", T::name());
+			T::report(xml);
+
+			if (::Driver<T> *driver = Active_driver<T>::driver)
+				xml.attribute("dirty", driver->dirty_chunks());
+		}
 	};
 
 	void resource_handler() { }
 
-	Genode::Env                 &env;
-	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory };
+	Genode::Env                   &env;
+	Genode::Heap                   heap   { env.ram(), env.rm() };
+	Genode::Attached_rom_dataspace config { env, "config" };
+
+	/**
+	 * Read the optional busy-poll window for the client session
+	 */
+	unsigned poll_iterations() {
+		return config.xml().attribute_value("poll_iterations", 0U); }
+
+	typedef Genode::String<8> Policy_name;
+
+	bool const two_q = config.xml().attribute_value("policy",
+	                                                Policy_name("lru")) == "2q";
+
+	/*
+	 * Watermarks of the amount of dirty data for the background write back
+	 */
+	Genode::size_t const dirty_low =
+		config.xml().attribute_value("dirty_low", Genode::Number_of_bytes(256*1024));
+	Genode::size_t const dirty_high =
+		config.xml().attribute_value("dirty_high", Genode::Number_of_bytes(1024*1024));
+
+	Factory<Lru_policy>          lru_factory   { env, heap, *this };
+	Factory<Two_q_policy>        two_q_factory { env, heap, *this };
+	Block::Root                  root          { env.ep(), heap, env.rm(),
+	                                             two_q ? (Block::Driver_factory &)two_q_factory
+	                                                   : (Block::Driver_factory &)lru_factory,
+	                                             poll_iterations() };
 	Genode::Signal_handler<Main> resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
+	/*
+	 * Optional periodic report of the cache statistics
+	 */
+	Genode::Constructible<Timer::Connection> timer;
+	Genode::Constructible<Genode::Reporter>  reporter;
+
+	void handle_report()
+	{
+		Genode::Reporter::Xml_generator xml(*reporter, [&] () {
+			if (two_q) two_q_factory.report(xml);
+			else       lru_factory.report(xml);
+		});
+	}
+
+	Genode::Signal_handler<Main> report_dispatcher {
+		env.ep(), *this, &Main::handle_report };
+
 	Main(Genode::Env &env) : env(env)
 	{
 		env.parent().announce(env.ep().manage(root));
 		env.parent().resource_avail_sigh(resource_dispatcher);
+
+		try {
+			Genode::Xml_node const node = config.xml().sub_node("report");
+			unsigned long const period_ms =
+				node.attribute_value("period_ms", 1000UL);
+
+			reporter.construct(env, "stats");
+			reporter->enabled(true);
+
+			timer.construct(env);
+			timer->sigh(report_dispatcher);
+			timer->trigger_periodic(1000*period_ms);
+		} catch (Genode::Xml_node::Nonexistent_sub_node) { }
 	}
 };
 
@@ -0,0 +1,41 @@
+/*
+ * \brief  Statistics of a cache replacement policy
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _POLICY_STATS_H_
+#define _POLICY_STATS_H_
+
+/* Genode includes */
+#include <util/xml_generator.h>
+
+namespace Cache { struct Policy_stats; }
+
+
+struct Cache::Policy_stats
+{
+	unsigned long hits       = 0;  /* reads served from the cache */
+	unsigned long misses     = 0;  /* reads that needed the device */
+	unsigned long evictions  = 0;  /* chunks freed */
+	unsigned long writebacks = 0;  /* dirty chunks written to the device */
+	unsigned long resident   = 0;  /* chunks known to the policy */
+
+	void report(Genode::Xml_generator &xml) const
+	{
+		xml.attribute("hits",       hits);
+		xml.attribute("misses",     misses);
+		xml.attribute("evictions",  evictions);
+		xml.attribute("writebacks", writebacks);
+		xml.attribute("resident",   resident);
+	}
+};
+
+#endif /* _POLICY_STATS_H_ */
@@ -0,0 +1,98 @@
+/*
+ * \brief  Detection of sequential access streams
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _STREAM_H_
+#define _STREAM_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+
+#include "chunk.h"
+
+namespace Cache {
+
+	template <unsigned NUM_STREAMS, unsigned MAX_WINDOW>
+	class Stream_detector;
+}
+
+
+/**
+ * Tracker of the sequential streams of one client
+ *
+ * Accesses are accounted in units of cache chunks. An access that continues
+ * a stream grows the read-ahead window of the stream by a factor of two up to
+ * 'MAX_WINDOW' chunks. Any other access starts a new stream, which replaces
+ * the least recently used one. Hence, a few interleaved streams of the same
+ * client are detected independently.
+ */
+template <unsigned NUM_STREAMS, unsigned MAX_WINDOW>
+class Cache::Stream_detector
+{
+	public:
+
+		struct Stream
+		{
+			offset_t      next     = 0;  /* chunk following the last access */
+			offset_t      ahead    = 0;  /* chunk following the read ahead */
+			unsigned      window   = 0;  /* read-ahead chunks, 0 if random */
+			unsigned long last_use = 0;
+		};
+
+	private:
+
+		Stream        _streams[NUM_STREAMS];
+		unsigned long _use_count = 0;
+
+		/*
+		 * Accesses that stay within the last accessed chunk continue the
+		 * stream as well, e.g., block-wise reads of the same chunk.
+		 */
+		static bool _continues(Stream const &s, offset_t first) {
+			return s.last_use && first + 1 >= s.next && first <= s.next; }
+
+	public:
+
+		/**
+		 * Account access of the chunks 'first' to 'end' (exclusive)
+		 *
+		 * \return  stream the access belongs to
+		 */
+		Stream &access(offset_t first, offset_t end)
+		{
+			_use_count++;
+
+			Stream *lru = &_streams[0];
+			for (Stream &s : _streams) {
+
+				if (_continues(s, first)) {
+					if (end > s.next)
+						s.window = s.window ? Genode::min(2*s.window, MAX_WINDOW) : 1;
+
+					s.next     = Genode::max(s.next, end);
+					s.last_use = _use_count;
+					return s;
+				}
+
+				if (s.last_use < lru->last_use)
+					lru = &s;
+			}
+
+			*lru = Stream();
+			lru->next     = end;
+			lru->ahead    = end;
+			lru->last_use = _use_count;
+			return *lru;
+		}
+};
+
+#endif /* _STREAM_H_ */
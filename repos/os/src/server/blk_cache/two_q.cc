@@ -0,0 +1,186 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "two_q.h"
+#include "driver.h"
+
+typedef Driver<Two_q_policy>::Chunk_level_4 Chunk;
+typedef Two_q_policy::Element               Element;
+
+
+/**
+ * Queue of resident chunks, the oldest chunk comes first
+ */
+struct Chunk_queue
+{
+	Genode::List<Element>  list;
+	Element const         *tail   = 0;
+	unsigned long          length = 0;
+
+	void append(Element const *e)
+	{
+		list.insert(e, tail);
+		tail = e;
+		length++;
+	}
+
+	void remove(Element const *e)
+	{
+		list.remove(e);
+		length--;
+
+		if (e == tail)
+			for (tail = list.first(); tail && tail->next(); tail = tail->next());
+	}
+
+	/**
+	 * Return oldest chunk that can be freed, or 0
+	 */
+	Element *oldest_clean()
+	{
+		for (Element *e = list.first(); e; e = e->next())
+			if (!static_cast<Chunk*>(e)->dirty())
+				return e;
+		return 0;
+	}
+};
+
+
+/**
+ * Offsets of the chunks recently evicted from 'A1in'
+ */
+struct Ghost_queue
+{
+	enum { MAX_GHOSTS = 1024, INVALID = ~0ULL };
+
+	Cache::offset_t offsets[MAX_GHOSTS];
+	unsigned        next   = 0;
+	unsigned        length = 0;
+
+	void remember(Cache::offset_t off)
+	{
+		offsets[next] = off;
+		next          = (next + 1) % MAX_GHOSTS;
+		length        = Genode::min(length + 1, (unsigned)MAX_GHOSTS);
+	}
+
+	/**
+	 * Forget offset and return true if it was remembered
+	 */
+	bool forget(Cache::offset_t off)
+	{
+		for (unsigned i = 0; i < length; i++)
+			if (offsets[i] == off) {
+				offsets[i] = INVALID;
+				return true;
+			}
+		return false;
+	}
+};
+
+
+static Chunk_queue         a1in;
+static Chunk_queue         am;
+static Ghost_queue         a1out;
+static Cache::Policy_stats two_q_stats;
+
+
+void Two_q_policy::_access(const Element *e)
+{
+	switch (e->_queue) {
+
+	case AM:
+		am.remove(e);
+		am.append(e);
+		return;
+
+	case A1IN:
+		return;
+
+	case NONE:
+		two_q_stats.resident++;
+
+		if (a1out.forget(static_cast<Chunk const*>(e)->base_offset())) {
+			e->_queue = AM;
+			am.append(e);
+		} else {
+			e->_queue = A1IN;
+			a1in.append(e);
+		}
+		return;
+	}
+}
+
+
+void Two_q_policy::_evict(Element *e)
+{
+	Chunk *cb = static_cast<Chunk*>(e);
+
+	if (e->_queue == A1IN) {
+		a1in.remove(e);
+		a1out.remember(cb->base_offset());
+	} else
+		am.remove(e);
+
+	e->_queue = NONE;
+
+	cb->free(Driver<Two_q_policy>::CACHE_BLK_SIZE, cb->base_offset());
+
+	two_q_stats.evictions++;
+	two_q_stats.resident--;
+}
+
+
+void Two_q_policy::read(const Element  *e) { _access(e); }
+
+
+void Two_q_policy::write(const Element *e) { _access(e); }
+
+
+Cache::Policy_stats &Two_q_policy::stats() { return two_q_stats; }
+
+
+void Two_q_policy::report(Genode::Xml_generator &xml)
+{
+	two_q_stats.report(xml);
+	xml.attribute("a1in",  a1in.length);
+	xml.attribute("am",    am.length);
+	xml.attribute("a1out", a1out.length);
+}
+
+
+void Two_q_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+
+	/*
+	 * 'A1in' is entitled to a quarter of the resident chunks. Dirty
+	 * chunks are left to the write back of the driver.
+	 */
+	while ((size == 0) || (s < size)) {
+
+		bool const a1in_first = a1in.length > two_q_stats.resident / 4
+		                     || am.length == 0;
+
+		Element *e = a1in_first ? a1in.oldest_clean() : am.oldest_clean();
+		if (!e)
+			e = a1in_first ? am.oldest_clean() : a1in.oldest_clean();
+		if (!e)
+			break;
+
+		_evict(e);
+		s += sizeof(Chunk);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
@@ -0,0 +1,55 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <util/list.h>
+
+#include "chunk.h"
+#include "policy_stats.h"
+
+/**
+ * 2Q replacement strategy
+ *
+ * Chunks accessed for the first time enter the FIFO queue 'A1in'. Chunks
+ * evicted from 'A1in' are remembered in the ghost queue 'A1out'. Only
+ * chunks that get accessed again while remembered in 'A1out' enter the LRU
+ * queue 'Am'. Hence, a large sequential scan cycles through 'A1in' only and
+ * leaves the working set in 'Am' untouched.
+ */
+struct Two_q_policy
+{
+	enum Queue { NONE, A1IN, AM };
+
+	class Element : public Genode::List<Element>::Element
+	{
+		private:
+
+			friend struct Two_q_policy;
+
+			mutable Queue _queue = NONE;
+	};
+
+	static char const *name() { return "2q"; }
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void flush(Cache::size_t size = 0);
+
+	static Cache::Policy_stats &stats();
+
+	static void report(Genode::Xml_generator &xml);
+
+	private:
+
+		static void _access(const Element *e);
+		static void _evict(Element *e);
+};
@@ -60,10 +60,11 @@ struct Rom::Registry : Rom::Registry_for_reader, Rom::Registry_for_writer
 	 * Constructor
 	 */
 	Registry(Genode::Ram_session &ram, Genode::Region_map &rm,
+	         Genode::Allocator &md_alloc,
 	         Module::Read_policy  const &read_policy,
 	         Module::Write_policy const &write_policy)
 	:
-		module(ram, rm, "clipboard", read_policy, write_policy)
+		module(ram, rm, md_alloc, "clipboard", read_policy, write_policy)
 	{ }
 };
 
@@ -74,6 +75,8 @@ struct Clipboard::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 
 	Genode::Sliced_heap _sliced_heap = { _env.ram(), _env.rm() };
 
+	Genode::Heap _heap = { _env.ram(), _env.rm() };
+
 	Genode::Attached_rom_dataspace _config { _env, "config" };
 
 	bool _verbose_config()
@@ -199,7 +202,7 @@ struct Clipboard::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 		return false;
 	}
 
-	Rom::Registry _rom_registry { _env.ram(), _env.rm(), *this, *this };
+	Rom::Registry _rom_registry { _env.ram(), _env.rm(), _heap, *this, *this };
 
 	Report::Root report_root = { _env, _sliced_heap, _rom_registry, verbose };
 	Rom   ::Root    rom_root = { _env, _sliced_heap, _rom_registry };
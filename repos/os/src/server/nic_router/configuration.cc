@@ -45,7 +45,9 @@ static unsigned read_rtt_sec(Xml_node const node)
 Configuration::Configuration(Xml_node const node, Allocator &alloc)
 :
 	_alloc(alloc), _verbose(node.attribute_value("verbose", false)),
-	_rtt_sec(read_rtt_sec(node)), _node(node)
+	_rtt_sec(read_rtt_sec(node)),
+	_poll_iterations(node.attribute_value("poll_iterations", 0U)),
+	_node(node)
 {
 	/* read domains */
 	node.for_each_sub_node("domain", [&] (Xml_node const node) {
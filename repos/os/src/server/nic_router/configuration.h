@@ -29,6 +29,7 @@ class Net::Configuration
 		Genode::Allocator      &_alloc;
 		bool             const  _verbose;
 		unsigned         const  _rtt_sec;
+		unsigned         const  _poll_iterations;
 		Domain_tree             _domains;
 		Genode::Xml_node const  _node;
 
@@ -41,10 +42,11 @@ class Net::Configuration
 		 ** Accessors **
 		 ***************/
 
-		bool              verbose() const { return _verbose; }
-		unsigned          rtt_sec() const { return _rtt_sec; }
-		Domain_tree      &domains()       { return _domains; }
-		Genode::Xml_node  node()    const { return _node; }
+		bool              verbose()         const { return _verbose; }
+		unsigned          rtt_sec()         const { return _rtt_sec; }
+		unsigned          poll_iterations() const { return _poll_iterations; }
+		Domain_tree      &domains()               { return _domains; }
+		Genode::Xml_node  node()            const { return _node; }
 };
 
 #endif /* _CONFIGURATION_H_ */
@@ -21,6 +21,7 @@
 
 /* local includes */
 #include <rule.h>
+#include <prefix_trie.h>
 
 namespace Genode { class Xml_node; }
 
@@ -73,28 +74,72 @@ struct Net::Direct_rule_list : Genode::List<T>
 
 	struct No_match : Genode::Exception { };
 
-	T const &longest_prefix_match(Ipv4_address const &ip) const
-	{
-		/* first match is sufficient as the list is prefix-size-sorted */
-		for (T const *curr = List::first(); curr; curr = curr->next()) {
-			if (curr->dst().prefix_matches(ip)) {
-				return *curr; }
+	private:
+
+		Prefix_trie<T> *_trie = nullptr;
+
+		void _destroy_trie()
+		{
+			if (_trie) {
+				Genode::destroy(_trie->alloc(), _trie); }
+
+			_trie = nullptr;
+		}
+
+	public:
+
+		~Direct_rule_list() { _destroy_trie(); }
+
+		T const &longest_prefix_match(Ipv4_address const &ip) const
+		{
+			if (_trie) {
+				T const *const rule = _trie->longest_prefix_match(ip);
+				if (!rule) {
+					throw No_match(); }
+
+				return *rule;
+			}
+			/* first match is sufficient as the list is prefix-size-sorted */
+			for (T const *curr = List::first(); curr; curr = curr->next()) {
+				if (curr->dst().prefix_matches(ip)) {
+					return *curr; }
+			}
+			throw No_match();
+		}
+
+		void insert(T &rule)
+		{
+			/* the compiled lookup structure is outdated from now on */
+			_destroy_trie();
+
+			/* ensure that the list stays prefix-size-sorted (descending) */
+			T *behind = nullptr;
+			for (T *curr = List::first(); curr; curr = curr->next()) {
+				if (rule.dst().prefix >= curr->dst().prefix) {
+					break; }
+
+				behind = curr;
+			}
+			List::insert(&rule, behind);
 		}
-		throw No_match();
-	}
-
-	void insert(T &rule)
-	{
-		/* ensure that the list stays prefix-size-sorted (descending) */
-		T *behind = nullptr;
-		for (T *curr = List::first(); curr; curr = curr->next()) {
-			if (rule.dst().prefix >= curr->dst().prefix) {
-				break; }
-
-			behind = curr;
+
+		/**
+		 * Compile the rules into a trie for longest-prefix matching
+		 *
+		 * The trie is built completely before it replaces the former one,
+		 * so lookups always refer to a consistent rule set. As the trie
+		 * keeps the first association of a prefix, inserting the rules in
+		 * list order preserves the precedence of the list lookup.
+		 */
+		void compile(Genode::Allocator &alloc)
+		{
+			Prefix_trie<T> &trie = *new (alloc) Prefix_trie<T>(alloc);
+			for (T const *curr = List::first(); curr; curr = curr->next()) {
+				trie.insert(curr->dst(), *curr); }
+
+			_destroy_trie();
+			_trie = &trie;
 		}
-		List::insert(&rule, behind);
-	}
 };
 
 #endif /* _RULE_H_ */
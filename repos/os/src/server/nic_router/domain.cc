@@ -129,6 +129,10 @@ void Domain::create_rules(Domain_tree &domains)
 		try { _ip_rules.insert(*new (_alloc) Ip_rule(domains, node)); }
 		catch (Rule::Invalid) { warning("invalid IP rule"); }
 	});
+	/* compile the lookup structures for direct rules */
+	_ip_rules.compile(_alloc);
+	_tcp_rules.compile(_alloc);
+	_udp_rules.compile(_alloc);
 }
 
 
@@ -75,18 +75,16 @@ static void _link_packet(uint8_t  const  prot,
 }
 
 
-static void _update_checksum(uint8_t       const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst)
+static void _update_checksum(uint8_t                const  prot,
+                             void                  *const  prot_base,
+                             Internet_checksum_diff const &icd)
 {
 	switch (prot) {
 	case Tcp_packet::IP_ID:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
+		((Tcp_packet *)prot_base)->update_checksum(icd);
 		return;
 	case Udp_packet::IP_ID:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
+		((Udp_packet *)prot_base)->update_checksum(icd);
 		return;
 	default: throw Interface::Bad_transport_protocol(); }
 }
@@ -147,15 +145,29 @@ static void *_prot_base(uint8_t const  prot,
  ** Interface **
  ***************/
 
-void Interface::_pass_ip(Ethernet_frame &eth,
-                         size_t   const  eth_size,
-                         Ipv4_packet    &ip,
-                         uint8_t  const  prot,
-                         void    *const  prot_base,
-                         size_t   const  prot_size)
-{
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst());
-	ip.checksum(Ipv4_packet::calculate_checksum(ip));
+void Interface::_pass_ip(Ethernet_frame     &eth,
+                         size_t       const  eth_size,
+                         Ipv4_packet        &ip,
+                         uint8_t      const  prot,
+                         void        *const  prot_base,
+                         Link_side_id const &orig_id)
+{
+	/*
+	 * Adapt the checksums to the rewritten addresses and ports instead of
+	 * recalculating them, so the costs do not depend on the payload size.
+	 * The IPv4 addresses are also covered by the TCP/UDP pseudo header.
+	 */
+	Internet_checksum_diff ip_icd;
+	ip_icd.add_up_diff(ip.src(), orig_id.src_ip);
+	ip_icd.add_up_diff(ip.dst(), orig_id.dst_ip);
+	ip.update_checksum(ip_icd);
+
+	Internet_checksum_diff prot_icd;
+	prot_icd.add_up_diff(ip_icd);
+	prot_icd.add_up_diff(_src_port(prot, prot_base), orig_id.src_port);
+	prot_icd.add_up_diff(_dst_port(prot, prot_base), orig_id.dst_port);
+	_update_checksum(prot, prot_base, prot_icd);
+
 	_send(eth, eth_size);
 }
 
@@ -270,7 +282,6 @@ void Interface::_nat_link_and_pass(Ethernet_frame      &eth,
                                    Ipv4_packet         &ip,
                                    uint8_t       const  prot,
                                    void         *const  prot_base,
-                                   size_t        const  prot_size,
                                    Link_side_id  const &local,
                                    Interface           &interface)
 {
@@ -288,7 +299,7 @@ void Interface::_nat_link_and_pass(Ethernet_frame      &eth,
 	Link_side_id const remote = { ip.dst(), _dst_port(prot, prot_base),
 	                              ip.src(), _src_port(prot, prot_base) };
 	_new_link(prot, local, remote_port_alloc, interface, remote);
-	interface._pass_ip(eth, eth_size, ip, prot, prot_base, prot_size);
+	interface._pass_ip(eth, eth_size, ip, prot, prot_base, local);
 }
 
 
@@ -325,7 +336,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 		_src_port(prot, prot_base, remote_side.dst_port());
 		_dst_port(prot, prot_base, remote_side.src_port());
 
-		interface._pass_ip(eth, eth_size, ip, prot, prot_base, prot_size);
+		interface._pass_ip(eth, eth_size, ip, prot, prot_base, local);
 		_link_packet(prot, prot_base, link, client);
 		return;
 	}
@@ -343,8 +354,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 
 			_adapt_eth(eth, eth_size, rule.to(), pkt, interface);
 			ip.dst(rule.to());
-			_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-			                   local, interface);
+			_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, local,
+			                   interface);
 			return;
 		}
 		catch (Forward_rule_tree::No_match) { }
@@ -363,8 +374,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			    " ", permit_rule); }
 
 		_adapt_eth(eth, eth_size, local.dst_ip, pkt, interface);
-		_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-		                   local, interface);
+		_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, local,
+		                   interface);
 		return;
 	}
 	catch (Transport_rule_list::No_match) { }
@@ -380,7 +391,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			log("Using IP rule: ", rule); }
 
 		_adapt_eth(eth, eth_size, local.dst_ip, pkt, interface);
-		interface._pass_ip(eth, eth_size, ip, prot, prot_base, prot_size);
+		interface._pass_ip(eth, eth_size, ip, prot, prot_base, local);
 		return;
 	}
 	catch (Ip_rule_list::No_match) { }
@@ -484,7 +495,7 @@ void Interface::_handle_arp(Ethernet_frame &eth, size_t const eth_size)
 }
 
 
-void Interface::_ready_to_submit()
+void Interface::_handle_packets()
 {
 	while (_sink().packet_avail()) {
 
@@ -499,6 +510,30 @@ void Interface::_ready_to_submit()
 }
 
 
+void Interface::_ready_to_submit()
+{
+	_handle_packets();
+
+	unsigned const poll_iterations = _config().poll_iterations();
+	if (!poll_iterations) {
+		return; }
+
+	/*
+	 * Poll the submit queue for a bounded number of iterations before
+	 * falling back to signal-driven operation, so that the peer does not
+	 * need to signal each burst of packets. The bound is absolute, so
+	 * steady traffic cannot starve the other handlers of the entrypoint.
+	 */
+	_sink().suppress_packet_avail();
+	for (unsigned i = 0; i < poll_iterations; i++) {
+		if (_sink().packet_avail()) {
+			_handle_packets(); }
+	}
+	if (_sink().resume_packet_avail()) {
+		_handle_packets(); }
+}
+
+
 void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 {
 	try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
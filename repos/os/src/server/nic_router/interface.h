@@ -96,7 +96,6 @@ class Net::Interface
 		                        Ipv4_packet            &ip,
 		                        Genode::uint8_t  const  prot,
 		                        void            *const  prot_base,
-		                        Genode::size_t   const  prot_size,
 		                        Link_side_id     const &local_id,
 		                        Interface              &interface);
 
@@ -109,7 +108,7 @@ class Net::Interface
 		              Ipv4_packet            &ip,
 		              Genode::uint8_t  const  prot,
 		              void            *const  prot_base,
-		              Genode::size_t   const  prot_size);
+		              Link_side_id     const &orig_id);
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
@@ -127,6 +126,8 @@ class Net::Interface
 
 		void _ack_packet(Packet_descriptor const &pkt);
 
+		void _handle_packets();
+
 		void _cancel_arp_waiting(Arp_waiter &waiter);
 
 		virtual Packet_stream_sink &_sink() = 0;
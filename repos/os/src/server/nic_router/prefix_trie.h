@@ -0,0 +1,175 @@
+/*
+ * \brief  Path-compressed binary trie for IPv4 longest-prefix matching
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PREFIX_TRIE_H_
+#define _PREFIX_TRIE_H_
+
+/* Genode includes */
+#include <net/ipv4.h>
+#include <base/allocator.h>
+
+namespace Net { template <typename> class Prefix_trie; }
+
+
+/**
+ * Maps IPv4 address prefixes to objects of type 'T'
+ *
+ * Each node stores a prefix and branches according to the first address bit
+ * behind this prefix. Chains of single-child nodes are collapsed, so the
+ * trie has at most two nodes per inserted prefix and a lookup visits at most
+ * 33 nodes regardless of the number of prefixes.
+ */
+template <typename T>
+class Net::Prefix_trie
+{
+	private:
+
+		struct Node
+		{
+			Genode::uint32_t const  addr;
+			unsigned         const  len;
+			T                const *value;
+			Node                   *child[2];
+
+			Node(Genode::uint32_t addr, unsigned len)
+			:
+				addr(addr & _mask(len)), len(len), value(nullptr),
+				child { nullptr, nullptr }
+			{ }
+		};
+
+		Genode::Allocator &_alloc;
+		Node              *_root = nullptr;
+
+		static Genode::uint32_t _mask(unsigned len) {
+			return len ? ~(Genode::uint32_t)0 << (32 - len) : 0; }
+
+		static unsigned _bit(Genode::uint32_t addr, unsigned idx) {
+			return (addr >> (31 - idx)) & 1; }
+
+		/**
+		 * Return number of leading bits that 'a' and 'b' have in common
+		 */
+		static unsigned _common_len(Genode::uint32_t a, Genode::uint32_t b,
+		                            unsigned max)
+		{
+			unsigned len = 0;
+			for (; len < max && _bit(a, len) == _bit(b, len); len++) { }
+			return len;
+		}
+
+		void _destroy(Node *node)
+		{
+			if (!node) {
+				return; }
+
+			_destroy(node->child[0]);
+			_destroy(node->child[1]);
+			Genode::destroy(_alloc, node);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Prefix_trie(Prefix_trie const &);
+		Prefix_trie &operator = (Prefix_trie const &);
+
+	public:
+
+		static Genode::uint32_t to_uint32(Ipv4_address const &ip)
+		{
+			return ((Genode::uint32_t)ip.addr[0] << 24) |
+			       ((Genode::uint32_t)ip.addr[1] << 16) |
+			       ((Genode::uint32_t)ip.addr[2] <<  8) |
+			        (Genode::uint32_t)ip.addr[3];
+		}
+
+		Prefix_trie(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Prefix_trie() { _destroy(_root); }
+
+		/**
+		 * Associate 'value' with 'prefix'
+		 *
+		 * If the prefix is already associated with a value, the former
+		 * association is kept.
+		 */
+		void insert(Ipv4_address_prefix const &prefix, T const &value)
+		{
+			Genode::uint32_t const addr = to_uint32(prefix.address) &
+			                              _mask(prefix.prefix);
+			unsigned         const len  = prefix.prefix;
+
+			for (Node **curr = &_root;;) {
+
+				if (!*curr) {
+					*curr = new (_alloc) Node(addr, len);
+					(*curr)->value = &value;
+					return;
+				}
+				Node &node = **curr;
+				unsigned const common = _common_len(addr, node.addr,
+				                                    len < node.len ? len : node.len);
+
+				/* node prefix covers the new prefix, descend */
+				if (common == node.len) {
+					if (len == node.len) {
+						if (!node.value) {
+							node.value = &value; }
+						return;
+					}
+					curr = &node.child[_bit(addr, node.len)];
+					continue;
+				}
+				/* split at the first differing bit or at the new prefix */
+				Node &split = *new (_alloc) Node(addr, common);
+				split.child[_bit(node.addr, common)] = &node;
+				if (common == len) {
+					split.value = &value;
+				} else {
+					Node &leaf = *new (_alloc) Node(addr, len);
+					leaf.value = &value;
+					split.child[_bit(addr, common)] = &leaf;
+				}
+				*curr = &split;
+				return;
+			}
+		}
+
+		/**
+		 * Return value of the longest prefix that matches 'ip' or nullptr
+		 */
+		T const *longest_prefix_match(Ipv4_address const &ip) const
+		{
+			Genode::uint32_t const addr  = to_uint32(ip);
+			T                const *match = nullptr;
+
+			for (Node const *node = _root; node; ) {
+				if ((addr ^ node->addr) & _mask(node->len)) {
+					break; }
+
+				if (node->value) {
+					match = node->value; }
+
+				if (node->len == 32) {
+					break; }
+
+				node = node->child[_bit(addr, node->len)];
+			}
+			return match;
+		}
+
+		Genode::Allocator &alloc() const { return _alloc; }
+};
+
+#endif /* _PREFIX_TRIE_H_ */
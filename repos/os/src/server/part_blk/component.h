@@ -17,10 +17,12 @@
 #include <base/exception.h>
 #include <base/component.h>
 #include <os/session_policy.h>
+#include <util/reconstructible.h>
 #include <root/component.h>
 #include <block_session/rpc_object.h>
 
 #include "gpt.h"
+#include "tx_buffer.h"
 
 namespace Block {
 
@@ -31,14 +33,13 @@ namespace Block {
 };
 
 
-class Block::Session_component : public Block::Session_rpc_object,
+class Block::Session_component : private Block::Tx_buffer,
+                                 public Block::Session_rpc_object,
                                  public List<Block::Session_component>::Element,
                                  public Block_dispatcher
 {
 	private:
 
-		Ram_dataspace_capability          _rq_ds;
-		addr_t                            _rq_phys;
 		Partition                        *_partition;
 		Signal_handler<Session_component> _sink_ack;
 		Signal_handler<Session_component> _sink_submit;
@@ -46,6 +47,7 @@ class Block::Session_component : public Block::Session_rpc_object,
 		bool                              _ack_queue_full;
 		Packet_descriptor                 _p_to_handle;
 		unsigned                          _p_in_fly;
+		unsigned                   const  _poll_iterations;
 		Block::Driver                    &_driver;
 
 		/**
@@ -66,6 +68,12 @@ class Block::Session_component : public Block::Session_rpc_object,
 		inline bool _range_check(Packet_descriptor &p) {
 			return p.block_number() + p.block_count() <= _partition->sectors; }
 
+		/**
+		 * Check that the requested blocks fit into the packet
+		 */
+		inline bool _size_check(Packet_descriptor &p) {
+			return p.block_count() <= p.size() / _driver.blk_size(); }
+
 		/**
 		 * Handle a single request
 		 */
@@ -75,7 +83,8 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_p_to_handle.succeeded(false);
 
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!packet.size() || !_range_check(_p_to_handle)
+			 || !_size_check(_p_to_handle)) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
@@ -85,7 +94,11 @@ class Block::Session_component : public Block::Session_rpc_object,
 			size_t cnt   = _p_to_handle.block_count();
 			void* addr   = tx_sink()->packet_content(_p_to_handle);
 			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
+				Genode::off_t window_offset = 0;
+				if (translate(_p_to_handle, window_offset))
+					_driver.io(write, off, cnt, window_offset, *this, _p_to_handle);
+				else
+					_driver.io(write, off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				if (!_req_queue_full) {
 					_req_queue_full = true;
@@ -95,9 +108,9 @@ class Block::Session_component : public Block::Session_rpc_object,
 		}
 
 		/**
-		 * Triggered when a packet was placed into the empty submit queue
+		 * Hand over available packets to the driver
 		 */
-		void _packet_avail()
+		void _handle_packets()
 		{
 			_ack_queue_full = _p_in_fly >= tx_sink()->ack_slots_free();
 
@@ -112,30 +125,63 @@ class Block::Session_component : public Block::Session_rpc_object,
 					_handle_packet(tx_sink()->get_packet());
 		}
 
+		/**
+		 * Triggered when a packet was placed into the empty submit queue
+		 */
+		void _packet_avail()
+		{
+			_handle_packets();
+
+			if (!_poll_iterations)
+				return;
+
+			/*
+			 * Poll the submit queue for a bounded number of iterations
+			 * before falling back to signal-driven operation, so that the
+			 * client does not need to signal each burst of packets. The
+			 * bound is absolute, so steady traffic cannot starve the other
+			 * handlers of the entrypoint.
+			 */
+			tx_sink()->suppress_packet_avail();
+
+			for (unsigned i = 0; i < _poll_iterations; i++) {
+
+				if (_req_queue_full || _ack_queue_full)
+					break;
+
+				if (tx_sink()->packet_avail())
+					_handle_packets();
+			}
+
+			if (tx_sink()->resume_packet_avail())
+				_handle_packets();
+		}
+
 		/**
 		 * Triggered when an ack got removed from the full ack queue
 		 */
-		void _ready_to_ack() { _packet_avail(); }
+		void _ready_to_ack() { _handle_packets(); }
 
 	public:
 
 		/**
 		 * Constructor
 		 */
-		Session_component(Ram_dataspace_capability  rq_ds,
+		Session_component(Genode::Env              &env,
+		                  size_t                    tx_buf_size,
+		                  Genode::Rm_connection    *rm_connection,
 		                  Partition                *partition,
-		                  Genode::Entrypoint       &ep,
-		                  Genode::Region_map       &rm,
-		                  Block::Driver            &driver)
-		: Session_rpc_object(rm, rq_ds, ep.rpc_ep()),
-		  _rq_ds(rq_ds),
-		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
+		                  Block::Driver            &driver,
+		                  unsigned                  poll_iterations)
+		: Tx_buffer(env, driver, tx_buf_size, rm_connection),
+		  Session_rpc_object(env.rm(), Tx_buffer::dataspace(), env.ep().rpc_ep()),
 		  _partition(partition),
-		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
-		  _sink_submit(ep, *this, &Session_component::_packet_avail),
+		  _sink_ack(env.ep(), *this, &Session_component::_ready_to_ack),
+		  _sink_submit(env.ep(), *this, &Session_component::_packet_avail),
 		  _req_queue_full(false),
 		  _ack_queue_full(false),
 		  _p_in_fly(0),
+		  _poll_iterations(poll_iterations),
 		  _driver(driver)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
@@ -150,12 +196,15 @@ class Block::Session_component : public Block::Session_rpc_object,
 				wait_queue().remove(this);
 		}
 
-		Ram_dataspace_capability const rq_ds() const { return _rq_ds; }
 		Partition *partition() { return _partition; }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
 		{
-			if (request.operation() == Block::Packet_descriptor::READ) {
+			Genode::off_t window_offset = 0;
+
+			/* data of requests within the window is already in place */
+			if (request.operation() == Block::Packet_descriptor::READ
+			 && !translate(request, window_offset)) {
 				void *src =
 					_driver.session().tx()->packet_content(reply);
 				Genode::size_t sz =
@@ -166,7 +215,7 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_ack_packet(request);
 
 			if (_ack_queue_full)
-				_packet_avail();
+				_handle_packets();
 		}
 
 		static List<Session_component>& wait_queue()
@@ -182,7 +231,7 @@ class Block::Session_component : public Block::Session_rpc_object,
 				wait_queue().remove(c);
 				c->_req_queue_full = false;
 				c->_handle_packet(c->_p_to_handle);
-				c->_packet_avail();
+				c->_handle_packets();
 			}
 		}
 
@@ -214,21 +263,31 @@ class Block::Root :
 		Block::Driver          &_driver;
 		Block::Partition_table &_table;
 
-	protected:
+		/* used for the buffers of zero-copy sessions, created on demand */
+		Genode::Constructible<Genode::Rm_connection> _rm_connection;
 
-		void _destroy_session(Session_component *session) override
+		Genode::Rm_connection *_zero_copy_rm()
 		{
-			Ram_dataspace_capability rq_ds = session->rq_ds();
-			Genode::Root_component<Session_component>::_destroy_session(session);
-			_env.ram().free(rq_ds);
+			try {
+				if (!_rm_connection.constructed())
+					_rm_connection.construct(_env);
+				return &*_rm_connection;
+			} catch (...) {
+				warning("RM service unavailable, disable zero copy");
+				return nullptr;
+			}
 		}
 
+	protected:
+
 		/**
 		 * Always returns the singleton block-session component
 		 */
 		Session_component *_create_session(const char *args) override
 		{
-			long num = -1;
+			long     num             = -1;
+			unsigned poll_iterations =  0;
+			bool     zero_copy       = false;
 
 			Session_label const label = label_from_args(args);
 			char const *label_str = label.string();
@@ -238,6 +297,12 @@ class Block::Root :
 				/* read partition attribute */
 				policy.attribute("partition").value(&num);
 
+				/* read optional busy-poll window */
+				poll_iterations = policy.attribute_value("poll_iterations", 0U);
+
+				/* read optional sharing of the backend buffer */
+				zero_copy = policy.attribute_value("zero_copy", false);
+
 			} catch (Xml_node::Nonexistent_attribute) {
 				error("policy does not define partition number for for '",
 				      label_str, "'");
@@ -279,11 +344,11 @@ class Block::Root :
 				throw Root::Quota_exceeded();
 			}
 
-			Ram_dataspace_capability ds_cap;
-			ds_cap = _env.ram().alloc(tx_buf_size);
 			Session_component *session = new (md_alloc())
-				Session_component(ds_cap, _table.partition(num),
-				                  _env.ep(), _env.rm(), _driver);
+				Session_component(_env, tx_buf_size,
+				                  zero_copy ? _zero_copy_rm() : nullptr,
+				                  _table.partition(num), _driver,
+				                  poll_iterations);
 
 			log("session opened at partition ", num, " for '", label_str, "'");
 			return session;
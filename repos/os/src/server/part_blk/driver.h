@@ -53,34 +53,77 @@ class Block::Driver
 	{
 		private:
 
-			Block_dispatcher &_dispatcher;
+			Block_dispatcher *_dispatcher;  /* nullptr if client is gone */
 			Packet_descriptor _cli;
 			Packet_descriptor _srv;
+			bool const        _release;  /* packet allocated by the driver */
 
 		public:
 
 			Request(Block_dispatcher &d,
 			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
+			        Packet_descriptor &srv,
+			        bool release)
+			: _dispatcher(&d), _cli(cli), _srv(srv), _release(release) {}
 
 			bool handle(Packet_descriptor& reply)
 			{
 				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
+				if (ret && _dispatcher) _dispatcher->dispatch(_cli, reply);
 				return ret;
 			}
 
 			bool same_dispatcher(Block_dispatcher &same) {
-				return &same == &_dispatcher; }
+				return &same == _dispatcher; }
+
+			/**
+			 * Detach request from its client, which is about to vanish
+			 */
+			void orphan() { _dispatcher = nullptr; }
+
+			bool release() const { return _release; }
+
+			/**
+			 * Return true if the backend packet lies within the given
+			 * range of the packet buffer
+			 */
+			bool within(Genode::off_t offset, Genode::size_t size) const {
+				return _srv.offset() >= offset
+				    && _srv.offset() <  offset + (Genode::off_t)size; }
 	};
 
+	class Window_unavailable : Genode::Exception { };
+
 	private:
 
+		/**
+		 * Window of a closed session, which is still targeted by
+		 * backend packets in flight
+		 */
+		struct Window : Genode::List<Window>::Element
+		{
+			Genode::off_t  const offset;
+			Genode::size_t const size;
+
+			Window(Genode::off_t offset, Genode::size_t size)
+			: offset(offset), size(size) { }
+		};
+
 		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
 
+		/*
+		 * The windows of zero-copy clients may occupy at most half of the
+		 * packet buffer, each window at most a quarter. The remainder is
+		 * left to the packets of the copying clients.
+		 */
+		Genode::size_t const _max_windows_size;
+		Genode::size_t const _max_window_size;
+		Genode::size_t       _windows_size = 0;
+
+		Genode::Heap                  &_heap;
 		Genode::Tslab<Request, BLK_SZ> _r_slab;
 		Genode::List<Request>          _r_list;
+		Genode::List<Window>           _released_windows;
 		Genode::Allocator_avl          _block_alloc;
 		Block::Connection              _session;
 		Block::sector_t                _blk_cnt;
@@ -91,30 +134,86 @@ class Block::Driver
 
 		void _ready_to_submit();
 
+		void _free_window(Genode::off_t offset, Genode::size_t size)
+		{
+			_block_alloc.free((void *)offset);
+			_windows_size -= size;
+		}
+
+		bool _window_in_use(Genode::off_t offset, Genode::size_t size)
+		{
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (!r->release() && r->within(offset, size))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Free windows of closed sessions once all their packets are acked
+		 */
+		void _free_released_windows()
+		{
+			for (Window *w = _released_windows.first(); w;) {
+				Window *next = w->next();
+
+				if (!_window_in_use(w->offset, w->size)) {
+					_released_windows.remove(w);
+					_free_window(w->offset, w->size);
+					Genode::destroy(&_heap, w);
+				}
+				w = next;
+			}
+		}
+
 		void _ack_avail()
 		{
 			/* check for acknowledgements */
 			while (_session.tx()->ack_avail()) {
 				Packet_descriptor p = _session.tx()->get_acked_packet();
+				bool release = true;
 				for (Request *r = _r_list.first(); r; r = r->next()) {
 					if (r->handle(p)) {
+						release = r->release();
 						_r_list.remove(r);
 						Genode::destroy(&_r_slab, r);
 						break;
 					}
 				}
-				_session.tx()->release_packet(p);
+
+				/* packets within a client window are not allocated by us */
+				if (release)
+					_session.tx()->release_packet(p);
 			}
 
+			_free_released_windows();
 			_ready_to_submit();
 		}
 
+		void _submit(Packet_descriptor p, bool release,
+		             Block_dispatcher &dispatcher, Packet_descriptor &cli)
+		{
+			Request *r = new (&_r_slab) Request(dispatcher, cli, p, release);
+			_r_list.insert(r);
+
+			_session.tx()->submit_packet(p);
+		}
+
 	public:
 
-		Driver(Genode::Env &env, Genode::Heap &heap)
-		: _r_slab(&heap),
+		/**
+		 * Constructor
+		 *
+		 * \param tx_buf_size  size of the backend's packet buffer, which
+		 *                     also holds the windows of zero-copy clients
+		 */
+		Driver(Genode::Env &env, Genode::Heap &heap, Genode::size_t tx_buf_size)
+		: _max_windows_size(tx_buf_size/2),
+		  _max_window_size(tx_buf_size/4),
+		  _heap(heap),
+		  _r_slab(&heap),
 		  _block_alloc(&heap),
-		  _session(env, &_block_alloc, 4 * 1024 * 1024),
+		  _session(env, &_block_alloc, tx_buf_size),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit)
 		{
@@ -146,30 +245,90 @@ class Block::Driver
 			Genode::size_t size = _blk_size * cnt;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
 			                    op,  nr, cnt);
-			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
-			_r_list.insert(r);
 
 			if (write)
 				Genode::memcpy(_session.tx()->packet_content(p),
 				               addr, size);
 
-			_session.tx()->submit_packet(p);
+			_submit(p, true, dispatcher, cli);
 		}
 
-		void remove_dispatcher(Block_dispatcher &dispatcher)
+		/**
+		 * Submit request for data located in a window of the packet buffer
+		 *
+		 * \param offset  position of the data within the packet buffer
+		 */
+		void io(bool write, sector_t nr, Genode::size_t cnt, Genode::off_t offset,
+		        Block_dispatcher &dispatcher, Packet_descriptor& cli)
 		{
-			for (Request *r = _r_list.first(); r;) {
-				if (!r->same_dispatcher(dispatcher)) {
-					r = r->next();
-					continue;
-				}
+			if (!_session.tx()->ready_to_submit())
+				throw Block::Session::Tx::Source::Packet_alloc_failed();
+
+			Block::Packet_descriptor::Opcode op = write
+			    ? Block::Packet_descriptor::WRITE
+			    : Block::Packet_descriptor::READ;
+			Packet_descriptor p(Packet_descriptor(offset, _blk_size * cnt),
+			                    op, nr, cnt);
+
+			_submit(p, false, dispatcher, cli);
+		}
+
+		/**
+		 * Packet buffer of the backend session
+		 */
+		Genode::Dataspace_capability dataspace() {
+			return _session.tx()->dataspace(); }
+
+		/**
+		 * Reserve page-aligned window of the packet buffer
+		 *
+		 * \return  offset of the window within the packet buffer
+		 * \throw   Window_unavailable  window exceeds the share of the
+		 *                              packet buffer granted to windows
+		 */
+		Genode::off_t alloc_window(Genode::size_t size)
+		{
+			enum { PAGE_SIZE_LOG2 = 12 };
 
-				Request *remove = r;
-				r = r->next();
+			if (size > _max_window_size
+			 || size > _max_windows_size - _windows_size)
+				throw Window_unavailable();
+
+			void *offset = nullptr;
+			if (_block_alloc.alloc_aligned(size, &offset, PAGE_SIZE_LOG2).error())
+				throw Window_unavailable();
+
+			_windows_size += size;
+			return (Genode::off_t)offset;
+		}
 
-				_r_list.remove(remove);
-				Genode::destroy(&_r_slab, remove);
+		/**
+		 * Release window of the packet buffer
+		 *
+		 * As long as backend packets within the window are in flight, the
+		 * window stays allocated and is freed on their acknowledgement.
+		 */
+		void free_window(Genode::off_t offset, Genode::size_t size)
+		{
+			if (!_window_in_use(offset, size)) {
+				_free_window(offset, size);
+				return;
 			}
+
+			_released_windows.insert(new (&_heap) Window(offset, size));
+		}
+
+		/**
+		 * Detach requests of a vanishing client
+		 *
+		 * The requests are kept until their packets are acknowledged by
+		 * the backend. Only then, the packets are released.
+		 */
+		void remove_dispatcher(Block_dispatcher &dispatcher)
+		{
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (r->same_dispatcher(dispatcher))
+					r->orphan();
 		}
 };
 
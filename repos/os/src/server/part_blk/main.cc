@@ -32,9 +32,11 @@ class Main
 
 		Block::Partition_table & _table();
 
+		Genode::size_t _backend_buffer_size();
+
 		Genode::Env &       _env;
 		Genode::Heap        _heap   { _env.ram(), _env.rm() };
-		Block::Driver       _driver { _env, _heap      };
+		Block::Driver       _driver { _env, _heap, _backend_buffer_size() };
 		Mbr_partition_table _mbr    { _heap, _driver        };
 		Gpt                 _gpt    { _heap, _driver        };
 		Block::Root         _root   { _env, _heap, _driver, _table() };
@@ -57,6 +59,23 @@ class Main
 };
 
 
+/*
+ * The windows of zero-copy clients are part of the backend buffer. Hence, it
+ * must be dimensioned for the buffers of all zero-copy clients.
+ */
+Genode::size_t Main::_backend_buffer_size()
+{
+	Genode::Number_of_bytes size = 4 * 1024 * 1024;
+
+	try {
+		Genode::Attached_rom_dataspace config(_env, "config");
+		size = config.xml().attribute_value("buffer_size", size);
+	} catch(...) {}
+
+	return size;
+}
+
+
 Block::Partition_table & Main::_table()
 {
 	bool valid_mbr = false;
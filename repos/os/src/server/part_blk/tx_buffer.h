@@ -0,0 +1,169 @@
+/*
+ * \brief  Packet-stream buffer of a partition client
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PART_BLK__TX_BUFFER_H_
+#define _PART_BLK__TX_BUFFER_H_
+
+#include <base/env.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+
+#include "driver.h"
+
+namespace Block { class Tx_buffer; }
+
+
+/**
+ * Communication buffer of a client session
+ *
+ * By default, the buffer is a plain RAM dataspace and the payload of each
+ * request is copied from or to a packet of the backend session.
+ *
+ * In zero-copy mode, the buffer is a managed dataspace. Its first pages
+ * hold the descriptor queues of the client's packet stream and are backed
+ * by RAM. The remainder is a window of the backend's packet buffer.
+ * Packets of the client that lie within the window are forwarded to the
+ * backend with a translated offset. The payload is never touched by the
+ * partition server.
+ */
+class Block::Tx_buffer
+{
+	private:
+
+		enum { PAGE_SIZE = 4096 };
+
+		/*
+		 * Size of the descriptor queues at the start of the buffer, rounded
+		 * up to the page size
+		 */
+		enum {
+			QUEUES_SIZE = sizeof(Session::Tx_policy::Submit_queue)
+			            + sizeof(Session::Tx_policy::Ack_queue),
+			QUEUES_PAGES_SIZE = (QUEUES_SIZE + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1)
+		};
+
+		Genode::Env    &_env;
+		Block::Driver  &_driver;
+
+		Genode::Rm_connection *_rm_connection;
+
+		Genode::Ram_dataspace_capability _ram_ds;
+
+		Genode::Capability<Genode::Region_map> _rm_cap;
+
+		Genode::off_t  _window_offset = 0;  /* position in backend buffer */
+		Genode::size_t _window_size   = 0;
+
+		Genode::Dataspace_capability _ds;
+
+		void _construct_window(Genode::size_t size)
+		{
+			using namespace Genode;
+
+			_window_size   = (size - QUEUES_PAGES_SIZE) & ~(size_t)(PAGE_SIZE - 1);
+			_window_offset = _driver.alloc_window(_window_size);
+
+			try {
+				_ram_ds = _env.ram().alloc(QUEUES_PAGES_SIZE);
+				_rm_cap = _rm_connection->create(QUEUES_PAGES_SIZE + _window_size);
+
+				Region_map_client rm(_rm_cap);
+				rm.attach_at(_ram_ds, 0);
+				rm.attach_at(_driver.dataspace(), QUEUES_PAGES_SIZE,
+				             _window_size, _window_offset);
+
+				_ds = rm.dataspace();
+			} catch (...) {
+				_destruct_window();
+				throw;
+			}
+		}
+
+		void _destruct_window()
+		{
+			if (_rm_cap.valid())  _rm_connection->destroy(_rm_cap);
+			if (_ram_ds.valid())  _env.ram().free(_ram_ds);
+
+			_driver.free_window(_window_offset, _window_size);
+
+			_rm_cap = Genode::Capability<Genode::Region_map>();
+			_ram_ds = Genode::Ram_dataspace_capability();
+			_window_size = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param rm_connection  RM service for creating the managed
+		 *                       dataspace, or nullptr to disable zero copy
+		 *
+		 * If no window can be set up, the buffer falls back to a plain RAM
+		 * dataspace.
+		 */
+		Tx_buffer(Genode::Env &env, Block::Driver &driver,
+		          Genode::size_t size, Genode::Rm_connection *rm_connection)
+		:
+			_env(env), _driver(driver), _rm_connection(rm_connection)
+		{
+			if (_rm_connection && size > QUEUES_PAGES_SIZE + PAGE_SIZE) {
+				try {
+					_construct_window(size);
+					return;
+				}
+				catch (Driver::Window_unavailable) {
+					Genode::warning("buffer exceeds share of backend buffer, "
+					                "disable zero copy"); }
+				catch (...) {
+					Genode::warning("managed dataspace unavailable, disable zero copy"); }
+			}
+
+			_ram_ds = _env.ram().alloc(size);
+			_ds     = _ram_ds;
+		}
+
+		~Tx_buffer()
+		{
+			if (_window_size)
+				_destruct_window();
+			else
+				_env.ram().free(_ram_ds);
+		}
+
+		Genode::Dataspace_capability dataspace() const { return _ds; }
+
+		/**
+		 * Translate client packet to position within the backend buffer
+		 *
+		 * \return  false if the packet does not lie within the window or
+		 *          its blocks exceed the packet
+		 */
+		bool translate(Packet_descriptor const &packet, Genode::off_t &offset) const
+		{
+			Genode::off_t const start = QUEUES_PAGES_SIZE;
+			Genode::off_t const end   = start + _window_size;
+
+			if (packet.block_count() > packet.size() / _driver.blk_size())
+				return false;
+
+			if (!_window_size || packet.offset() < start
+			 || packet.offset() + (Genode::off_t)packet.size() > end)
+				return false;
+
+			offset = _window_offset + (packet.offset() - start);
+			return true;
+		}
+};
+
+#endif /* _PART_BLK__TX_BUFFER_H_ */
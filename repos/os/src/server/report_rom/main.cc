@@ -32,14 +32,20 @@ struct Report_rom::Main
 
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
+	/* meta data of ROM modules and their snapshots */
+	Genode::Heap heap { env.ram(), env.rm() };
+
+	Rom::Registry rom_registry { heap, env.ram(), env.rm(), config_rom };
 
 	Genode::Attached_rom_dataspace config_rom { env, "config" };
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	bool share_snapshots =
+		config_rom.xml().attribute_value("share_snapshots", false);
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
-	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
+	Rom   ::Root    rom_root { env, sliced_heap, rom_registry, share_snapshots };
 
 	Main(Genode::Env &env) : env(env)
 	{
@@ -72,7 +72,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, _md_alloc, name, _read_write_policy,
+				       _read_write_policy);
 
 			_modules.insert(module);
 			return *module;
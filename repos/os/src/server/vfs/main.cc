@@ -17,6 +17,8 @@
 #include <base/registry.h>
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/construct_at.h>
+#include <util/fifo.h>
 #include <file_system_session/rpc_object.h>
 #include <root/component.h>
 #include <os/session_policy.h>
@@ -64,11 +66,39 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 
 		bool _writable;
 
+		/**
+		 * Packet taken from the submit queue but not yet acknowledged
+		 */
+		struct Pending_packet : Genode::Fifo<Pending_packet>::Element
+		{
+			Packet_descriptor packet { };
+		};
+
 		/*
-		 * XXX Currently, we have only one packet in backlog, which must finish
-		 *     processing before new packets can be processed.
+		 * Each pending packet is either free, blocked until its node becomes
+		 * ready, or complete and waiting for a free slot in the
+		 * acknowledgement queue. The packets of each node are processed in
+		 * the order of their submission whereas the packets of different
+		 * nodes are processed independently of each other.
 		 */
-		Packet_descriptor _backlog_packet;
+		Genode::Fifo<Pending_packet> _free;
+		Genode::Fifo<Pending_packet> _blocked;    /* in submission order */
+		Genode::Fifo<Pending_packet> _completed;
+
+		unsigned         const _queue_depth;
+		Pending_packet * const _pending;
+
+		Pending_packet *_alloc_pending_packets()
+		{
+			Pending_packet *pending = nullptr;
+			if (!_alloc.alloc(_queue_depth*sizeof(Pending_packet), (void **)&pending))
+				throw Out_of_memory();
+
+			for (unsigned i = 0; i < _queue_depth; i++)
+				_free.enqueue(Genode::construct_at<Pending_packet>(&pending[i]));
+
+			return pending;
+		}
 
 		/****************************
 		 ** Handle to node mapping **
@@ -198,97 +228,128 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 			packet.succeeded(!!res_length);
 		}
 
-		bool _try_process_packet_op(Packet_descriptor &packet)
+		/**
+		 * Return true if a packet submitted before 'pending' addresses the
+		 * same node and is still blocked
+		 */
+		bool _blocked_by_predecessor(Pending_packet const &pending)
 		{
-			try {
-				_process_packet_op(packet);
-				return true;
-			} catch (Not_read_ready) {
-				_backlog_packet = packet;
-			}
+			Node_handle const handle = pending.packet.handle();
+
+			for (Pending_packet *p = _blocked.head(); p && p != &pending; p = p->next())
+				if (p->packet.handle() == handle)
+					return true;
 
 			return false;
 		}
 
-		bool _process_backlog()
+		enum class Op_result { COMPLETE, BLOCKED, DROPPED };
+
+		Op_result _try_process_packet_op(Packet_descriptor &packet)
 		{
-			/* indicate success if there's no backlog */
-			if (!_backlog_packet.size())
-				return true;
+			try {
+				_process_packet_op(packet);
+				return Op_result::COMPLETE;
+			}
+			catch (Not_read_ready) { return Op_result::BLOCKED; }
+			catch (Dont_ack)       { return Op_result::DROPPED; }
+		}
 
-			/* only start processing if acknowledgement is possible */
-			if (!tx_sink()->ready_to_ack())
-				return false;
+		/**
+		 * Acknowledge completed packets as long as the acknowledgement
+		 * queue has free slots
+		 *
+		 * Otherwise, the call of 'acknowledge_packet()' would infinitely
+		 * block the context of the entrypoint, which is however needed for
+		 * receiving any subsequent 'ready-to-ack' signals.
+		 */
+		void _acknowledge_completed()
+		{
+			while (!_completed.empty() && tx_sink()->ready_to_ack()) {
+				Pending_packet &pending = *_completed.dequeue();
+				tx_sink()->acknowledge_packet(pending.packet);
+				_free.enqueue(&pending);
+			}
+		}
 
-			if (!_try_process_packet_op(_backlog_packet))
-				return false;
+		/**
+		 * Retry blocked packets, of the given node only if 'node' is valid
+		 */
+		void _retry_blocked(Node_handle node = Node_handle())
+		{
+			for (Pending_packet *p = _blocked.head(), *next; p; p = next) {
+				next = p->next();
 
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(_backlog_packet);
+				if (node.valid() && p->packet.handle() != node)
+					continue;
 
-			/* invalidate backlog packet */
-			_backlog_packet = Packet_descriptor();
+				if (_blocked_by_predecessor(*p))
+					continue;
 
-			return true;
+				switch (_try_process_packet_op(p->packet)) {
+				case Op_result::BLOCKED:  break;
+				case Op_result::COMPLETE: _blocked.remove(p); _completed.enqueue(p); break;
+				case Op_result::DROPPED:  _blocked.remove(p); _free.enqueue(p);      break;
+				}
+			}
 		}
 
-		bool _process_packet()
+		/**
+		 * Take new packets from the submit queue while pending-packet slots
+		 * are available
+		 */
+		void _process_submitted()
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
+			while (!_free.empty() && tx_sink()->packet_avail()) {
 
-			if (!_try_process_packet_op(packet))
-				return false;
+				Pending_packet &pending = *_free.dequeue();
+				pending.packet = tx_sink()->get_packet();
 
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(packet);
+				/* preserve the order of operations on the same node */
+				_blocked.enqueue(&pending);
+				if (_blocked_by_predecessor(pending))
+					continue;
+
+				switch (_try_process_packet_op(pending.packet)) {
+				case Op_result::BLOCKED:  break;
+				case Op_result::COMPLETE: _blocked.remove(&pending); _completed.enqueue(&pending); break;
+				case Op_result::DROPPED:  _blocked.remove(&pending); _free.enqueue(&pending);      break;
+				}
+
+				_acknowledge_completed();
+			}
 
-			return true;
+			_acknowledge_completed();
 		}
 
 		/**
-		 * Called by signal dispatcher, executed in the context of the main
-		 * thread (not serialized with the RPC functions)
+		 * Called on packet-avail and ready-to-ack signals
 		 */
 		void _process_packets()
 		{
-			/*
-			 * XXX Process client backlog before looking at new requests. This
-			 *     limits the number of simultaneously addressed handles (which
-			 *     was also the case before adding the backlog in case of
-			 *     blocking operations).
-			 */
-			if (!_process_backlog())
-				/* backlog not cleared - block for next condition change */
-				return;
+			_acknowledge_completed();
+			_retry_blocked();
+			_process_submitted();
+		}
 
-			while (tx_sink()->packet_avail()) {
-
-				/*
-				 * Make sure that the '_process_packet' function does not
-				 * block.
-				 *
-				 * If the acknowledgement queue is full, we defer packet
-				 * processing until the client processed pending
-				 * acknowledgements and thereby emitted a ready-to-ack
-				 * signal. Otherwise, the call of 'acknowledge_packet()'
-				 * in '_process_packet' would infinitely block the context
-				 * of the main thread. The main thread is however needed
-				 * for receiving any subsequent 'ready-to-ack' signals.
-				 */
-				if (!tx_sink()->ready_to_ack())
-					return;
+		/**
+		 * Fail the blocked packets of a node that gets closed
+		 */
+		void _fail_blocked(Node_handle node)
+		{
+			for (Pending_packet *p = _blocked.head(), *next; p; p = next) {
+				next = p->next();
 
-				try {
-					if (!_process_packet())
-						return;
-				} catch (Dont_ack) { }
+				if (p->packet.handle() != node)
+					continue;
+
+				p->packet.length(0);
+				p->packet.succeeded(false);
+				_blocked.remove(p);
+				_completed.enqueue(p);
 			}
+
+			_acknowledge_completed();
 		}
 
 		/**
@@ -327,6 +388,7 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 * \param ep           thead entrypoint for session
 		 * \param cache        node cache
 		 * \param tx_buf_size  shared transmission buffer size
+		 * \param queue_depth  number of packets kept in flight
 		 * \param root_path    path root of the session
 		 * \param writable     whether the session can modify files
 		 */
@@ -335,6 +397,7 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		                  char          const *label,
 		                  size_t               ram_quota,
 		                  size_t               tx_buf_size,
+		                  unsigned             queue_depth,
 		                  Vfs::Dir_file_system &vfs,
 		                  char           const *root_path,
 		                  bool                  writable)
@@ -344,7 +407,9 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 			_alloc(_ram, env.rm()),
 			_process_packet_handler(env.ep(), *this, &Session_component::_process_packets),
 			_vfs(vfs),
-			_writable(writable)
+			_writable(writable),
+			_queue_depth(queue_depth),
+			_pending(_alloc_pending_packets())
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -366,6 +431,20 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 
 			while (_node_space.apply_any<Node>([&] (Node &node) {
 				_close(node); })) { }
+
+			_alloc.free(_pending, _queue_depth*sizeof(Pending_packet));
+		}
+
+		/**
+		 * Return RAM needed for keeping 'queue_depth' packets in flight
+		 */
+		static size_t queue_quota(unsigned queue_depth)
+		{
+			static_assert(sizeof(Pending_packet)
+			              <= File_system::Session::PENDING_PACKET_QUOTA,
+			              "pending-packet quota of session interface too small");
+
+			return File_system::Session::queue_quota(queue_depth);
 		}
 
 		void upgrade(char const *args)
@@ -387,7 +466,9 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 				tx_sink()->acknowledge_packet(packet);
 				file.notify_read_ready(false);
 			}
-			_process_packets();
+
+			_retry_blocked(Node_handle(file.id().value));
+			_process_submitted();
 		}
 
 		/***************************
@@ -486,6 +567,8 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 				if (!(node.id() == _root->id()))
 					_close(node);
 			});
+
+			_fail_blocked(handle);
 		}
 
 		Status status(Node_handle node_handle) override
@@ -662,13 +745,23 @@ class Vfs_server::Root :
 			if (!tx_buf_size)
 				throw Root::Invalid_args();
 
+			/* number of packets kept in flight for the session */
+			unsigned const queue_depth =
+				max(1U, min((unsigned)Arg_string::find_arg(args, "tx_queue_size")
+				                .ulong_value(File_system::Session::TX_QUEUE_SIZE),
+				            (unsigned)File_system::Session::MAX_TX_QUEUE_SIZE));
+
 			size_t session_size =
 				max((size_t)4096, sizeof(Session_component)) +
 				tx_buf_size;
 
-			if (session_size > ram_quota) {
+			/* the pending packets are allocated from the session quota */
+			size_t const quota_needed =
+				session_size + Session_component::queue_quota(queue_depth);
+
+			if (quota_needed > ram_quota) {
 				error("insufficient 'ram_quota' from '", label, "' "
-				      "got ", ram_quota, ", need ", session_size);
+				      "got ", ram_quota, ", need ", quota_needed);
 				throw Root::Quota_exceeded();
 			}
 			ram_quota -= session_size;
@@ -721,7 +814,7 @@ class Vfs_server::Root :
 
 			Session_component *session = new (md_alloc())
 				Registered_session(_session_registry, _env, label.string(),
-				                   ram_quota, tx_buf_size, _vfs,
+				                   ram_quota, tx_buf_size, queue_depth, _vfs,
 				                   session_root.base(), writeable);
 
 			Genode::log("session opened for '", label, "' at '", session_root, "'");
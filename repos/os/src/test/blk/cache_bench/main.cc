@@ -0,0 +1,168 @@
+/*
+ * \brief  Sequential and random read throughput of a block session
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+class Read_bench
+{
+	private:
+
+		enum {
+			REQUEST_SIZE = 4096,
+			TX_BUFFER    = Block::Session::TX_QUEUE_SIZE * REQUEST_SIZE
+		};
+
+		enum Pattern { SEQUENTIAL, RANDOM, DONE };
+
+		Env &                  _env;
+		Heap                   _heap    { _env.ram(), _env.rm() };
+		Allocator_avl          _alloc   { &_heap };
+		Block::Connection      _session { _env, &_alloc, TX_BUFFER };
+		Timer::Connection      _timer   { _env };
+		Attached_rom_dataspace _config  { _env, "config" };
+
+		Signal_handler<Read_bench> _disp_ack    { _env.ep(), *this,
+		                                          &Read_bench::_ack };
+		Signal_handler<Read_bench> _disp_submit { _env.ep(), *this,
+		                                          &Read_bench::_submit };
+
+		size_t const _test_size =
+			_config.xml().attribute_value("size", Number_of_bytes(16*1024*1024));
+
+		Pattern         _pattern   = SEQUENTIAL;
+		unsigned long   _start     = 0;
+		size_t          _submitted = 0;
+		size_t          _bytes     = 0;
+		Block::sector_t _current   = 0;
+		unsigned        _random    = 1;
+
+		size_t          _blk_size;
+		Block::sector_t _blk_count;
+
+		Block::sector_t _next_block(size_t count)
+		{
+			if (_pattern == SEQUENTIAL) {
+				if (_current + count > _blk_count)
+					_current = 0;
+				Block::sector_t const nr = _current;
+				_current += count;
+				return nr;
+			}
+
+			/* linear congruential generator */
+			_random = _random*1103515245 + 12345;
+			return ((_random >> 8) % (_blk_count / count)) * count;
+		}
+
+		static char const *_name(Pattern pattern) {
+			return pattern == SEQUENTIAL ? "sequential" : "random"; }
+
+		void _submit()
+		{
+			size_t const count = REQUEST_SIZE / _blk_size;
+
+			try {
+				while (_pattern != DONE && _submitted < _test_size
+				    && _session.tx()->ready_to_submit()) {
+
+					Block::Packet_descriptor p(
+						_session.tx()->alloc_packet(REQUEST_SIZE),
+						Block::Packet_descriptor::READ,
+						_next_block(count), count);
+
+					_session.tx()->submit_packet(p);
+					_submitted += REQUEST_SIZE;
+				}
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+		}
+
+		void _ack()
+		{
+			while (_session.tx()->ack_avail()) {
+
+				Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+				if (!p.succeeded())
+					error("packet error: block: ", p.block_number(), " "
+					      "count: ", p.block_count());
+
+				_bytes += p.size();
+				_session.tx()->release_packet(p);
+			}
+
+			if (_bytes >= _test_size)
+				_finish();
+
+			_submit();
+		}
+
+		void _begin(Pattern pattern)
+		{
+			_pattern   = pattern;
+			_start     = _timer.elapsed_ms();
+			_submitted = 0;
+			_bytes     = 0;
+			_current   = 0;
+		}
+
+		void _finish()
+		{
+			unsigned long const ms = max(_timer.elapsed_ms() - _start, 1UL);
+
+			log(_name(_pattern), ": read ", _bytes / 1024, " KiB in ", ms,
+			    " ms (", (_bytes / 1024) * 1000 / ms, " KiB/s)");
+
+			if (_pattern == SEQUENTIAL) {
+				_begin(RANDOM);
+				return;
+			}
+
+			_pattern = DONE;
+			log("--- block read benchmark finished ---");
+		}
+
+	public:
+
+		Read_bench(Env &env) : _env(env)
+		{
+			_session.tx_channel()->sigh_ack_avail(_disp_ack);
+			_session.tx_channel()->sigh_ready_to_submit(_disp_submit);
+
+			Block::Session::Operations blk_ops;
+			_session.info(&_blk_count, &_blk_size, &blk_ops);
+
+			log("--- block read benchmark ---");
+			log("block count ", _blk_count, " size ", _blk_size,
+			    ", reading ", _test_size / 1024, " KiB per pattern");
+
+			if (REQUEST_SIZE % _blk_size || _blk_count < REQUEST_SIZE / _blk_size) {
+				error("unsupported block device geometry");
+				_env.parent().exit(-1);
+				return;
+			}
+
+			_begin(SEQUENTIAL);
+			_submit();
+		}
+};
+
+
+void Component::construct(Env &env) { static Read_bench bench(env); }
@@ -0,0 +1,3 @@
+TARGET = test-blk-cache_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,205 @@
+/*
+ * \brief  Throughput of block sessions with different routes
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark sequentially opens one block session per '<session>' node of
+ * its config, e.g., to compare the direct access of a driver with the access
+ * via a partition server. For each session, the throughput of sequential
+ * reads and writes is measured.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+
+using namespace Genode;
+
+
+class Part_bench
+{
+	private:
+
+		enum {
+			REQUEST_SIZE = 16*1024,
+			TX_BUFFER    = 1024*1024
+		};
+
+		typedef String<64> Label;
+
+		Env &                  _env;
+		Heap                   _heap   { _env.ram(), _env.rm() };
+		Allocator_avl          _alloc  { &_heap };
+		Timer::Connection      _timer  { _env };
+		Attached_rom_dataspace _config { _env, "config" };
+
+		Constructible<Block::Connection> _session;
+
+		Signal_handler<Part_bench> _disp_ack    { _env.ep(), *this,
+		                                          &Part_bench::_ack };
+		Signal_handler<Part_bench> _disp_submit { _env.ep(), *this,
+		                                          &Part_bench::_submit };
+
+		size_t const _test_size =
+			_config.xml().attribute_value("size", Number_of_bytes(16*1024*1024));
+
+		unsigned        _session_index = 0;
+		Label           _label;
+		bool            _write     = false;
+		unsigned long   _start     = 0;
+		size_t          _submitted = 0;
+		size_t          _bytes     = 0;
+		unsigned long   _read_rate = 0;  /* KiB/s */
+		Block::sector_t _current   = 0;
+
+		size_t          _blk_size  = 0;
+		Block::sector_t _blk_count = 0;
+
+		void _submit()
+		{
+			if (!_session.constructed())
+				return;
+
+			size_t const count = REQUEST_SIZE / _blk_size;
+
+			Block::Packet_descriptor::Opcode const op = _write
+				? Block::Packet_descriptor::WRITE
+				: Block::Packet_descriptor::READ;
+
+			try {
+				while (_submitted < _test_size && _session->tx()->ready_to_submit()) {
+
+					if (_current + count > _blk_count)
+						_current = 0;
+
+					Block::Packet_descriptor p(
+						_session->tx()->alloc_packet(REQUEST_SIZE), op,
+						_current, count);
+
+					_session->tx()->submit_packet(p);
+					_submitted += REQUEST_SIZE;
+					_current   += count;
+				}
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+		}
+
+		void _ack()
+		{
+			if (!_session.constructed())
+				return;
+
+			while (_session->tx()->ack_avail()) {
+
+				Block::Packet_descriptor p = _session->tx()->get_acked_packet();
+				if (!p.succeeded())
+					error(_label, ": packet error: block: ", p.block_number(),
+					      " count: ", p.block_count());
+
+				_bytes += p.size();
+				_session->tx()->release_packet(p);
+			}
+
+			if (_bytes >= _test_size) {
+				_finish();
+				return;
+			}
+
+			_submit();
+		}
+
+		void _begin(bool write)
+		{
+			_write     = write;
+			_start     = _timer.elapsed_ms();
+			_submitted = 0;
+			_bytes     = 0;
+			_current   = 0;
+			_submit();
+		}
+
+		void _finish()
+		{
+			unsigned long const ms   = max(_timer.elapsed_ms() - _start, 1UL);
+			unsigned long const rate = (_bytes / 1024) * 1000 / ms;
+
+			if (!_write && _writable()) {
+				_read_rate = rate;
+				_begin(true);
+				return;
+			}
+
+			if (_write)
+				log(_label, ": read ", _read_rate, " KiB/s, write ", rate, " KiB/s");
+			else
+				log(_label, ": read ", rate, " KiB/s");
+
+			_session.destruct();
+			_session_index++;
+			_open_next_session();
+		}
+
+		bool _writable()
+		{
+			Block::sector_t           cnt;
+			size_t                    size;
+			Block::Session::Operations ops;
+			_session->info(&cnt, &size, &ops);
+			return ops.supported(Block::Packet_descriptor::WRITE);
+		}
+
+		void _open_next_session()
+		{
+			Xml_node session_node("<session/>");
+			try {
+				session_node = _config.xml().sub_node("session");
+				for (unsigned i = 0; i < _session_index; i++)
+					session_node = session_node.next("session");
+			} catch (Xml_node::Nonexistent_sub_node) {
+				log("--- block session benchmark finished ---");
+				return;
+			}
+
+			_label = session_node.attribute_value("label", Label());
+
+			_session.construct(_env, &_alloc, TX_BUFFER, _label.string());
+			_session->tx_channel()->sigh_ack_avail(_disp_ack);
+			_session->tx_channel()->sigh_ready_to_submit(_disp_submit);
+
+			Block::Session::Operations ops;
+			_session->info(&_blk_count, &_blk_size, &ops);
+
+			if (REQUEST_SIZE % _blk_size || _blk_count < REQUEST_SIZE / _blk_size) {
+				error(_label, ": unsupported block device geometry");
+				_env.parent().exit(-1);
+				return;
+			}
+
+			_begin(false);
+		}
+
+	public:
+
+		Part_bench(Env &env) : _env(env)
+		{
+			log("--- block session benchmark ---");
+			log("transferring ", _test_size / 1024, " KiB per session and "
+			    "direction in requests of ", (unsigned)REQUEST_SIZE / 1024, " KiB");
+
+			_open_next_session();
+		}
+};
+
+
+void Component::construct(Env &env) { static Part_bench bench(env); }
@@ -0,0 +1,165 @@
+/*
+ * \brief  Test and benchmark of the Internet checksum computation
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The result of 'Net::internet_checksum' is validated against a plain
+ * 16-bit reference loop for various sizes and alignments. Afterwards, the
+ * throughput of both is measured for typical packet sizes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <net/internet_checksum.h>
+
+using namespace Genode;
+
+
+/**
+ * Reference implementation summing up one big-endian 16-bit word at a time
+ */
+static uint16_t reference_checksum(uint8_t const *data, size_t size,
+                                   uint32_t seed)
+{
+	uint64_t sum = seed;
+	for (size_t i = 0; i + 1 < size; i += 2) {
+		sum += (uint32_t)(data[i] << 8 | data[i + 1]); }
+
+	if (size & 1) {
+		sum += (uint32_t)(data[size - 1] << 8); }
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16); }
+
+	return (uint16_t)~sum;
+}
+
+
+/**
+ * Simple xorshift pseudo-random number generator
+ */
+struct Random
+{
+	uint32_t state = 0x2545f491;
+
+	uint32_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+
+/**
+ * Print throughput given in bytes per millisecond as GB/s
+ */
+struct Throughput
+{
+	unsigned long bytes_per_ms;
+
+	void print(Output &output) const
+	{
+		unsigned long const centi = bytes_per_ms / 10000;
+		Genode::print(output, centi / 100, ".", (centi % 100) / 10,
+		              centi % 10, " GB/s");
+	}
+};
+
+
+struct Main
+{
+	enum {
+		BUF_SIZE    = 1024 * 1024,
+		DURATION_MS = 1000,
+	};
+
+	Env                    &env;
+	Timer::Connection       timer { env };
+	Attached_ram_dataspace  buf   { env.ram(), env.rm(), BUF_SIZE };
+
+	uint8_t *_data() { return buf.local_addr<uint8_t>(); }
+
+	template <typename FUNC>
+	Throughput _measure(size_t size, FUNC const &func)
+	{
+		unsigned long       bytes    = 0;
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long       now_ms   = start_ms;
+		uint16_t volatile   result   = 0;
+
+		for (; now_ms - start_ms < DURATION_MS; now_ms = timer.elapsed_ms()) {
+			for (size_t offset = 0; offset + size <= BUF_SIZE; offset += size) {
+				result = result + func(_data() + offset, size);
+				bytes += size;
+			}
+		}
+		return Throughput { bytes / (now_ms - start_ms) };
+	}
+
+	void _validate()
+	{
+		Random random;
+		for (unsigned i = 0; i < 100000; i++) {
+
+			size_t   const offset = random.next() % 64;
+			size_t   const size   = random.next() % ((i % 1000) ? 2048 : BUF_SIZE - 64);
+			uint32_t const seed   = random.next() % 0x80000;
+
+			uint16_t const expected = reference_checksum(_data() + offset, size, seed);
+			uint16_t const result   = Net::internet_checksum(_data() + offset, size, seed);
+			if (result == expected) {
+				continue; }
+
+			error("checksum of ", size, " bytes at offset ", offset, " is ",
+			      Hex(result), " instead of ", Hex(expected));
+			throw -1;
+		}
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- Internet-checksum test ---");
+
+		Random random;
+		for (size_t i = 0; i < BUF_SIZE; i++) {
+			_data()[i] = random.next(); }
+
+		try { _validate(); }
+		catch (...) {
+			env.parent().exit(-1);
+			return;
+		}
+
+		static size_t const sizes[] = { 20, 64, 576, 1500, 9000, 65536 };
+		for (size_t size : sizes) {
+
+			Throughput const reference = _measure(size,
+				[&] (uint8_t const *data, size_t len) {
+					return reference_checksum(data, len, 0); });
+
+			Throughput const optimized = _measure(size,
+				[&] (uint8_t const *data, size_t len) {
+					return Net::internet_checksum(data, len); });
+
+			log("size: ", size, " reference: ", reference,
+			    " internet_checksum: ", optimized);
+		}
+		log("--- Internet-checksum test finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,173 @@
+/*
+ * \brief  Benchmark of the longest-prefix match of NIC-router rules
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+/* NIC-router includes */
+#include <direct_rule.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+struct Test_rule;
+
+struct Test_rule_list : Direct_rule_list<Test_rule> { };
+
+struct Test_rule : Test_rule_list::Element
+{
+	Ipv4_address_prefix const _dst;
+
+	Test_rule(Ipv4_address_prefix const &dst) : _dst(dst) { }
+
+	Ipv4_address_prefix const &dst() const { return _dst; }
+};
+
+
+/**
+ * Simple xorshift pseudo-random number generator
+ */
+struct Random
+{
+	uint32_t state = 0x2545f491;
+
+	uint32_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+
+static Ipv4_address ip_from_uint32(uint32_t value)
+{
+	Ipv4_address ip;
+	ip.addr[0] = value >> 24;
+	ip.addr[1] = value >> 16;
+	ip.addr[2] = value >>  8;
+	ip.addr[3] = value;
+	return ip;
+}
+
+
+struct Test
+{
+	enum { DURATION_MS = 1000, NR_OF_ADDRS = 1024 };
+
+	Timer::Connection &timer;
+	Allocator         &alloc;
+	Test_rule_list     rules;
+	Ipv4_address       addrs[NR_OF_ADDRS];
+
+	/**
+	 * Count lookups performed within 'DURATION_MS'
+	 */
+	unsigned long _measure()
+	{
+		unsigned long        lookups  = 0;
+		unsigned long const  start_ms = timer.elapsed_ms();
+		while (timer.elapsed_ms() - start_ms < DURATION_MS) {
+			for (unsigned i = 0; i < NR_OF_ADDRS; i++, lookups++) {
+				try { rules.longest_prefix_match(addrs[i]); }
+				catch (Test_rule_list::No_match) { }
+			}
+		}
+		return lookups;
+	}
+
+	Test_rule const *_lookup(Ipv4_address const &ip)
+	{
+		try { return &rules.longest_prefix_match(ip); }
+		catch (Test_rule_list::No_match) { return nullptr; }
+	}
+
+	Test(Timer::Connection &timer, Allocator &alloc, unsigned nr_of_rules)
+	:
+		timer(timer), alloc(alloc)
+	{
+		Random random;
+
+		/* prefixes of mixed lengths, most of them from a common /8 */
+		for (unsigned i = 0; i < nr_of_rules; i++) {
+			uint32_t const value = (10U << 24) | (random.next() & 0xffffff);
+			Ipv4_address_prefix prefix;
+			prefix.address = ip_from_uint32(value);
+			prefix.prefix  = 8 + random.next() % 25;
+			rules.insert(*new (alloc) Test_rule(prefix));
+		}
+		for (unsigned i = 0; i < NR_OF_ADDRS; i++) {
+			addrs[i] = ip_from_uint32((10U << 24) | (random.next() & 0xffffff)); }
+
+		/* remember list results for validating the trie */
+		static Test_rule const *expected[NR_OF_ADDRS];
+		for (unsigned i = 0; i < NR_OF_ADDRS; i++) {
+			expected[i] = _lookup(addrs[i]); }
+
+		unsigned long const list_lookups = _measure();
+
+		rules.compile(alloc);
+
+		unsigned long const trie_lookups = _measure();
+
+		for (unsigned i = 0; i < NR_OF_ADDRS; i++) {
+			if (_lookup(addrs[i]) == expected[i]) {
+				continue; }
+
+			error("trie lookup of ", addrs[i], " differs from list lookup");
+			throw -1;
+		}
+		log("rules: ", nr_of_rules, " list: ", list_lookups / DURATION_MS,
+		    " lookups/ms trie: ", trie_lookups / DURATION_MS, " lookups/ms");
+	}
+
+	~Test()
+	{
+		while (Test_rule *rule = rules.first()) {
+			rules.remove(rule);
+			destroy(alloc, rule);
+		}
+	}
+};
+
+
+struct Main
+{
+	Env               &env;
+	Heap               heap  { env.ram(), env.rm() };
+	Timer::Connection  timer { env };
+
+	Main(Env &env) : env(env)
+	{
+		log("--- NIC-router rule-lookup benchmark ---");
+		try {
+			static unsigned const nr_of_rules[] = { 10, 100, 10000 };
+			for (unsigned n : nr_of_rules) {
+				Test test(timer, heap, n); }
+		}
+		catch (...) {
+			env.parent().exit(-1);
+			return;
+		}
+		log("--- NIC-router rule-lookup benchmark finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
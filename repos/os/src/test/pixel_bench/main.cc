@@ -0,0 +1,225 @@
+/*
+ * \brief  Pixel-processing benchmark
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark measures the throughput of the texture painter and the
+ * pixel-row operations of the blit library for a screen-sized area. Before
+ * each measurement, the result is validated against the scalar operations
+ * of the pixel type.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <blit/blit.h>
+#include <nitpicker_gfx/texture_painter.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+/**
+ * Simple xorshift pseudo-random number generator
+ */
+struct Random
+{
+	uint32_t state = 0x2545f491;
+
+	uint32_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+
+struct Test
+{
+	struct Mismatch : Exception { };
+
+	enum { DURATION_MS = 2000, W = 1920, H = 1080, NUM = W*H };
+
+	Env                    &env;
+	int                     id;
+	Timer::Connection       timer     { env };
+	Attached_ram_dataspace  src_ds    { env.ram(), env.rm(), NUM*4 };
+	Attached_ram_dataspace  dst_ds    { env.ram(), env.rm(), NUM*4 };
+	Attached_ram_dataspace  ref_ds    { env.ram(), env.rm(), NUM*4 };
+	Attached_ram_dataspace  alpha_ds  { env.ram(), env.rm(), NUM };
+
+	template <typename T> T *src()   { return src_ds.local_addr<T>(); }
+	template <typename T> T *dst()   { return dst_ds.local_addr<T>(); }
+	template <typename T> T *ref()   { return ref_ds.local_addr<T>(); }
+	unsigned char           *alpha() { return alpha_ds.local_addr<unsigned char>(); }
+
+	Test(Env &env, int id, char const *brief) : env(env), id(id)
+	{
+		log("\nTEST ", id, ": ", brief, "\n");
+
+		/* random pixels, many of them zero, and alpha values of all kinds */
+		Random random;
+		for (unsigned i = 0; i < NUM; i++) {
+			uint32_t const value = random.next();
+			src<uint32_t>()[i] = (value & 3) ? random.next() : 0;
+			dst<uint32_t>()[i] = ref<uint32_t>()[i] = random.next();
+			alpha()[i] = (value & 12) == 0 ? 0 : (value & 12) == 4 ? 255 : value >> 24;
+		}
+	}
+
+	void validate(size_t bytes)
+	{
+		if (memcmp(dst<void>(), ref<void>(), bytes) == 0)
+			return;
+
+		error("result differs from scalar pixel operations");
+		throw Mismatch();
+	}
+
+	template <typename FUNC>
+	void measure(FUNC const &func)
+	{
+		unsigned long       pixels   = 0;
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long       end_ms   = start_ms;
+		for (; end_ms - start_ms < DURATION_MS; end_ms = timer.elapsed_ms()) {
+			func();
+			pixels += NUM;
+		}
+		log("throughput: ", pixels / 1000 / (end_ms - start_ms), " Mpixel/sec");
+	}
+
+	~Test() { log("\nTEST ", id, " finished\n"); }
+};
+
+
+template <typename PT>
+struct Blend_test : Test
+{
+	Blend_test(Env &env, int id, char const *brief) : Test(env, id, brief)
+	{
+		Surface_base::Area const size(W, H);
+		Texture<PT> const texture(src<PT>(), alpha(), size);
+		Surface<PT>       surface(dst<PT>(), size);
+
+		Texture_painter::paint(surface, texture, Color(0, 0, 0),
+		                       Texture_painter::Point(0, 0),
+		                       Texture_painter::SOLID, true);
+
+		for (unsigned i = 0; i < NUM; i++)
+			if (alpha()[i])
+				ref<PT>()[i] = PT::mix(ref<PT>()[i], src<PT>()[i], alpha()[i]);
+
+		validate(NUM*sizeof(PT));
+
+		measure([&] () {
+			Texture_painter::paint(surface, texture, Color(0, 0, 0),
+			                       Texture_painter::Point(0, 0),
+			                       Texture_painter::SOLID, true); });
+	}
+};
+
+
+template <typename PT>
+struct Masked_test : Test
+{
+	Masked_test(Env &env, int id, char const *brief) : Test(env, id, brief)
+	{
+		Surface_base::Area const size(W, H);
+		Texture<PT> const texture(src<PT>(), nullptr, size);
+		Surface<PT>       surface(dst<PT>(), size);
+
+		Texture_painter::paint(surface, texture, Color(0, 0, 0),
+		                       Texture_painter::Point(0, 0),
+		                       Texture_painter::MASKED, false);
+
+		for (unsigned i = 0; i < NUM; i++)
+			if (src<PT>()[i].pixel)
+				ref<PT>()[i] = src<PT>()[i];
+
+		validate(NUM*sizeof(PT));
+
+		measure([&] () {
+			Texture_painter::paint(surface, texture, Color(0, 0, 0),
+			                       Texture_painter::Point(0, 0),
+			                       Texture_painter::MASKED, false); });
+	}
+};
+
+
+template <typename SRC_PT, typename DST_PT>
+struct Convert_test : Test
+{
+	static void convert(SRC_PT const *src, DST_PT *dst);
+
+	Convert_test(Env &env, int id, char const *brief) : Test(env, id, brief)
+	{
+		convert(src<SRC_PT>(), dst<DST_PT>());
+
+		for (unsigned i = 0; i < NUM; i++) {
+			SRC_PT const s = src<SRC_PT>()[i];
+			ref<DST_PT>()[i] = DST_PT(s.r(), s.g(), s.b());
+		}
+
+		validate(NUM*sizeof(DST_PT));
+
+		measure([&] () { convert(src<SRC_PT>(), dst<DST_PT>()); });
+	}
+};
+
+
+template <>
+void Convert_test<Pixel_rgb565, Pixel_rgb888>::convert(Pixel_rgb565 const *src,
+                                                       Pixel_rgb888 *dst) {
+	convert_rgb565_to_rgb888(src, dst, NUM); }
+
+
+template <>
+void Convert_test<Pixel_rgb888, Pixel_rgb565>::convert(Pixel_rgb888 const *src,
+                                                       Pixel_rgb565 *dst) {
+	convert_rgb888_to_rgb565(src, dst, NUM); }
+
+
+struct Main
+{
+	Constructible<Blend_test<Pixel_rgb565> >                 test_1;
+	Constructible<Blend_test<Pixel_rgb888> >                 test_2;
+	Constructible<Masked_test<Pixel_rgb565> >                test_3;
+	Constructible<Masked_test<Pixel_rgb888> >                test_4;
+	Constructible<Convert_test<Pixel_rgb565, Pixel_rgb888> > test_5;
+	Constructible<Convert_test<Pixel_rgb888, Pixel_rgb565> > test_6;
+
+	Main(Env &env)
+	{
+		log("--- Pixel benchmark ---");
+		try {
+			test_1.construct(env, 1, "alpha blending of RGB565 texture"); test_1.destruct();
+			test_2.construct(env, 2, "alpha blending of RGB888 texture"); test_2.destruct();
+			test_3.construct(env, 3, "masked copy of RGB565 texture");    test_3.destruct();
+			test_4.construct(env, 4, "masked copy of RGB888 texture");    test_4.destruct();
+			test_5.construct(env, 5, "conversion from RGB565 to RGB888"); test_5.destruct();
+			test_6.construct(env, 6, "conversion from RGB888 to RGB565"); test_6.destruct();
+		}
+		catch (Test::Mismatch) {
+			env.parent().exit(-1);
+			return;
+		}
+		log("--- Pixel benchmark finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
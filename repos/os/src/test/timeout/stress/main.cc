@@ -0,0 +1,183 @@
+/*
+ * \brief  Stress test for the alarm scheduler
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test schedules 100k alarms on a virtual time line, discards and
+ * re-schedules a part of them, and advances the time in random steps.
+ * Each alarm must trigger exactly once, not before its deadline, and in
+ * the first 'handle' call after its deadline. The costs of the scheduler
+ * operations are measured with the timer session.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <util/construct_at.h>
+#include <os/alarm.h>
+
+using namespace Genode;
+
+
+/**
+ * Simple xorshift pseudo-random number generator
+ */
+struct Random
+{
+	uint32_t state = 0x2545f491;
+
+	uint32_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+
+struct Test_alarm : Alarm
+{
+	Alarm::Time const &now;
+	Alarm::Time        deadline  = 0;
+	bool               scheduled = false;
+	unsigned           triggered = 0;
+	unsigned           errors    = 0;
+
+	Test_alarm(Alarm::Time const &now) : now(now) { }
+
+	bool on_alarm(unsigned) override
+	{
+		if (!scheduled || (int)(deadline - now) >= 0)
+			errors++;
+
+		scheduled = false;
+		triggered++;
+		return false;
+	}
+
+	bool overdue() const { return scheduled && (int)(deadline - now) < 0; }
+};
+
+
+struct Main
+{
+	enum {
+		NR_OF_ALARMS = 100000,
+		MAX_TIMEOUT  = 10000000,
+		MAX_STEP     = 5000,
+	};
+
+	Env               &env;
+	Heap               heap  { env.ram(), env.rm() };
+	Timer::Connection  timer { env };
+	Random             random;
+	Alarm_scheduler    scheduler;
+
+	/* start close to the wrap-around of 32-bit time values */
+	Alarm::Time now = 0xfff00000;
+
+	Test_alarm *alarms = nullptr;
+
+	void _schedule(Test_alarm &alarm, unsigned max_timeout)
+	{
+		alarm.deadline  = now + random.next() % max_timeout;
+		alarm.scheduled = true;
+		scheduler.schedule_absolute(&alarm, alarm.deadline);
+	}
+
+	unsigned long _measure_ms(unsigned long &start_ms)
+	{
+		unsigned long const end_ms = timer.elapsed_ms();
+		unsigned long const result = end_ms - start_ms;
+		start_ms = end_ms;
+		return result;
+	}
+
+	unsigned _check()
+	{
+		unsigned errors = 0;
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			errors += alarms[i].errors + alarms[i].overdue();
+		return errors;
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- timeout stress test ---");
+
+		scheduler.handle(now);
+
+		heap.alloc(sizeof(Test_alarm) * NR_OF_ALARMS, (void **)&alarms);
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			construct_at<Test_alarm>(&alarms[i], now);
+
+		unsigned long start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			_schedule(alarms[i], MAX_TIMEOUT);
+
+		log("scheduled ", (unsigned)NR_OF_ALARMS, " alarms in ",
+		    _measure_ms(start_ms), " ms");
+
+		for (unsigned i = 0; i < NR_OF_ALARMS; i += 2) {
+			scheduler.discard(&alarms[i]);
+			alarms[i].scheduled = false;
+		}
+		log("discarded ", (unsigned)NR_OF_ALARMS / 2, " alarms in ",
+		    _measure_ms(start_ms), " ms");
+
+		for (unsigned i = 1; i < NR_OF_ALARMS; i += 4)
+			_schedule(alarms[i], MAX_TIMEOUT / 10);
+
+		log("re-scheduled ", (unsigned)NR_OF_ALARMS / 4, " alarms in ",
+		    _measure_ms(start_ms), " ms");
+
+		unsigned errors   = 0;
+		unsigned handles  = 0;
+		for (Alarm::Time end = now + MAX_TIMEOUT + MAX_STEP; (int)(end - now) > 0; ) {
+
+			Alarm::Time deadline;
+			if (scheduler.next_deadline(&deadline) && (int)(deadline - now) < 0)
+				errors++;
+
+			now += 1 + random.next() % MAX_STEP;
+			scheduler.handle(now);
+			handles++;
+
+			/* re-use alarms that already triggered */
+			Test_alarm &alarm = alarms[random.next() % NR_OF_ALARMS];
+			if (!alarm.scheduled && (int)(end - now) > MAX_TIMEOUT / 10)
+				_schedule(alarm, MAX_TIMEOUT / 10);
+		}
+		log("handled alarms in ", handles, " steps in ",
+		    _measure_ms(start_ms), " ms");
+
+		errors += _check();
+
+		unsigned triggered = 0;
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			triggered += alarms[i].triggered;
+
+		log("triggered ", triggered, " alarms, ", errors, " errors");
+
+		if (errors) {
+			env.parent().exit(-1);
+			return;
+		}
+		log("--- timeout stress test finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -131,6 +131,38 @@ struct Stress_test
 };
 
 
+struct Clock_test
+{
+	enum { DURATION_MS = 1000, MAX_DEVIATION_MS = 10 };
+
+	Timer::Connection timer;
+
+	bool failed = false;
+
+	Clock_test(Env &env) : timer(env)
+	{
+		/*
+		 * Compare the locally determined time against the time reported
+		 * via RPC while counting the local queries
+		 */
+		unsigned long       queries  = 0;
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long       local_ms = start_ms;
+		for (; local_ms - start_ms < DURATION_MS; queries++)
+			local_ms = timer.elapsed_ms();
+
+		unsigned long const rpc_ms    = timer.Timer::Session_client::elapsed_ms();
+		long          const deviation = rpc_ms - local_ms;
+		if (deviation > MAX_DEVIATION_MS || deviation < -MAX_DEVIATION_MS) {
+			error("local time ", local_ms, " ms, driver time ", rpc_ms, " ms");
+			failed = true;
+			return;
+		}
+		log("clock queries: ", queries / DURATION_MS, " per ms");
+	}
+};
+
+
 struct Main
 {
 	Env                       &env;
@@ -147,6 +179,13 @@ struct Main
 
 	void handle_test_2_done()
 	{
+		test_2.destruct();
+		Clock_test test_3(env);
+		if (test_3.failed) {
+			env.parent().exit(-1);
+			return;
+		}
+
 		log("--- timer test finished ---");
 		env.parent().exit(0);
 	}
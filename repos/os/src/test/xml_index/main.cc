@@ -0,0 +1,179 @@
+/*
+ * \brief  Benchmark of the navigation within large XML documents
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The benchmark generates a document with 10k nodes that resembles a large
+ * init configuration and compares the costs of navigating it via 'Xml_node'
+ * with the costs of navigating it via 'Xml_index'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	struct Mismatch : Exception { };
+
+	enum {
+		NUM_STARTS   = 2500,   /* each start node comes with 3 sub nodes */
+		NUM_PLAIN    = 20,     /* random accesses via 'Xml_node'         */
+		ROUNDS       = 100,
+		BUFFER_SIZE  = 1024*1024,
+	};
+
+	Env                    &env;
+	Heap                    heap   { env.ram(), env.rm() };
+	Timer::Connection       timer  { env };
+	Attached_ram_dataspace  buffer { env.ram(), env.rm(), BUFFER_SIZE };
+
+	void generate()
+	{
+		Xml_generator xml(buffer.local_addr<char>(), BUFFER_SIZE, "config", [&] ()
+		{
+			for (unsigned i = 0; i < NUM_STARTS; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name",    i);
+					xml.attribute("caps",    100);
+					xml.attribute("version", i*7);
+					xml.node("resource", [&] () {
+						xml.attribute("name",    "RAM");
+						xml.attribute("quantum", i);
+					});
+					xml.node("route", [&] () {
+						xml.node("service", [&] () {
+							xml.attribute("name", "LOG"); });
+					});
+				});
+			}
+		});
+	}
+
+	template <typename FN>
+	unsigned long measure(char const *what, unsigned ops, FN const &fn)
+	{
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long const result   = fn();
+		unsigned long const ms       = timer.elapsed_ms() - start_ms;
+
+		log(what, ": ", ms, " ms for ", ops, " operations (",
+		    ops ? ms*1000/ops : 0, " us/op)");
+		return result;
+	}
+
+	static void check(unsigned long plain, unsigned long indexed)
+	{
+		if (plain == indexed)
+			return;
+
+		error("results differ: ", plain, " vs. ", indexed);
+		throw Mismatch();
+	}
+
+	/**
+	 * Return index of the start node accessed in round 'i'
+	 */
+	static unsigned start_idx(unsigned i) { return (i*7919) % NUM_STARTS; }
+
+	void run()
+	{
+		generate();
+		Xml_node const config(buffer.local_addr<char>());
+
+		Constructible<Xml_index> index;
+		measure("construct index", 1, [&] () {
+			index.construct(heap, config); return 0UL; });
+
+		log("indexed ", index->num_nodes(), " nodes using ",
+		    heap.consumed(), " bytes");
+
+		Xml_index::Node const root = index->root();
+
+		/* iterate over all nodes and read an attribute of each start node */
+		auto iterate_plain = [&] () {
+			unsigned long sum = 0;
+			config.for_each_sub_node("start", [&] (Xml_node const &start) {
+				sum += start.attribute_value("version", 0UL);
+				start.for_each_sub_node([&] (Xml_node const &node) {
+					sum += node.num_sub_nodes(); });
+			});
+			return sum;
+		};
+		auto iterate_indexed = [&] () {
+			unsigned long sum = 0;
+			root.for_each_sub_node("start", [&] (Xml_index::Node const &start) {
+				sum += start.attribute_value("version", 0UL);
+				start.for_each_sub_node([&] (Xml_index::Node const &node) {
+					sum += node.num_sub_nodes(); });
+			});
+			return sum;
+		};
+		check(measure("iterate via Xml_node",  NUM_STARTS, iterate_plain),
+		      measure("iterate via Xml_index", NUM_STARTS, iterate_indexed));
+
+		/* access sub nodes by index and type, look up attribute by name */
+		auto access_plain = [&] (unsigned num) {
+			unsigned long sum = 0;
+			for (unsigned i = 0; i < num; i++)
+				sum += config.sub_node(start_idx(i)).sub_node("resource")
+				                                    .attribute_value("quantum", 0UL);
+			return sum;
+		};
+		auto access_indexed = [&] (unsigned num) {
+			unsigned long sum = 0;
+			for (unsigned i = 0; i < num; i++)
+				sum += root.sub_node(start_idx(i)).sub_node("resource")
+				                                  .attribute_value("quantum", 0UL);
+			return sum;
+		};
+		check(measure("random access via Xml_node", NUM_PLAIN, [&] () {
+		          return access_plain(NUM_PLAIN); }),
+		      measure("random access via Xml_index", NUM_PLAIN, [&] () {
+		          return access_indexed(NUM_PLAIN); }));
+
+		measure("random access via Xml_index", NUM_STARTS*ROUNDS, [&] () {
+			unsigned long sum = 0;
+			for (unsigned i = 0; i < ROUNDS; i++)
+				sum += access_indexed(NUM_STARTS);
+			return sum;
+		});
+
+		/* the index must yield the same nodes as 'Xml_node' */
+		config.for_each_sub_node([&] (Xml_node const &start) {
+			Xml_node const node = index->node(start).xml();
+			check((unsigned long)start.addr(), (unsigned long)node.addr());
+			check(start.size(), node.size());
+		});
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- XML-index benchmark ---");
+		try { run(); }
+		catch (Mismatch) {
+			env.parent().exit(-1);
+			return;
+		}
+		log("--- XML-index benchmark finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }